@@ -9,13 +9,48 @@ CONFIG += c++17
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    allocationTracker.cpp \
+    batchKernels.cpp \
+    batchPipeline.cpp \
+    batchSolver.cpp \
+    csvImportWorker.cpp \
+    feasibility.cpp \
     keyPressEvent.cpp \
     main.cpp \
-    triangleSolver.cpp
+    reconcile.cpp \
+    sensitivity.cpp \
+    shapeCache.cpp \
+    solveArena.cpp \
+    solveHistoryModel.cpp \
+    triangleCanvas.cpp \
+    triangleCore.cpp \
+    triangleSolver.cpp \
+    vertexInput.cpp
 
 HEADERS += \
+    allocationTracker.h \
+    angleTables.h \
+    batchKernels.h \
+    batchPipeline.h \
+    batchSolver.h \
+    csvImportWorker.h \
+    dualNumber.h \
+    feasibility.h \
     keyPressEvent.h \
-    triangleSolver.h
+    reconcile.h \
+    ringBuffer.h \
+    sensitivity.h \
+    shapeCache.h \
+    solveArena.h \
+    solveHistoryModel.h \
+    triangleCanvas.h \
+    triangleCore.h \
+    triangleCoreT.h \
+    triangleSolver.h \
+    vertexInput.h
+
+# Debug builds abort if the batch solve loop touches the heap (see allocationTracker.h)
+CONFIG(debug, debug|release): DEFINES += TRIANGLE_TRACK_ALLOCATIONS
 
 FORMS += \
     mainwindow.ui
@@ -0,0 +1,49 @@
+#include "allocationTracker.h"
+
+#ifdef TRIANGLE_TRACK_ALLOCATIONS
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+thread_local std::size_t allocationCount = 0;
+
+void* countedAllocate(std::size_t size)
+{
+    allocationCount++;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+}
+
+void* operator new(std::size_t size) { return countedAllocate(size); }
+void* operator new[](std::size_t size) { return countedAllocate(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+std::size_t threadAllocationCount()
+{
+    return allocationCount;
+}
+
+NoAllocationScope::NoAllocationScope(const char* where)
+    : where(where)
+    , startCount(allocationCount)
+{
+}
+
+NoAllocationScope::~NoAllocationScope()
+{
+    if (allocationCount != startCount) {
+        std::fprintf(stderr, "%s: %zu heap allocation(s) inside the solve loop\n",
+                     where, allocationCount - startCount);
+        std::abort();
+    }
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef ALLOCATIONTRACKER_H
+#define ALLOCATIONTRACKER_H
+
+#include <cstddef>
+
+// Test hook for the zero-allocation solve path. When the build defines
+// TRIANGLE_TRACK_ALLOCATIONS, global operator new counts calls per thread and
+// NoAllocationScope aborts if anything was allocated while it was alive.
+// Without the define both are free no-ops.
+
+#ifdef TRIANGLE_TRACK_ALLOCATIONS
+
+std::size_t threadAllocationCount();
+
+class NoAllocationScope
+{
+public:
+    explicit NoAllocationScope(const char* where);
+    ~NoAllocationScope();
+
+private:
+    const char* where;
+    std::size_t startCount;
+};
+
+#else
+
+inline std::size_t threadAllocationCount() { return 0; }
+
+class NoAllocationScope
+{
+public:
+    explicit NoAllocationScope(const char*) {}
+};
+
+#endif
+
+#endif // ALLOCATIONTRACKER_H
@@ -0,0 +1,172 @@
+#ifndef ANGLETABLES_H
+#define ANGLETABLES_H
+
+#include <array>
+#include <cmath>
+#include <limits>
+
+// Compile-time sin/cos/tan for angles on a 1/20 degree grid over [0, 180].
+// That covers whole degrees, tenths and the half angles the bisector
+// branches use. Each entry is evaluated in double-double arithmetic and then
+// rounded once, so it is the correctly rounded value of the exact decimal
+// angle (sin(30) is exactly 0.5, cos(90) exactly 0) and does not depend on
+// the platform libm.
+
+const int AngleGridSteps = 20; // grid points per degree
+const int AngleGridSize = 180 * AngleGridSteps + 1;
+
+namespace angleTableDetail {
+
+struct DD {
+    double hi;
+    double lo;
+};
+
+constexpr DD twoSum(double a, double b) {
+    double s = a + b;
+    double bb = s - a;
+    double err = (a - (s - bb)) + (b - bb);
+    return {s, err};
+}
+
+constexpr DD quickTwoSum(double a, double b) {
+    double s = a + b;
+    return {s, b - (s - a)};
+}
+
+// Dekker split/product; no fma so the tables can be built by the compiler.
+constexpr DD split(double a) {
+    double t = 134217729.0 * a; // 2^27 + 1
+    double hi = t - (t - a);
+    return {hi, a - hi};
+}
+
+constexpr DD twoProd(double a, double b) {
+    double p = a * b;
+    DD as = split(a);
+    DD bs = split(b);
+    double err = ((as.hi * bs.hi - p) + as.hi * bs.lo + as.lo * bs.hi) + as.lo * bs.lo;
+    return {p, err};
+}
+
+constexpr DD add(DD a, DD b) {
+    DD s = twoSum(a.hi, b.hi);
+    DD t = twoSum(a.lo, b.lo);
+    s.lo += t.hi;
+    s = quickTwoSum(s.hi, s.lo);
+    s.lo += t.lo;
+    return quickTwoSum(s.hi, s.lo);
+}
+
+constexpr DD neg(DD a) {
+    return {-a.hi, -a.lo};
+}
+
+constexpr DD mul(DD a, DD b) {
+    DD p = twoProd(a.hi, b.hi);
+    p.lo += a.hi * b.lo + a.lo * b.hi;
+    return quickTwoSum(p.hi, p.lo);
+}
+
+constexpr DD div(DD a, DD b) {
+    double q1 = a.hi / b.hi;
+    DD r = add(a, neg(mul(b, {q1, 0})));
+    double q2 = r.hi / b.hi;
+    r = add(r, neg(mul(b, {q2, 0})));
+    double q3 = r.hi / b.hi;
+    return add(quickTwoSum(q1, q2), {q3, 0});
+}
+
+// pi / (180 * AngleGridSteps) in double-double.
+constexpr DD radiansPerStep() {
+    return div({3.141592653589793116, 1.2246467991473532072e-16}, {180.0 * AngleGridSteps, 0});
+}
+
+// Taylor series; only called with |x| <= pi/4.
+constexpr DD sinSeries(DD x) {
+    DD x2 = mul(x, x);
+    DD term = x;
+    DD sum = x;
+    for (int n = 1; n < 16; n++) {
+        term = div(mul(term, neg(x2)), {double((2 * n) * (2 * n + 1)), 0});
+        sum = add(sum, term);
+    }
+    return sum;
+}
+
+constexpr DD cosSeries(DD x) {
+    DD x2 = mul(x, x);
+    DD term = {1, 0};
+    DD sum = {1, 0};
+    for (int n = 1; n < 16; n++) {
+        term = div(mul(term, neg(x2)), {double((2 * n - 1) * (2 * n)), 0});
+        sum = add(sum, term);
+    }
+    return sum;
+}
+
+// sin of step * (1/20 degree) for step in [0, 90 degrees].
+constexpr DD sinFirstQuadrant(int step) {
+    const int quarter = 90 * AngleGridSteps;
+    if (step <= quarter / 2) {
+        return sinSeries(mul(radiansPerStep(), {double(step), 0}));
+    }
+    return cosSeries(mul(radiansPerStep(), {double(quarter - step), 0}));
+}
+
+constexpr DD sinStep(int step) {
+    const int half = 180 * AngleGridSteps;
+    return sinFirstQuadrant(step <= half / 2 ? step : half - step);
+}
+
+constexpr DD cosStep(int step) {
+    const int quarter = 90 * AngleGridSteps;
+    if (step <= quarter) {
+        return sinFirstQuadrant(quarter - step);
+    }
+    return neg(sinFirstQuadrant(step - quarter));
+}
+
+struct Tables {
+    std::array<double, AngleGridSize> sin{};
+    std::array<double, AngleGridSize> cos{};
+    std::array<double, AngleGridSize> tan{};
+};
+
+constexpr Tables buildTables() {
+    Tables tables;
+    for (int step = 0; step < AngleGridSize; step++) {
+        DD s = sinStep(step);
+        DD c = cosStep(step);
+        tables.sin[step] = s.hi + s.lo;
+        tables.cos[step] = c.hi + c.lo;
+        if (step == 90 * AngleGridSteps) {
+            tables.tan[step] = std::numeric_limits<double>::infinity();
+        } else {
+            DD t = div(s, c);
+            tables.tan[step] = t.hi + t.lo;
+        }
+    }
+    return tables;
+}
+
+}
+
+inline constexpr angleTableDetail::Tables kAngleTables = angleTableDetail::buildTables();
+
+// True when degrees is exactly the double nearest to some multiple of 1/20
+// degree in [0, 180], i.e. what parsing a value like "37.5" or "12.35" gives.
+inline bool angleGridIndex(double degrees, int& step) {
+    double scaled = degrees * AngleGridSteps;
+    if (!(scaled >= 0 && scaled <= AngleGridSize - 1)) {
+        return false;
+    }
+    int candidate = int(scaled + 0.5);
+    if (double(candidate) / AngleGridSteps != degrees) {
+        return false;
+    }
+    step = candidate;
+    return true;
+}
+
+#endif // ANGLETABLES_H
@@ -0,0 +1,97 @@
+#include "batchKernels.h"
+#include "triangleCore.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const std::size_t KernelBlock = 256;
+
+// Computes one block into dense local columns, then copies out what was asked for.
+// With KnownArea the area is taken from the caller and the angles come from
+// atan2(4 * Area, b^2 + c^2 - a^2), which stays accurate for needle-thin faces
+// where the acos of the law of cosines loses most of its digits.
+template <bool KnownArea>
+void sssBlock(const double* AB, const double* AC, const double* BC, const double* knownArea, std::size_t count,
+              std::size_t offset, const SssColumns& out)
+{
+    double area[KernelBlock], angleA[KernelBlock], angleB[KernelBlock], angleC[KernelBlock];
+    double inRadius[KernelBlock], circumRadius[KernelBlock];
+    double heightA[KernelBlock], heightB[KernelBlock], heightC[KernelBlock];
+    double medianA[KernelBlock], medianB[KernelBlock], medianC[KernelBlock];
+    double bisectorA[KernelBlock], bisectorB[KernelBlock], bisectorC[KernelBlock];
+
+    const double degreesPerRadian = 180.0 / PI;
+    for (std::size_t i = 0; i < count; i++) {
+        double c = AB[i];
+        double b = AC[i];
+        double a = BC[i];
+        double aa = a * a;
+        double bb = b * b;
+        double cc = c * c;
+        double s = (c + b + a) / 2;
+        double A;
+        if constexpr (KnownArea) {
+            A = knownArea[i];
+            angleA[i] = std::atan2(4 * A, cc + bb - aa) * degreesPerRadian;
+            angleB[i] = std::atan2(4 * A, cc + aa - bb) * degreesPerRadian;
+        } else {
+            A = std::sqrt(s * (s - c) * (s - b) * (s - a));
+            angleA[i] = std::acos((cc + bb - aa) / (2 * c * b)) * degreesPerRadian;
+            angleB[i] = std::acos((cc + aa - bb) / (2 * c * a)) * degreesPerRadian;
+        }
+        area[i] = A;
+        circumRadius[i] = (c * a * b) / (4 * A);
+        angleC[i] = 180.0 - angleA[i] - angleB[i];
+        inRadius[i] = A / s;
+        medianA[i] = 0.5 * std::sqrt(2 * cc + 2 * bb - aa);
+        medianB[i] = 0.5 * std::sqrt(2 * cc + 2 * aa - bb);
+        medianC[i] = 0.5 * std::sqrt(2 * aa + 2 * bb - cc);
+        bisectorC[i] = std::sqrt(b * a * (1 - cc / ((b + a) * (b + a))));
+        bisectorA[i] = std::sqrt(c * b * (1 - aa / ((c + b) * (c + b))));
+        bisectorB[i] = std::sqrt(c * a * (1 - bb / ((c + a) * (c + a))));
+        heightA[i] = 2 * A / a;
+        heightB[i] = 2 * A / b;
+        heightC[i] = 2 * A / c;
+    }
+
+    auto store = [&](double* column, const double* values) {
+        if (column) {
+            std::copy(values, values + count, column + offset);
+        }
+    };
+    store(out.Area, area);
+    store(out.angleA, angleA);
+    store(out.angleB, angleB);
+    store(out.angleC, angleC);
+    store(out.inRadius, inRadius);
+    store(out.circumRadius, circumRadius);
+    store(out.HeightAH, heightA);
+    store(out.HeightBH, heightB);
+    store(out.HeightCH, heightC);
+    store(out.median_AM, medianA);
+    store(out.median_BM, medianB);
+    store(out.median_CM, medianC);
+    store(out.BisectorA, bisectorA);
+    store(out.BisectorB, bisectorB);
+    store(out.BisectorC, bisectorC);
+}
+
+}
+
+void solveSssBatch(const double* AB, const double* AC, const double* BC, std::size_t count, const SssColumns& out)
+{
+    for (std::size_t first = 0; first < count; first += KernelBlock) {
+        std::size_t n = std::min(KernelBlock, count - first);
+        sssBlock<false>(AB + first, AC + first, BC + first, nullptr, n, first, out);
+    }
+}
+
+void solveSssAreaBatch(const double* AB, const double* AC, const double* BC, const double* Area, std::size_t count,
+                       const SssColumns& out)
+{
+    for (std::size_t first = 0; first < count; first += KernelBlock) {
+        std::size_t n = std::min(KernelBlock, count - first);
+        sssBlock<true>(AB + first, AC + first, BC + first, Area + first, n, first, out);
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef BATCHKERNELS_H
+#define BATCHKERNELS_H
+
+#include <cstddef>
+
+// Branch-free structure-of-arrays kernels for the batch paths. Each one is
+// the straight-line formula set of one solver branch, written so the
+// compiler can vectorize the loop (no calls other than sqrt/acos, no
+// data-dependent branches).
+
+// Output columns of the SSS branch. Any pointer may be null.
+struct SssColumns {
+    double* Area = nullptr;
+    double* angleA = nullptr;
+    double* angleB = nullptr;
+    double* angleC = nullptr;
+    double* inRadius = nullptr;
+    double* circumRadius = nullptr;
+    double* HeightAH = nullptr;
+    double* HeightBH = nullptr;
+    double* HeightCH = nullptr;
+    double* median_AM = nullptr;
+    double* median_BM = nullptr;
+    double* median_CM = nullptr;
+    double* BisectorA = nullptr;
+    double* BisectorB = nullptr;
+    double* BisectorC = nullptr;
+};
+
+// Three sides known: Heron's area, calculate_3Angles and the derived lengths,
+// exactly as the SSS branch of solveTriangle computes them. Rows are
+// processed in blocks so every required column is filled even when the
+// caller leaves some pointers null.
+void solveSssBatch(const double* AB, const double* AC, const double* BC, std::size_t count, const SssColumns& out);
+
+// Three sides plus an area computed independently (e.g. from a cross product).
+// Skips Heron's formula and takes the angles from atan2 instead of acos, so
+// needle-thin triangles keep their accuracy. out.Area receives the input area.
+void solveSssAreaBatch(const double* AB, const double* AC, const double* BC, const double* Area, std::size_t count,
+                       const SssColumns& out);
+
+#endif // BATCHKERNELS_H
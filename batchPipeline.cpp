@@ -0,0 +1,253 @@
+#include "batchPipeline.h"
+#include "batchSolver.h"
+#include "ringBuffer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+struct Chunk {
+    std::size_t sequence = 0;
+    std::size_t count = 0;
+    std::vector<TriangleValues> inputs;
+    std::vector<TriangleValues> results;
+    std::vector<unsigned char> valid;
+    std::vector<uint32_t> reasons;   // rejectInfeasible only
+    std::vector<uint32_t> solvedRows; // rejectInfeasible only: where each solved row goes
+    std::vector<unsigned char> solved; // solve only: cleared by it for rows with no solution
+};
+
+// Sent by the reader to each solver once the input is exhausted.
+const std::size_t EndOfInput = std::numeric_limits<std::size_t>::max();
+
+}
+
+PipelineStats runBatchPipeline(std::istream& in, const PipelineSink& sink, const PipelineOptions& options)
+{
+    unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    unsigned solverThreads = options.solverThreads ? options.solverThreads : std::max(1u, hardware > 2 ? hardware - 2 : 1u);
+    std::size_t chunkRows = std::max<std::size_t>(1, options.chunkRows);
+    std::size_t chunkCount = options.chunksInFlight ? options.chunksInFlight : 4 * solverThreads;
+    chunkCount = std::max<std::size_t>(chunkCount, 2);
+
+    // Every chunk is allocated here; the stages only pass indices around.
+    std::vector<Chunk> chunks(chunkCount);
+    for (Chunk& chunk : chunks) {
+        chunk.inputs.resize(chunkRows);
+        chunk.results.resize(chunkRows);
+        chunk.valid.resize(chunkRows);
+        if (options.rejectInfeasible) {
+            chunk.reasons.resize(chunkRows);
+            chunk.solvedRows.resize(chunkRows);
+        }
+        if (options.solve) {
+            chunk.solved.resize(chunkRows);
+        }
+    }
+
+    SpscRing<std::size_t> freeChunks(chunkCount);    // writer -> reader
+    MpmcRing<std::size_t> solveQueue(chunkCount + solverThreads); // reader -> solvers
+    MpmcRing<std::size_t> writeQueue(chunkCount);    // solvers -> writer
+    for (std::size_t i = 0; i < chunkCount; i++) {
+        freeChunks.tryPush(i);
+    }
+
+    std::atomic<std::size_t> totalChunks{EndOfInput};
+    std::atomic<bool> cancelled{false};
+    std::atomic<std::size_t> invalidRows{0};
+    std::atomic<long long> solverBusyNs{0};
+    double readerBusy = 0;
+    double writerBusy = 0;
+    std::size_t rows = 0;
+
+    Clock::time_point start = Clock::now();
+
+    std::thread reader([&] {
+        std::string line;
+        std::size_t sequence = 0;
+        bool more = true;
+        std::size_t bytes = 0;
+        while (more) {
+            if (options.cancel && options.cancel->load(std::memory_order_relaxed)) {
+                cancelled.store(true, std::memory_order_relaxed);
+                break;
+            }
+            std::size_t index;
+            popWait(freeChunks, index);
+            Clock::time_point busyStart = Clock::now();
+            Chunk& chunk = chunks[index];
+            chunk.sequence = sequence;
+            chunk.count = 0;
+            while (chunk.count < chunkRows) {
+                if (!std::getline(in, line)) {
+                    more = false;
+                    break;
+                }
+                bytes += line.size() + 1;
+                if (line.empty() || line == "\r") {
+                    continue;
+                }
+                std::size_t row = chunk.count++;
+                chunk.valid[row] = parseTriangleRow(line.data(), line.data() + line.size(), chunk.inputs[row]);
+            }
+            readerBusy += secondsSince(busyStart);
+            if (options.bytesRead) {
+                options.bytesRead->store(bytes, std::memory_order_relaxed);
+            }
+            if (chunk.count == 0) {
+                freeChunks.tryPush(index);
+                break;
+            }
+            pushWait(solveQueue, index);
+            sequence++;
+        }
+        totalChunks.store(sequence, std::memory_order_release);
+        writeQueue.parking.notify(); // the writer may be parked with everything written
+        for (unsigned i = 0; i < solverThreads; i++) {
+            pushWait(solveQueue, EndOfInput);
+        }
+    });
+
+    std::vector<FeasibilityCounts> rejectCounts(solverThreads);
+    std::vector<std::thread> solvers;
+    for (unsigned t = 0; t < solverThreads; t++) {
+        solvers.emplace_back([&, t] {
+            for (;;) {
+                std::size_t index;
+                popWait(solveQueue, index);
+                if (index == EndOfInput) {
+                    return;
+                }
+                Clock::time_point busyStart = Clock::now();
+                Chunk& chunk = chunks[index];
+                // With rejectInfeasible the rows that pass are packed to the front of
+                // inputs, solved there, and moved back to their places afterwards.
+                std::size_t solveCount = chunk.count;
+                if (options.rejectInfeasible) {
+                    checkFeasibility(chunk.inputs.data(), chunk.count, chunk.reasons.data());
+                    solveCount = 0;
+                    for (std::size_t row = 0; row < chunk.count; row++) {
+                        if (!chunk.valid[row]) {
+                            continue;
+                        }
+                        if (chunk.reasons[row]) {
+                            rejectCounts[t].add(chunk.reasons[row]);
+                            continue;
+                        }
+                        chunk.inputs[solveCount] = chunk.inputs[row];
+                        chunk.solvedRows[solveCount++] = uint32_t(row);
+                    }
+                }
+                if (options.solve) {
+                    std::fill_n(chunk.solved.data(), solveCount, 1);
+                    options.solve(chunk.inputs.data(), chunk.results.data(), solveCount, chunk.solved.data());
+                    for (std::size_t k = 0; k < solveCount; k++) {
+                        if (!chunk.solved[k]) {
+                            chunk.valid[options.rejectInfeasible ? chunk.solvedRows[k] : k] = 0;
+                        }
+                    }
+                } else {
+                    solveBatch(chunk.inputs.data(), chunk.results.data(), solveCount);
+                }
+                if (options.rejectInfeasible) {
+                    // solvedRows is increasing and solvedRows[k] >= k, so walking back never overwrites a pending row.
+                    std::size_t next = solveCount;
+                    for (std::size_t row = chunk.count; row-- > 0;) {
+                        if (next > 0 && chunk.solvedRows[next - 1] == row) {
+                            chunk.results[row] = chunk.results[--next];
+                        } else {
+                            std::fill_n(&chunk.results[row].AB, FieldCount, std::numeric_limits<double>::quiet_NaN());
+                        }
+                    }
+                }
+                std::size_t invalid = 0;
+                for (std::size_t row = 0; row < chunk.count; row++) {
+                    if (!chunk.valid[row]) {
+                        std::fill_n(&chunk.results[row].AB, FieldCount, std::numeric_limits<double>::quiet_NaN());
+                        invalid++;
+                    }
+                }
+                invalidRows.fetch_add(invalid, std::memory_order_relaxed);
+                solverBusyNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - busyStart).count(),
+                                       std::memory_order_relaxed);
+                pushWait(writeQueue, index);
+            }
+        });
+    }
+
+    // The writer runs on this thread. Chunks can finish out of order, but at
+    // most chunkCount are in flight, so sequence % chunkCount is a free slot.
+    std::vector<std::size_t> pending(chunkCount, EndOfInput);
+    std::size_t nextSequence = 0;
+    while (nextSequence != totalChunks.load(std::memory_order_acquire)) {
+        std::size_t index;
+        if (!popWaitUnless(writeQueue, index,
+                           [&] { return nextSequence == totalChunks.load(std::memory_order_acquire); })) {
+            continue;
+        }
+        pending[chunks[index].sequence % chunkCount] = index;
+        Clock::time_point busyStart = Clock::now();
+        for (;;) {
+            std::size_t& slot = pending[nextSequence % chunkCount];
+            if (slot == EndOfInput) {
+                break;
+            }
+            Chunk& chunk = chunks[slot];
+            sink(chunk.results.data(), chunk.count);
+            rows += chunk.count;
+            pushWait(freeChunks, slot);
+            slot = EndOfInput;
+            nextSequence++;
+        }
+        writerBusy += secondsSince(busyStart);
+    }
+    reader.join();
+    for (std::thread& solver : solvers) {
+        solver.join();
+    }
+
+    PipelineStats stats;
+    stats.rows = rows;
+    stats.invalidRows = invalidRows.load();
+    stats.solverThreads = solverThreads;
+    stats.cancelled = cancelled.load();
+    stats.wallSeconds = secondsSince(start);
+    double wall = std::max(stats.wallSeconds, 1e-9);
+    stats.reader.busySeconds = readerBusy;
+    stats.reader.utilization = readerBusy / wall;
+    stats.solver.busySeconds = solverBusyNs.load() * 1e-9;
+    stats.solver.utilization = stats.solver.busySeconds / (wall * solverThreads);
+    stats.writer.busySeconds = writerBusy;
+    stats.writer.utilization = writerBusy / wall;
+    for (const FeasibilityCounts& threadCounts : rejectCounts) {
+        stats.rejected += threadCounts;
+    }
+    return stats;
+}
+
+PipelineStats runBatchPipeline(std::istream& in, std::ostream& out, const PipelineOptions& options)
+{
+    SolveArena& arena = SolveArena::forThread();
+    PipelineStats stats = runBatchPipeline(in, [&](const TriangleValues* rows, std::size_t count) {
+        std::string_view text = formatResults(rows, count, arena);
+        out.write(text.data(), text.size());
+        arena.reset();
+    }, options);
+    out.flush();
+    return stats;
+}
@@ -0,0 +1,55 @@
+#ifndef BATCHPIPELINE_H
+#define BATCHPIPELINE_H
+
+#include "feasibility.h"
+#include "triangleCore.h"
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+
+// Streaming CSV batch solve: reader -> solver pool -> writer, each stage on
+// its own thread(s) and connected by bounded rings from ringBuffer.h.
+// Input lines hold up to 16 inputs (calculateMissingValues order), output
+// lines hold all 18 values in the same order as the input lines.
+
+// Solves count rows into outputs in place of solveBatch, e.g. through a cache.
+// Called from every solver thread at once. solved[i] starts at 1; clearing it
+// marks row i as having no solution, so it is written as an all-NaN row.
+using PipelineSolver = std::function<void(const TriangleValues* inputs, TriangleValues* outputs, std::size_t count,
+                                          unsigned char* solved)>;
+
+struct PipelineOptions {
+    unsigned solverThreads = 0;     // 0 = one per hardware thread, minus reader and writer
+    std::size_t chunkRows = 1024;   // rows handed between stages at a time
+    std::size_t chunksInFlight = 0; // 0 = 4 per solver thread; bounds memory use
+    bool rejectInfeasible = false;  // run checkFeasibility first and write rejected rows as all-NaN rows
+    PipelineSolver solve;           // null: solveBatch
+    const std::atomic<bool>* cancel = nullptr;  // set to stop reading; rows already read still come out
+    std::atomic<std::size_t>* bytesRead = nullptr; // updated by the reader once per chunk, for progress
+};
+
+struct StageStats {
+    double busySeconds = 0;
+    double utilization = 0; // busy time / (wall time * threads in the stage)
+};
+
+struct PipelineStats {
+    std::size_t rows = 0;
+    std::size_t invalidRows = 0; // unparsable or left unsolved by solve; written as all-NaN rows
+    FeasibilityCounts rejected; // rows that failed checkFeasibility (rejectInfeasible only), also all-NaN
+    unsigned solverThreads = 0;
+    double wallSeconds = 0;
+    StageStats reader;
+    StageStats solver;
+    StageStats writer;
+    bool cancelled = false;
+};
+
+// Receives solved rows in input order, on the thread that called runBatchPipeline.
+using PipelineSink = std::function<void(const TriangleValues* rows, std::size_t count)>;
+
+PipelineStats runBatchPipeline(std::istream& in, const PipelineSink& sink, const PipelineOptions& options = PipelineOptions());
+PipelineStats runBatchPipeline(std::istream& in, std::ostream& out, const PipelineOptions& options = PipelineOptions());
+
+#endif // BATCHPIPELINE_H
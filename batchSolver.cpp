@@ -0,0 +1,113 @@
+#include "batchSolver.h"
+#include "allocationTracker.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+
+void solveBatch(const TriangleValues* inputs, TriangleValues* outputs, std::size_t count)
+{
+    NoAllocationScope noAllocations("solveBatch");
+    for (std::size_t i = 0; i < count; i++) {
+        outputs[i] = inputs[i];
+        solveTriangle(outputs[i]);
+    }
+}
+
+void solveBatch(const TriangleValues* inputs, std::size_t count, ResultBuffer& results)
+{
+    results.prepare(count);
+    solveBatch(inputs, results.data(), count);
+}
+
+void solveBatch(const TriangleValues* inputs, TriangleValues* outputs, std::size_t count, ShapeCache& cache)
+{
+    NoAllocationScope noAllocations("solveBatch");
+    for (std::size_t i = 0; i < count; i++) {
+        outputs[i] = inputs[i];
+        cache.solve(outputs[i]);
+    }
+}
+
+std::size_t solveBatch(const TriangleValues* inputs, TriangleValues* outputs, std::size_t count, uint32_t* reasons)
+{
+    NoAllocationScope noAllocations("solveBatch");
+    // Checked a block at a time, so the rows are still in cache when they are solved.
+    const std::size_t block = 256;
+    std::size_t solved = 0;
+    for (std::size_t start = 0; start < count; start += block) {
+        std::size_t end = std::min(count, start + block);
+        checkFeasibility(inputs + start, end - start, reasons + start);
+        for (std::size_t i = start; i < end; i++) {
+            if (reasons[i]) {
+                std::fill_n(&outputs[i].AB, FieldCount, std::numeric_limits<double>::quiet_NaN());
+                continue;
+            }
+            outputs[i] = inputs[i];
+            solveTriangle(outputs[i]);
+            solved++;
+        }
+    }
+    return solved;
+}
+
+bool parseTriangleRow(const char* begin, const char* end, TriangleValues& values)
+{
+    values = TriangleValues();
+    int field = 0;
+    const char* p = begin;
+    for (;;) {
+        const char* cellEnd = static_cast<const char*>(std::memchr(p, ',', end - p));
+        if (!cellEnd) {
+            cellEnd = end;
+        }
+        if (field == InputFieldCount) {
+            return false;
+        }
+        const char* cell = p;
+        while (cell < cellEnd && (*cell == ' ' || *cell == '\t')) {
+            cell++;
+        }
+        const char* last = cellEnd;
+        while (last > cell && (last[-1] == ' ' || last[-1] == '\t' || last[-1] == '\r')) {
+            last--;
+        }
+        if (cell != last) {
+            double value = 0;
+            auto [ptr, ec] = std::from_chars(cell, last, value);
+            if (ec != std::errc() || ptr != last) {
+                return false;
+            }
+            fieldValue(values, field) = value;
+        }
+        field++;
+        if (cellEnd == end) {
+            return true;
+        }
+        p = cellEnd + 1;
+    }
+}
+
+std::size_t formatTriangleRow(const TriangleValues& values, char* out, std::size_t capacity)
+{
+    char* p = out;
+    char* end = out + capacity;
+    for (int field = 0; field < FieldCount; field++) {
+        if (field > 0) {
+            *p++ = ',';
+        }
+        p = std::to_chars(p, end, fieldValue(values, field)).ptr;
+    }
+    *p++ = '\n';
+    return p - out;
+}
+
+std::string_view formatResults(const TriangleValues* rows, std::size_t count, SolveArena& arena)
+{
+    char* text = arena.allocateArray<char>(count * MaxFormattedRowLength);
+    std::size_t length = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        length += formatTriangleRow(rows[i], text + length, MaxFormattedRowLength);
+    }
+    return std::string_view(text, length);
+}
@@ -0,0 +1,55 @@
+#ifndef BATCHSOLVER_H
+#define BATCHSOLVER_H
+
+#include "triangleCore.h"
+#include "feasibility.h"
+#include "shapeCache.h"
+#include "solveArena.h"
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+// Result storage that is sized once and reused for every batch, so steady
+// state batches never grow it.
+class ResultBuffer
+{
+public:
+    void prepare(std::size_t count) {
+        if (rows.size() < count) {
+            rows.resize(count);
+        }
+        used = count;
+    }
+    TriangleValues* data() { return rows.data(); }
+    const TriangleValues* data() const { return rows.data(); }
+    std::size_t size() const { return used; }
+
+private:
+    std::vector<TriangleValues> rows;
+    std::size_t used = 0;
+};
+
+// Longest text formatTriangleRow can produce for one row.
+const std::size_t MaxFormattedRowLength = FieldCount * 25;
+
+// Solves count rows. Makes no heap allocation (checked by NoAllocationScope).
+void solveBatch(const TriangleValues* inputs, TriangleValues* outputs, std::size_t count);
+void solveBatch(const TriangleValues* inputs, std::size_t count, ResultBuffer& results);
+// Same, going through cache so scaled copies of an already solved shape skip the trig.
+void solveBatch(const TriangleValues* inputs, TriangleValues* outputs, std::size_t count, ShapeCache& cache);
+// Same, leaving out rows checkFeasibility rejects: their outputs are all NaN and
+// reasons[i] says why. Returns the number of rows solved.
+std::size_t solveBatch(const TriangleValues* inputs, TriangleValues* outputs, std::size_t count, uint32_t* reasons);
+
+// Parses one CSV line of up to 16 inputs in calculateMissingValues order.
+// Empty cells count as 0, like empty fields in the window.
+bool parseTriangleRow(const char* begin, const char* end, TriangleValues& values);
+
+// Writes the 18 values of one row as a CSV line ending in '\n'. Returns the
+// number of characters written; capacity must be at least MaxFormattedRowLength.
+std::size_t formatTriangleRow(const TriangleValues& values, char* out, std::size_t capacity);
+
+// Formats count rows into memory taken from arena. The view stays valid until the arena is reset.
+std::string_view formatResults(const TriangleValues* rows, std::size_t count, SolveArena& arena);
+
+#endif // BATCHSOLVER_H
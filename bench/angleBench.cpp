@@ -0,0 +1,60 @@
+#include "benchUtil.h"
+#include "../triangleCore.h"
+#include <cmath>
+#include <vector>
+
+// Angle-heavy workload: ASA and SAS triangles whose angles are whole degrees
+// or tenths (table path), against the same triangles with every angle nudged
+// one ulp off the grid (libm path).
+void benchAngleTables()
+{
+    const int count = 200000;
+    std::vector<TriangleValues> onGrid(count);
+    for (int i = 0; i < count; i++) {
+        TriangleValues& v = onGrid[i];
+        if (i % 2) {
+            v.angleA = 20 + (i % 400) / 10.0;
+            v.angleB = 30 + (i % 70);
+            v.AC = 1 + (i % 13);
+        } else {
+            v.AB = 2 + (i % 11);
+            v.BC = 3 + (i % 7);
+            v.angleB = 1 + (i % 1780) / 10.0;
+        }
+    }
+    std::vector<TriangleValues> offGrid = onGrid;
+    for (TriangleValues& v : offGrid) {
+        for (int field = Field_angleA; field <= Field_angleC; field++) {
+            double& angle = fieldValue(v, field);
+            if (angle > 0) {
+                angle = std::nextafter(angle, 180.0);
+            }
+        }
+    }
+
+    for (const std::vector<TriangleValues>* inputs : {&onGrid, &offGrid}) {
+        std::vector<TriangleValues> work = *inputs;
+        auto start = std::chrono::steady_clock::now();
+        for (TriangleValues& v : work) {
+            solveTriangle(v);
+        }
+        benchKeep(work);
+        benchReport(inputs == &onGrid ? "solve, grid angles (tables)" : "solve, off-grid angles (libm)",
+                    benchSeconds(start), count, "solves");
+    }
+
+    const int calls = 2000000;
+    double sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; i++) {
+        sum += sinDegrees((i % 1800) / 10.0);
+    }
+    benchKeep(sum);
+    benchReport("sinDegrees, grid", benchSeconds(start), calls, "calls");
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; i++) {
+        sum += std::sin(toRadians((i % 1800) / 10.0));
+    }
+    benchKeep(sum);
+    benchReport("sin(toRadians()), same angles", benchSeconds(start), calls, "calls");
+}
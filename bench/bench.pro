@@ -0,0 +1,80 @@
+# Console benchmarks for the solver core; no Qt modules needed.
+QT -= core gui
+
+CONFIG += c++17 console thread
+CONFIG -= app_bundle
+
+TARGET = triangleBench
+
+INCLUDEPATH += ..
+
+# Quad-precision reference instantiation (GCC + libquadmath)
+linux-g++* {
+    DEFINES += TRIANGLE_HAVE_FLOAT128
+    LIBS += -lquadmath
+}
+
+# rulesBench loads the shipped rule file from the source tree
+DEFINES += TRIANGLE_RULES_DIR=\\\"$$PWD/../rules\\\"
+
+# shm_open lives in librt on older glibc
+linux: LIBS += -lrt
+
+SOURCES += \
+    angleBench.cpp \
+    benchMain.cpp \
+    cacheBench.cpp \
+    columnarBench.cpp \
+    feasibilityBench.cpp \
+    integerBench.cpp \
+    meshBench.cpp \
+    plannerBench.cpp \
+    precisionBench.cpp \
+    reconcileBench.cpp \
+    rulesBench.cpp \
+    sensitivityBench.cpp \
+    shmBench.cpp \
+    sphericalBench.cpp \
+    startupBench.cpp \
+    uncertaintyBench.cpp \
+    ../allocationTracker.cpp \
+    ../batchKernels.cpp \
+    ../batchSolver.cpp \
+    ../columnarWriter.cpp \
+    ../derivationPlanner.cpp \
+    ../feasibility.cpp \
+    ../integerTriangles.cpp \
+    ../meshAnalysis.cpp \
+    ../persistentCache.cpp \
+    ../reconcile.cpp \
+    ../ruleSet.cpp \
+    ../sensitivity.cpp \
+    ../shapeCache.cpp \
+    ../shmSolver.cpp \
+    ../solveArena.cpp \
+    ../sphericalTriangle.cpp \
+    ../triangleCore.cpp \
+    ../uncertainty.cpp
+
+HEADERS += \
+    benchUtil.h \
+    ../angleTables.h \
+    ../batchKernels.h \
+    ../batchSolver.h \
+    ../columnarWriter.h \
+    ../derivationPlanner.h \
+    ../dualNumber.h \
+    ../feasibility.h \
+    ../integerTriangles.h \
+    ../meshAnalysis.h \
+    ../persistentCache.h \
+    ../philox.h \
+    ../reconcile.h \
+    ../ruleSet.h \
+    ../sensitivity.h \
+    ../shapeCache.h \
+    ../shmSolver.h \
+    ../sphericalTriangle.h \
+    ../triangleCore.h \
+    ../triangleCoreT.h \
+    ../uncertainty.h
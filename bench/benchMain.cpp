@@ -0,0 +1,76 @@
+#include <cstdio>
+#include <cstring>
+
+// triangleBench [name...]: runs the named benchmarks, or all of them.
+
+void benchAngleTables();
+void benchPrecision();
+void benchMeshAnalysis();
+void benchShapeCache();
+void checkShapeCache();
+void benchPersistentCache();
+void benchSensitivity();
+void benchUncertainty();
+void benchStartup();
+void benchFeasibility();
+void benchReconcile();
+void benchSpherical();
+void benchRules();
+void benchPlanner();
+void benchShm();
+void benchColumnar();
+void benchInteger();
+
+namespace {
+
+struct Benchmark {
+    const char* name;
+    void (*run)();
+};
+
+const Benchmark benchmarks[] = {
+    {"angles", benchAngleTables},
+    {"precision", benchPrecision},
+    {"mesh", benchMeshAnalysis},
+    {"cache", benchShapeCache},
+    {"cachecheck", checkShapeCache},
+    {"persistent", benchPersistentCache},
+    {"sensitivity", benchSensitivity},
+    {"uncertainty", benchUncertainty},
+    {"startup", benchStartup},
+    {"feasibility", benchFeasibility},
+    {"reconcile", benchReconcile},
+    {"spherical", benchSpherical},
+    {"rules", benchRules},
+    {"planner", benchPlanner},
+    {"shm", benchShm},
+    {"columnar", benchColumnar},
+    {"integer", benchInteger},
+};
+
+}
+
+int main(int argc, char* argv[])
+{
+    bool ranAny = false;
+    for (const Benchmark& benchmark : benchmarks) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; i++) {
+            selected = selected || std::strcmp(argv[i], benchmark.name) == 0;
+        }
+        if (selected) {
+            std::printf("== %s\n", benchmark.name);
+            benchmark.run();
+            ranAny = true;
+        }
+    }
+    if (!ranAny) {
+        std::fprintf(stderr, "usage: %s [", argv[0]);
+        for (const Benchmark& benchmark : benchmarks) {
+            std::fprintf(stderr, " %s", benchmark.name);
+        }
+        std::fprintf(stderr, " ]\n");
+        return 1;
+    }
+    return 0;
+}
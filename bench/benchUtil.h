@@ -0,0 +1,26 @@
+#ifndef BENCHUTIL_H
+#define BENCHUTIL_H
+
+#include <chrono>
+#include <cstdio>
+
+// Shared helpers for the triangleBench benchmarks.
+
+inline double benchSeconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Stops the optimizer from discarding a computed value.
+template <typename T>
+inline void benchKeep(const T& value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+inline void benchReport(const char* name, double seconds, double items, const char* unit)
+{
+    std::printf("%-36s %10.3f ms %14.0f %s/s\n", name, seconds * 1e3, items / seconds, unit);
+}
+
+#endif // BENCHUTIL_H
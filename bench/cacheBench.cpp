@@ -0,0 +1,244 @@
+#include "benchUtil.h"
+#include "../batchSolver.h"
+#include "../persistentCache.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+double relativeDifference(double a, double b)
+{
+    if (std::isnan(a) || std::isnan(b)) {
+        return std::isnan(a) && std::isnan(b) ? 0 : INFINITY;
+    }
+    if (a == b) {
+        return 0;
+    }
+    return std::fabs(a - b) / std::max(std::fabs(a), std::fabs(b));
+}
+
+}
+
+// Not a timing: ShapeCache against solveTriangle for every two- and
+// three-input combination, which reaches all 34 solver branches, with each
+// shape solved at several scales through one cache so later scales hit.
+void checkShapeCache()
+{
+    const double scales[] = {1.0, 1e-3, 0.37, 10.0, 1e4};
+    const int shapesPerMask = 20;
+    const double tolerance = 1e-6;
+    std::mt19937_64 rng(28);
+    std::uniform_real_distribution<double> side(1.0, 10.0);
+
+    std::size_t rows = 0;
+    std::size_t mismatches = 0;
+    std::size_t failingMasks = 0;
+    std::size_t masks = 0;
+    ShapeCacheStats stats;
+    for (uint32_t mask = 1; mask < (1u << InputFieldCount); mask++) {
+        int bits = __builtin_popcount(mask);
+        if (bits < 2 || bits > 3) {
+            continue;
+        }
+        masks++;
+        ShapeCache cache;
+        std::size_t maskMismatches = 0;
+        for (int shape = 0; shape < shapesPerMask; shape++) {
+            TriangleValues full;
+            do {
+                full.AB = side(rng);
+                full.AC = side(rng);
+                full.BC = side(rng);
+            } while (full.AB + full.AC <= full.BC || full.AB + full.BC <= full.AC || full.AC + full.BC <= full.AB);
+            solveTriangle(full);
+            for (double scale : scales) {
+                TriangleValues input;
+                for (int field = 0; field < InputFieldCount; field++) {
+                    if (mask & (1u << field)) {
+                        double power = field == Field_Area ? scale * scale
+                                       : field >= Field_angleA && field <= Field_angleC ? 1.0 : scale;
+                        fieldValue(input, field) = fieldValue(full, field) * power;
+                    }
+                }
+                TriangleValues direct = input;
+                solveTriangle(direct);
+                TriangleValues cached = input;
+                cache.solve(cached);
+                rows++;
+                for (int field = 0; field < FieldCount; field++) {
+                    if (relativeDifference(fieldValue(direct, field), fieldValue(cached, field)) > tolerance) {
+                        if (maskMismatches++ == 0) {
+                            std::printf("  mask %05x scale %g: %s is %.17g direct, %.17g cached\n", mask, scale,
+                                        kTriangleFieldNames[field], fieldValue(direct, field),
+                                        fieldValue(cached, field));
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+        mismatches += maskMismatches;
+        failingMasks += maskMismatches != 0;
+        stats += cache.stats();
+    }
+    std::printf("%zu masks, %zu rows: %zu rows differ by more than %g in %zu masks (%s)\n", masks, rows, mismatches,
+                tolerance, failingMasks, mismatches ? "FAILED" : "ok");
+    std::printf("hit rate %.3f, %zu rows bypassed\n", stats.hitRate(), stats.bypassed);
+}
+
+// Rows drawn from a fixed pool of shapes at random scales, solved by 1..64
+// threads with a ShapeCache per thread and with no cache.
+void benchShapeCache()
+{
+    const std::size_t shapeCount = 20000;
+    const std::size_t rowsPerThread = 200000;
+    const std::size_t chunk = 1024;
+
+    std::mt19937_64 rng(36);
+    std::uniform_real_distribution<double> side(1.0, 10.0);
+    std::uniform_real_distribution<double> scale(0.1, 1000.0);
+    std::vector<TriangleValues> shapes;
+    while (shapes.size() < shapeCount) {
+        TriangleValues shape;
+        shape.AB = side(rng);
+        shape.AC = side(rng);
+        shape.BC = side(rng);
+        if (shape.AB + shape.AC > shape.BC && shape.AB + shape.BC > shape.AC && shape.AC + shape.BC > shape.AB) {
+            shapes.push_back(shape);
+        }
+    }
+
+    for (unsigned threads = 1; threads <= 64; threads *= 2) {
+        std::vector<std::vector<TriangleValues>> inputs(threads);
+        for (unsigned t = 0; t < threads; t++) {
+            std::mt19937_64 threadRng(t);
+            std::uniform_int_distribution<std::size_t> pick(0, shapeCount - 1);
+            inputs[t].resize(rowsPerThread);
+            for (TriangleValues& row : inputs[t]) {
+                row = shapes[pick(threadRng)];
+                double s = scale(threadRng);
+                row.AB *= s;
+                row.AC *= s;
+                row.BC *= s;
+            }
+        }
+        double rows = double(threads) * rowsPerThread;
+
+        for (int cached = 1; cached >= 0; cached--) {
+            std::vector<ShapeCacheStats> stats(threads);
+            auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < threads; t++) {
+                workers.emplace_back([&, t] {
+                    std::vector<TriangleValues> out(chunk);
+                    ShapeCache own;
+                    for (std::size_t first = 0; first < rowsPerThread; first += chunk) {
+                        const TriangleValues* in = inputs[t].data() + first;
+                        if (cached) {
+                            solveBatch(in, out.data(), chunk, own);
+                        } else {
+                            solveBatch(in, out.data(), chunk);
+                        }
+                        benchKeep(out[0]);
+                    }
+                    stats[t] = own.stats();
+                });
+            }
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+            double seconds = benchSeconds(start);
+
+            ShapeCacheStats total;
+            for (const ShapeCacheStats& threadStats : stats) {
+                total += threadStats;
+            }
+            char name[64];
+            std::snprintf(name, sizeof name, "%2u threads, %s", threads, cached ? "per-thread cache" : "no cache");
+            benchReport(name, seconds, rows, "rows");
+            if (cached) {
+                std::printf("%36s hit rate %.3f, evictions %zu\n", "", total.hitRate(), total.evictions);
+            }
+        }
+    }
+}
+
+// 200000 distinct rows solved with no cache, through an empty
+// PersistentSolveCache (every row a miss and an insert) and through the same
+// file reopened (every row a hit). Once for SSS rows, the cheapest solve, and
+// once spread over every three-input set solveTriangle has a branch for.
+void benchPersistentCache()
+{
+    const std::size_t rowCount = 200000;
+    const std::size_t chunk = 1024;
+    const std::size_t fileBytes = std::size_t(256) << 20;
+    const std::string path = (std::filesystem::temp_directory_path() / "triangleBench.tpsc").string();
+
+    std::mt19937_64 rng(40);
+    std::uniform_real_distribution<double> side(1.0, 10.0);
+    std::vector<uint32_t> mixedMasks;
+    for (uint32_t mask = 1; mask < (1u << InputFieldCount); mask++) {
+        if (__builtin_popcount(mask) == 3 && triangleBranch(mask)) {
+            mixedMasks.push_back(mask);
+        }
+    }
+    const uint32_t sssMask = (1u << Field_AB) | (1u << Field_AC) | (1u << Field_BC);
+
+    for (int mixed = 0; mixed < 2; mixed++) {
+        std::vector<TriangleValues> inputs(rowCount);
+        for (std::size_t row = 0; row < rowCount; row++) {
+            TriangleValues full;
+            do {
+                full.AB = side(rng);
+                full.AC = side(rng);
+                full.BC = side(rng);
+            } while (full.AB + full.AC <= full.BC || full.AB + full.BC <= full.AC || full.AC + full.BC <= full.AB);
+            solveTriangle(full);
+            uint32_t mask = mixed ? mixedMasks[row % mixedMasks.size()] : sssMask;
+            for (int field = 0; field < InputFieldCount; field++) {
+                if (mask & (1u << field)) {
+                    fieldValue(inputs[row], field) = fieldValue(full, field);
+                }
+            }
+        }
+        std::vector<TriangleValues> out(chunk);
+        const char* rows = mixed ? "mixed rows" : "SSS rows";
+
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t first = 0; first < rowCount; first += chunk) {
+            solveBatch(inputs.data() + first, out.data(), std::min(chunk, rowCount - first));
+            benchKeep(out[0]);
+        }
+        char name[64];
+        std::snprintf(name, sizeof name, "%s, no cache", rows);
+        benchReport(name, benchSeconds(start), rowCount, "rows");
+
+        std::remove(path.c_str());
+        for (int warm = 0; warm < 2; warm++) {
+            PersistentSolveCache cache;
+            std::string error;
+            if (!cache.open(path, fileBytes, error)) {
+                std::printf("persistent: %s\n", error.c_str());
+                return;
+            }
+            start = std::chrono::steady_clock::now();
+            for (std::size_t first = 0; first < rowCount; first += chunk) {
+                cache.solve(inputs.data() + first, out.data(), std::min(chunk, rowCount - first));
+                benchKeep(out[0]);
+            }
+            double seconds = benchSeconds(start);
+            PersistentCacheStats stats = cache.stats();
+            std::snprintf(name, sizeof name, "%s, %s cache", rows, warm ? "warm" : "cold");
+            benchReport(name, seconds, rowCount, "rows");
+            std::printf("%36s hit rate %.3f, %zu inserts, %zu insert failures\n", "", stats.hitRate(), stats.inserts,
+                        stats.insertFailures);
+        }
+    }
+    std::remove(path.c_str());
+}
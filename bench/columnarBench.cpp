@@ -0,0 +1,83 @@
+#include "benchUtil.h"
+#include "../batchSolver.h"
+#include "../columnarWriter.h"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// A one-million-row AB x AC x angleA grid written and read back with each
+// column encoding: bytes per row, write and read throughput.
+
+void benchColumnar()
+{
+    const uint32_t groupRows = 4096;
+    const uint32_t groupCount = 256;
+    const std::size_t count = std::size_t(groupRows) * groupCount;
+    std::vector<TriangleValues> inputs(count);
+    for (std::size_t i = 0; i < count; i++) {
+        inputs[i].AB = 1 + 0.5 * double(i / (64 * 128));
+        inputs[i].AC = 1 + 0.5 * double(i / 128 % 64);
+        inputs[i].angleA = 1 + double(i % 128);
+    }
+    std::vector<TriangleValues> solved(count);
+    solveBatch(inputs.data(), solved.data(), count);
+    std::vector<double> block(FieldCount * count);
+    std::vector<std::string> names(kTriangleFieldNames, kTriangleFieldNames + FieldCount);
+    for (int field = 0; field < FieldCount; field++) {
+        for (std::size_t i = 0; i < count; i++) {
+            block[field * count + i] = fieldValue(solved[i], field);
+        }
+    }
+
+    struct Case {
+        const char* name;
+        std::vector<const char*> specs;
+    };
+    const Case cases[] = {
+        {"float64", {}},
+        {"float32", {"*=float32"}},
+        {"float16", {"*=float16"}},
+        {"fixed 1e-6", {"*=fixed:1e-6"}},
+        {"delta 1e-6", {"*=delta:1e-6"}},
+        {"delta 1e-6, heights @HeightAH", {"*=delta:1e-6", "HeightBH=delta:1e-6@HeightAH",
+                                          "HeightCH=delta:1e-6@HeightAH"}},
+    };
+    const std::string path = (std::filesystem::temp_directory_path() / "triangleBench.tcol").string();
+    for (const Case& test : cases) {
+        std::vector<ColumnarFormat> formats(FieldCount);
+        std::string error;
+        for (const char* spec : test.specs) {
+            parseColumnarFormat(spec, names, formats, error);
+        }
+        ColumnarWriter writer;
+        auto start = std::chrono::steady_clock::now();
+        if (!writer.open(path, names, std::string(), false, error) || !writer.setFormats(formats, error)) {
+            std::printf("columnar: %s\n", error.c_str());
+            return;
+        }
+        const double* columns[FieldCount];
+        for (uint32_t group = 0; group < groupCount; group++) {
+            for (int field = 0; field < FieldCount; field++) {
+                columns[field] = block.data() + field * count + std::size_t(group) * groupRows;
+            }
+            writer.writeGroup(uint64_t(group) * groupRows, columns, groupRows);
+        }
+        writer.close();
+        double writeSeconds = benchSeconds(start);
+
+        ColumnarTable table;
+        start = std::chrono::steady_clock::now();
+        readColumnarFile(path, table, error);
+        double readSeconds = benchSeconds(start);
+        benchKeep(table);
+
+        uint64_t bytes = 0;
+        for (uint64_t columnBytes : table.columnBytes) {
+            bytes += columnBytes;
+        }
+        std::printf("%-30s %6.1f bytes/row  write %6.1f M rows/s  read %6.1f M rows/s\n", test.name,
+                    double(bytes) / double(count), count / writeSeconds * 1e-6, count / readSeconds * 1e-6);
+    }
+    std::filesystem::remove(path);
+}
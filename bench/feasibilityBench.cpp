@@ -0,0 +1,86 @@
+#include "benchUtil.h"
+#include "../batchSolver.h"
+#include "../feasibility.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// checkFeasibility alone, and solveBatch with and without it, on rows built
+// from real triangles, where every other row has one input scaled off.
+
+namespace {
+
+std::vector<TriangleValues> makeFeasibilityInputs(int count)
+{
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<double> side(0.5, 50);
+    std::uniform_real_distribution<double> scale(0.2, 3);
+    std::vector<TriangleValues> inputs(count);
+    for (int i = 0; i < count; i++) {
+        TriangleValues truth;
+        do {
+            truth.AB = side(random);
+            truth.AC = side(random);
+            truth.BC = side(random);
+        } while (2 * std::max({truth.AB, truth.AC, truth.BC}) >= truth.AB + truth.AC + truth.BC);
+        solveTriangle(truth);
+
+        // Three distinct inputs out of the first 13 (sides, angles, medians, area,
+        // bisectors) that some solver branch accepts.
+        TriangleValues& v = inputs[i];
+        int fields[3];
+        do {
+            v = TriangleValues();
+            for (int k = 0; k < 3; k++) {
+                do {
+                    fields[k] = int(random() % 13);
+                } while (std::find(fields, fields + k, fields[k]) != fields + k);
+                fieldValue(v, fields[k]) = fieldValue(truth, fields[k]);
+            }
+        } while (checkFeasibility(v) & Reject_Underdetermined);
+        if (i % 2) {
+            fieldValue(v, fields[0]) *= scale(random);
+        }
+    }
+    return inputs;
+}
+
+}
+
+void benchFeasibility()
+{
+    const int count = 1000000;
+    std::vector<TriangleValues> inputs = makeFeasibilityInputs(count);
+    std::vector<TriangleValues> outputs(count);
+    std::vector<uint32_t> reasons(count);
+
+    auto start = std::chrono::steady_clock::now();
+    checkFeasibility(inputs.data(), count, reasons.data());
+    benchReport("checkFeasibility", benchSeconds(start), count, "rows");
+    benchKeep(reasons);
+
+    FeasibilityCounts counts;
+    for (uint32_t rowReasons : reasons) {
+        counts.add(rowReasons);
+    }
+
+    start = std::chrono::steady_clock::now();
+    solveBatch(inputs.data(), outputs.data(), count);
+    double plain = benchSeconds(start);
+    benchReport("solveBatch", plain, count, "rows");
+    benchKeep(outputs);
+
+    start = std::chrono::steady_clock::now();
+    std::size_t solved = solveBatch(inputs.data(), outputs.data(), count, reasons.data());
+    double filtered = benchSeconds(start);
+    benchReport("solveBatch, rejecting infeasible rows", filtered, count, "rows");
+    benchKeep(outputs);
+
+    std::printf("%zu of %d rows rejected (%.1f%%), solved %zu, %.2fx the unfiltered time\n",
+                counts.rejected, count, 100.0 * counts.rejected / count, solved, filtered / plain);
+    for (int bit = 0; bit < FeasibilityReasonCount; bit++) {
+        if (counts.byReason[bit]) {
+            std::printf("%36s %-22s %zu\n", "", feasibilityReasonName(bit), counts.byReason[bit]);
+        }
+    }
+}
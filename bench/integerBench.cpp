@@ -0,0 +1,69 @@
+#include "benchUtil.h"
+#include "../integerTriangles.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+// Heronian triangles up to a largest side: the kernel-matching enumerator
+// against solving every triple in floating point and testing the area for
+// an integer, which is also how far the naive search can be trusted.
+
+namespace {
+
+uint64_t enumerate(uint32_t maxSide, uint32_t required, IntegerEnumerationStats& stats)
+{
+    IntegerTriangleCriteria criteria;
+    criteria.maxSide = maxSide;
+    criteria.required = required;
+    uint64_t checksum = 0;
+    std::string error;
+    enumerateIntegerTriangles(
+        criteria,
+        [&](const IntegerTriangle* rows, std::size_t count) {
+            for (std::size_t i = 0; i < count; i++) {
+                checksum += rows[i].area + rows[i].a;
+            }
+        },
+        stats, error);
+    return checksum;
+}
+
+}
+
+void benchInteger()
+{
+    for (uint32_t maxSide : {500u, 2000u, 10000u, 20000u}) {
+        IntegerEnumerationStats stats;
+        benchKeep(enumerate(maxSide, Integer_Area, stats));
+        std::string name = "heronian, sides <= " + std::to_string(maxSide);
+        benchReport(name.c_str(), stats.seconds, double(stats.found), "triangles");
+    }
+
+    const uint32_t naiveSide = 500;
+    auto start = std::chrono::steady_clock::now();
+    uint64_t naiveFound = 0;
+    uint64_t triples = 0;
+    for (uint32_t c = 1; c <= naiveSide; c++) {
+        for (uint32_t a = 1; a <= c; a++) {
+            for (uint32_t b = std::max(a, c - a + 1); b <= c; b++) {
+                TriangleValues values;
+                values.BC = a;
+                values.AC = b;
+                values.AB = c;
+                solveTriangle(values);
+                naiveFound += std::fabs(values.Area - std::round(values.Area)) < 1e-9 * values.Area;
+                triples++;
+            }
+        }
+    }
+    double seconds = benchSeconds(start);
+    benchReport("floating point, every triple <= 500", seconds, double(triples), "triples");
+    IntegerEnumerationStats exact;
+    enumerate(naiveSide, Integer_Area, exact);
+    std::printf("  floating point finds %llu, exact %llu\n", (unsigned long long)naiveFound,
+                (unsigned long long)exact.found);
+
+    IntegerEnumerationStats medians;
+    benchKeep(enumerate(300, Integer_MedianA, medians));
+    benchReport("integer median A, every triple <= 300", medians.seconds, double(medians.candidates), "triples");
+}
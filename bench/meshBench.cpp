@@ -0,0 +1,38 @@
+#include "benchUtil.h"
+#include "../meshAnalysis.h"
+#include <cmath>
+
+// Synthetic height-field grid mesh, analyzed with and without per-face output.
+void benchMeshAnalysis()
+{
+    const uint32_t side = 1500; // ~4.5M faces
+    Mesh mesh;
+    mesh.vertices.reserve(std::size_t(side) * side * 3);
+    for (uint32_t y = 0; y < side; y++) {
+        for (uint32_t x = 0; x < side; x++) {
+            mesh.vertices.push_back(x);
+            mesh.vertices.push_back(y);
+            mesh.vertices.push_back(std::sin(x * 0.01) * std::cos(y * 0.013) * 5);
+        }
+    }
+    for (uint32_t y = 0; y + 1 < side; y++) {
+        for (uint32_t x = 0; x + 1 < side; x++) {
+            uint32_t a = y * side + x;
+            uint32_t faces[6] = {a, a + 1, a + side, a + 1, a + side + 1, a + side};
+            mesh.faces.insert(mesh.faces.end(), faces, faces + 6);
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    MeshReport report = analyzeMesh(mesh);
+    benchReport("analyzeMesh, histograms only", benchSeconds(start), double(report.faces), "faces");
+
+    MeshFaceMetrics metrics;
+    start = std::chrono::steady_clock::now();
+    report = analyzeMesh(mesh, MeshAnalysisOptions(), &metrics);
+    benchReport("analyzeMesh, per-face metrics", benchSeconds(start), double(report.faces), "faces");
+
+    start = std::chrono::steady_clock::now();
+    deduplicateVertices(mesh);
+    benchReport("deduplicateVertices", benchSeconds(start), double(mesh.vertexCount()), "vertices");
+}
@@ -0,0 +1,109 @@
+#include "benchUtil.h"
+#include "../batchSolver.h"
+#include "../derivationPlanner.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Rows know three random inputs of a true triangle, so most knownMasks have
+// no solveTriangle branch or a poorly conditioned one. Plan building, then
+// DerivationPlanner::solveBatch against solveBatch: throughput, and rows
+// within 1e-9 of the true triangle.
+
+namespace {
+
+// Every field of the triangle with sides b = AC and c = AB around angle A.
+TriangleValues trueTriangle(double b, double c, double angleA)
+{
+    TriangleValues t;
+    double radians = toRadians(angleA);
+    double a = std::sqrt(b * b + c * c - 2 * b * c * std::cos(radians));
+    t.AB = c;
+    t.AC = b;
+    t.BC = a;
+    t.angleA = angleA;
+    t.angleB = toDegrees(std::atan2(b * std::sin(radians), c - b * std::cos(radians)));
+    t.angleC = 180 - t.angleA - t.angleB;
+    t.median_AM = 0.5 * std::sqrt(2 * b * b + 2 * c * c - a * a);
+    t.median_BM = 0.5 * std::sqrt(2 * a * a + 2 * c * c - b * b);
+    t.median_CM = 0.5 * std::sqrt(2 * a * a + 2 * b * b - c * c);
+    t.Area = 0.5 * b * c * std::sin(radians);
+    t.BisectorA = 2 * b * c * std::cos(toRadians(t.angleA / 2)) / (b + c);
+    t.BisectorB = 2 * a * c * std::cos(toRadians(t.angleB / 2)) / (a + c);
+    t.BisectorC = 2 * a * b * std::cos(toRadians(t.angleC / 2)) / (a + b);
+    t.HeightAH = 2 * t.Area / a;
+    t.HeightBH = 2 * t.Area / b;
+    t.HeightCH = 2 * t.Area / c;
+    t.inRadius = 2 * t.Area / (a + b + c);
+    t.circumRadius = a * b * c / (4 * t.Area);
+    return t;
+}
+
+bool matches(const TriangleValues& solved, const TriangleValues& truth)
+{
+    for (int field = 0; field < FieldCount; field++) {
+        double expected = fieldValue(truth, field);
+        if (!(std::fabs(fieldValue(solved, field) - expected) <= 1e-9 * std::max(1.0, std::fabs(expected)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+void benchPlanner()
+{
+    const int count = 1000000;
+    std::mt19937_64 random(46);
+    std::uniform_real_distribution<double> side(1, 10);
+    std::uniform_real_distribution<double> angle(10, 150);
+    std::vector<TriangleValues> truth(count);
+    std::vector<TriangleValues> inputs(count);
+    for (int i = 0; i < count; i++) {
+        truth[i] = trueTriangle(side(random), side(random), angle(random));
+        uint32_t mask = 0;
+        while (__builtin_popcount(mask) < 3) {
+            mask |= 1u << (random() % InputFieldCount);
+        }
+        for (int field = 0; field < InputFieldCount; field++) {
+            if (mask & (1u << field)) {
+                fieldValue(inputs[i], field) = fieldValue(truth[i], field);
+            }
+        }
+    }
+
+    DerivationPlanner planner;
+    std::size_t reachable = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t mask = 0; mask < (1u << InputFieldCount); mask++) {
+        if (__builtin_popcount(mask) == 3) {
+            const DerivationPlan& plan = planner.plan(mask);
+            reachable += (plan.knownMask | plan.derivedMask) == (1u << FieldCount) - 1;
+        }
+    }
+    benchReport("plan every 3-input knownMask", benchSeconds(start), double(planner.cachedPlans()), "plans");
+
+    std::vector<TriangleValues> native(count);
+    start = std::chrono::steady_clock::now();
+    solveBatch(inputs.data(), native.data(), count);
+    benchReport("solveBatch (first matching branch)", benchSeconds(start), count, "rows");
+    benchKeep(native);
+
+    std::vector<TriangleValues> planned(count);
+    start = std::chrono::steady_clock::now();
+    planner.solveBatch(inputs.data(), planned.data(), count);
+    benchReport("DerivationPlanner::solveBatch", benchSeconds(start), count, "rows");
+    benchKeep(planned);
+
+    std::size_t nativeCorrect = 0;
+    std::size_t plannedCorrect = 0;
+    for (int i = 0; i < count; i++) {
+        nativeCorrect += matches(native[i], truth[i]);
+        plannedCorrect += matches(planned[i], truth[i]);
+    }
+    std::printf("%zu of %zu masks reach every field; rows matching the true triangle: "
+                "solveTriangle %.1f%%, planner %.1f%%\n",
+                reachable, planner.cachedPlans(), 100.0 * nativeCorrect / count, 100.0 * plannedCorrect / count);
+}
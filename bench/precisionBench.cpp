@@ -0,0 +1,107 @@
+#include "benchUtil.h"
+#include "../triangleCore.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Throughput of each solveTriangleT instantiation and its largest relative
+// error over all 18 outputs, measured against the widest type available.
+
+namespace {
+
+#ifdef TRIANGLE_HAVE_FLOAT128
+using Reference = __float128;
+const char* const ReferenceName = "__float128";
+#else
+using Reference = long double;
+const char* const ReferenceName = "long double";
+#endif
+
+std::vector<TriangleValuesT<Reference>> makeInputs(int count)
+{
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<double> side(0.5, 50);
+    std::uniform_real_distribution<double> angle(5, 80);
+    std::vector<TriangleValuesT<Reference>> inputs(count);
+    for (int i = 0; i < count; i++) {
+        TriangleValuesT<Reference>& v = inputs[i];
+        switch (i % 4) {
+        case 0: // SAS
+            v.AB = side(random);
+            v.BC = side(random);
+            v.angleB = angle(random);
+            break;
+        case 1: // ASA
+            v.angleA = angle(random);
+            v.angleB = angle(random);
+            v.AC = side(random);
+            break;
+        case 2: { // SSS
+            double a = side(random);
+            double b = side(random);
+            v.AB = a;
+            v.AC = b;
+            v.BC = std::fabs(a - b) + (a + b - std::fabs(a - b)) * std::uniform_real_distribution<double>(0.1, 0.9)(random);
+            break;
+        }
+        default: // two sides and a median
+            v.AB = side(random);
+            v.AC = side(random);
+            v.median_AM = 0.5 * std::sqrt(double(v.AB * v.AB + v.AC * v.AC));
+            break;
+        }
+    }
+    return inputs;
+}
+
+template <typename T>
+void runOne(const char* name, const std::vector<TriangleValuesT<Reference>>& inputs,
+            const std::vector<TriangleValuesT<Reference>>& reference)
+{
+    std::vector<TriangleValuesT<T>> work(inputs.size());
+    for (std::size_t i = 0; i < inputs.size(); i++) {
+        for (int field = 0; field < InputFieldCount; field++) {
+            fieldValue(work[i], field) = T(fieldValue(inputs[i], field));
+        }
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (TriangleValuesT<T>& v : work) {
+        solveTriangleT(v);
+    }
+    double seconds = benchSeconds(start);
+    benchKeep(work);
+
+    double maxError = 0;
+    for (std::size_t i = 0; i < work.size(); i++) {
+        for (int field = 0; field < FieldCount; field++) {
+            double expected = double(fieldValue(reference[i], field));
+            double actual = double(fieldValue(work[i], field));
+            if (!std::isfinite(expected) || expected == 0) {
+                continue;
+            }
+            maxError = std::max(maxError, std::fabs(actual - expected) / std::fabs(expected));
+        }
+    }
+    benchReport(name, seconds, double(work.size()), "solves");
+    std::printf("%-36s max relative error %.3g\n", "", maxError);
+}
+
+}
+
+void benchPrecision()
+{
+    const int count = 100000;
+    std::vector<TriangleValuesT<Reference>> inputs = makeInputs(count);
+    std::vector<TriangleValuesT<Reference>> reference = inputs;
+    for (TriangleValuesT<Reference>& v : reference) {
+        solveTriangleT(v);
+    }
+    std::printf("reference: %s\n", ReferenceName);
+    runOne<float>("float", inputs, reference);
+    runOne<double>("double", inputs, reference);
+    runOne<long double>("long double", inputs, reference);
+#ifdef TRIANGLE_HAVE_FLOAT128
+    runOne<__float128>("__float128", inputs, reference);
+#endif
+}
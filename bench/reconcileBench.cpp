@@ -0,0 +1,63 @@
+#include "benchUtil.h"
+#include "../reconcile.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Survey-style rows: three sides, two angles and the area, each with 0.1%
+// noise. reconcileBatch against the first-branch solve, as throughput and
+// as error against the true triangle.
+
+namespace {
+
+const int SurveyFields[] = {Field_AB, Field_AC, Field_BC, Field_angleA, Field_angleB, Field_Area};
+
+}
+
+void benchReconcile()
+{
+    const int count = 200000;
+    std::mt19937_64 random(43);
+    std::uniform_real_distribution<double> side(1, 50);
+    std::normal_distribution<double> noise(0, 0.001);
+    std::vector<TriangleValues> truth(count);
+    std::vector<TriangleValues> measured(count);
+    for (int i = 0; i < count; i++) {
+        TriangleValues& t = truth[i];
+        do {
+            t.AB = side(random);
+            t.AC = side(random);
+            t.BC = side(random);
+        } while (2 * std::max({t.AB, t.AC, t.BC}) >= t.AB + t.AC + t.BC);
+        solveTriangle(t);
+        for (int field : SurveyFields) {
+            fieldValue(measured[i], field) = fieldValue(t, field) * (1 + noise(random));
+        }
+    }
+
+    std::vector<TriangleValues> firstBranch(measured);
+    auto start = std::chrono::steady_clock::now();
+    for (TriangleValues& values : firstBranch) {
+        solveTriangle(values);
+    }
+    benchReport("solveTriangle (first branch only)", benchSeconds(start), count, "rows");
+
+    std::vector<ReconcileResult> results(count);
+    start = std::chrono::steady_clock::now();
+    std::size_t converged = reconcileBatch(measured.data(), count, nullptr, results.data());
+    double seconds = benchSeconds(start);
+    benchReport("reconcileBatch", seconds, count, "rows");
+
+    double iterations = 0;
+    double firstError = 0;
+    double fitError = 0;
+    for (int i = 0; i < count; i++) {
+        iterations += results[i].iterations;
+        firstError += std::fabs(firstBranch[i].Area / truth[i].Area - 1);
+        fitError += std::fabs(results[i].values.Area / truth[i].Area - 1);
+    }
+    std::printf("%zu of %d converged, %.2f iterations per row, %.1fM rows/min\n", converged, count, iterations / count,
+                count / seconds * 60 / 1e6);
+    std::printf("mean relative Area error: first branch %.2e, fit %.2e\n", firstError / count, fitError / count);
+}
@@ -0,0 +1,87 @@
+#include "benchUtil.h"
+#include "../batchSolver.h"
+#include "../ruleSet.h"
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+// rules/default.rules is solveTriangle written as rules. Rows take the knowns
+// of a random rule from a real triangle; RuleSet::solveBatch against the
+// compiled solveBatch on the same rows, plus what the compiler made of each rule.
+
+#ifndef TRIANGLE_RULES_DIR
+#define TRIANGLE_RULES_DIR "rules"
+#endif
+
+void benchRules()
+{
+    RuleSet rules;
+    std::string error;
+    auto start = std::chrono::steady_clock::now();
+    if (!rules.load(TRIANGLE_RULES_DIR "/default.rules", error)) {
+        std::printf("%s\n", error.c_str());
+        return;
+    }
+    benchReport("RuleSet::load (default.rules)", benchSeconds(start), double(rules.size()), "rules");
+
+    const int count = 1000000;
+    std::mt19937_64 random(45);
+    std::uniform_real_distribution<double> side(1, 10);
+    std::uniform_real_distribution<double> angle(20, 70);
+    std::vector<TriangleValues> inputs(count);
+    for (TriangleValues& row : inputs) {
+        TriangleValues full;
+        full.AB = side(random);
+        full.AC = side(random);
+        full.angleA = angle(random);
+        solveTriangle(full);
+        uint32_t mask = rules.info(random() % rules.size()).knownMask;
+        for (int field = 0; field < InputFieldCount; field++) {
+            if (mask & (1u << field)) {
+                fieldValue(row, field) = fieldValue(full, field);
+            }
+        }
+    }
+
+    std::vector<TriangleValues> native(count);
+    start = std::chrono::steady_clock::now();
+    solveBatch(inputs.data(), native.data(), count);
+    double nativeSeconds = benchSeconds(start);
+    benchReport("solveBatch (compiled branches)", nativeSeconds, count, "rows");
+    benchKeep(native);
+
+    std::vector<TriangleValues> outputs(count);
+    std::vector<int> used(count);
+    start = std::chrono::steady_clock::now();
+    rules.solveBatch(inputs.data(), outputs.data(), count, used.data());
+    double rulesSeconds = benchSeconds(start);
+    benchReport("RuleSet::solveBatch (bytecode)", rulesSeconds, count, "rows");
+    benchKeep(outputs);
+
+    // Only the fields the native branch derives are compared: the rules also
+    // fill in some that solveTriangle leaves unset, and keep inputs that
+    // some native branches recompute.
+    std::vector<std::size_t> rows(rules.size()), identical(rules.size());
+    for (int i = 0; i < count; i++) {
+        const TriangleBranch* branch = triangleBranch(knownMask(inputs[i]));
+        if (used[i] < 0 || !branch) {
+            continue;
+        }
+        bool same = true;
+        for (int field = 0; field < FieldCount; field++) {
+            if (branch->derives & (1u << field)) {
+                same &= std::memcmp(&fieldValue(native[i], field), &fieldValue(outputs[i], field), sizeof(double)) == 0;
+            }
+        }
+        rows[used[i]]++;
+        identical[used[i]] += same;
+    }
+    std::printf("bytecode / compiled time: %.2f\n", rulesSeconds / nativeSeconds);
+    std::printf("%-20s %8s %8s %6s %10s\n", "rule", "written", "instrs", "regs", "identical");
+    for (std::size_t rule = 0; rule < rules.size(); rule++) {
+        const RuleInfo& info = rules.info(rule);
+        std::printf("%-20s %8d %8d %6d %9.1f%%\n", info.name.c_str(), info.writtenOperations, info.instructions,
+                    info.registers, rows[rule] ? 100.0 * identical[rule] / rows[rule] : 0.0);
+    }
+}
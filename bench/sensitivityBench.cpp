@@ -0,0 +1,110 @@
+#include "benchUtil.h"
+#include "../sensitivity.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Plain solve vs. solveWithJacobian vs. central finite differences (two
+// extra solves per known input), plus how far the two Jacobians disagree.
+
+namespace {
+
+std::vector<TriangleValues> makeSensitivityInputs(int count)
+{
+    std::mt19937_64 random(37);
+    std::uniform_real_distribution<double> side(0.5, 50);
+    std::uniform_real_distribution<double> angle(5, 80);
+    std::vector<TriangleValues> inputs(count);
+    for (int i = 0; i < count; i++) {
+        TriangleValues& v = inputs[i];
+        if (i % 2 == 0) { // SAS
+            v.AB = side(random);
+            v.BC = side(random);
+            v.angleB = angle(random);
+        } else { // ASA
+            v.angleA = angle(random);
+            v.angleB = angle(random);
+            v.AC = side(random);
+        }
+    }
+    return inputs;
+}
+
+void finiteDifferences(const TriangleValues& input, TriangleValues& values, TriangleJacobian& jacobian)
+{
+    values = input;
+    solveTriangle(values);
+    jacobian.knownMask = knownMask(input);
+    for (int field = 0, column = 0; field < InputFieldCount; field++) {
+        if (!(jacobian.knownMask & (1u << field))) {
+            continue;
+        }
+        double h = 1e-6 * std::max(1.0, fieldValue(input, field));
+        TriangleValues up = input;
+        TriangleValues down = input;
+        fieldValue(up, field) += h;
+        fieldValue(down, field) -= h;
+        solveTriangle(up);
+        solveTriangle(down);
+        for (int output = 0; output < FieldCount; output++) {
+            jacobian.d[column][output] = (fieldValue(up, output) - fieldValue(down, output)) / (2 * h);
+        }
+        column++;
+    }
+}
+
+}
+
+void benchSensitivity()
+{
+    const int count = 200000;
+    std::vector<TriangleValues> inputs = makeSensitivityInputs(count);
+    std::vector<TriangleValues> values(count);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++) {
+        values[i] = inputs[i];
+        solveTriangle(values[i]);
+    }
+    double plain = benchSeconds(start);
+    benchReport("solveTriangle", plain, count, "rows");
+    benchKeep(values);
+
+    // One Jacobian is reused, as a caller that consumes each row's would;
+    // an array of them would mostly time the stores.
+    TriangleJacobian dual;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++) {
+        values[i] = inputs[i];
+        solveWithJacobian(values[i], dual);
+        benchKeep(dual);
+    }
+    double ad = benchSeconds(start);
+    benchReport("solveWithJacobian", ad, count, "rows");
+
+    TriangleJacobian differences;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++) {
+        finiteDifferences(inputs[i], values[i], differences);
+        benchKeep(differences);
+    }
+    double fd = benchSeconds(start);
+    benchReport("central finite differences", fd, count, "rows");
+
+    double worst = 0;
+    for (int i = 0; i < count; i++) {
+        TriangleValues solved = inputs[i];
+        solveWithJacobian(solved, dual);
+        finiteDifferences(inputs[i], solved, differences);
+        for (int output = 0; output < FieldCount; output++) {
+            for (int input = 0; input < InputFieldCount; input++) {
+                double a = dual(output, input);
+                double b = differences(output, input);
+                worst = std::max(worst, std::fabs(a - b) / std::max(1.0, std::fabs(a)));
+            }
+        }
+    }
+    std::printf("jacobian cost %.1fx a plain solve (finite differences %.1fx), largest AD/FD gap %.2e\n",
+                ad / plain, fd / plain, worst);
+}
@@ -0,0 +1,100 @@
+#include "benchUtil.h"
+#include "../shmSolver.h"
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+// Round-trip latency of one triangle: a direct solveTriangle call against a
+// ShmSolverServer on another thread, waking by futex and by busy polling,
+// plus the throughput of a full ring submitted at once. On a machine with
+// a single core the shared-memory numbers are scheduler latency.
+
+namespace {
+
+TriangleValues sampleTriangle(int i)
+{
+    TriangleValues values;
+    values.AB = 3 + (i & 7);
+    values.AC = 4 + (i & 3);
+    values.angleA = 40 + (i & 15);
+    return values;
+}
+
+void reportLatency(const char* name, std::vector<double>& nanoseconds)
+{
+    std::sort(nanoseconds.begin(), nanoseconds.end());
+    std::printf("%-36s p50 %9.0f ns  p99 %9.0f ns\n", name, nanoseconds[nanoseconds.size() / 2],
+                nanoseconds[nanoseconds.size() * 99 / 100]);
+}
+
+template <typename Solve>
+void measure(const char* name, int rounds, Solve solve)
+{
+    std::vector<double> nanoseconds(rounds);
+    for (int i = 0; i < rounds; i++) {
+        TriangleValues values = sampleTriangle(i);
+        auto start = std::chrono::steady_clock::now();
+        solve(values);
+        nanoseconds[i] = benchSeconds(start) * 1e9;
+        benchKeep(values);
+    }
+    reportLatency(name, nanoseconds);
+}
+
+}
+
+void benchShm()
+{
+    const int rounds = 20000;
+    const unsigned ringRecords = 1024;
+    const std::string name = "/trianglebench." + std::to_string(getpid());
+
+    measure("solveTriangle (in process)", rounds, [](TriangleValues& values) { solveTriangle(values); });
+
+    for (bool sleep : {true, false}) {
+        ShmWaitOptions options;
+        options.sleep = sleep;
+        ShmSolverServer server;
+        std::string error;
+        if (!server.create(name, 1, ringRecords, error)) {
+            std::printf("shm: %s\n", error.c_str());
+            return;
+        }
+        std::atomic<bool> stop{false};
+        std::thread serving([&] { server.serve(stop, options); });
+        ShmSolverClient client;
+        if (!client.attach(name, error)) {
+            std::printf("shm: %s\n", error.c_str());
+            stop = true;
+            serving.join();
+            return;
+        }
+
+        measure(sleep ? "shm round trip (futex)" : "shm round trip (busy poll)", rounds,
+                [&](TriangleValues& values) { client.solve(values, options); });
+
+        const int batches = 200;
+        auto start = std::chrono::steady_clock::now();
+        for (int batch = 0; batch < batches; batch++) {
+            for (unsigned i = 0; i < ringRecords; i++) {
+                ShmRecord* record = client.request();
+                record->tag = i;
+                record->values = sampleTriangle(int(i));
+                client.submit();
+            }
+            while (client.outstanding()) {
+                benchKeep(*client.response(options));
+                client.release();
+            }
+        }
+        benchReport(sleep ? "shm full rings (futex)" : "shm full rings (busy poll)", benchSeconds(start),
+                    double(batches) * ringRecords, "rows");
+
+        client.detach();
+        stop = true;
+        // serve() sleeps at most one futex timeout before it sees stop.
+        serving.join();
+    }
+}
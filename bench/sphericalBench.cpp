@@ -0,0 +1,73 @@
+#include "benchUtil.h"
+#include "../sphericalTriangle.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Route legs on the Earth: two legs and the turn between them (SAS), the
+// same leg pair closed by its third side (SSS), and fixes from two bearings
+// (ASA), mixed in one batch. solveSphericalBatch against one call per row.
+
+namespace {
+
+std::vector<TriangleValues> makeRouteLegs(int count)
+{
+    std::mt19937_64 random(44);
+    std::uniform_real_distribution<double> leg(0.5, 4000);
+    std::uniform_real_distribution<double> angle(5, 175);
+    SphericalOptions earth;
+    earth.radius = EarthRadiusKm;
+    std::vector<TriangleValues> rows(count);
+    for (int i = 0; i < count; i++) {
+        TriangleValues& v = rows[i];
+        v.AB = leg(random);
+        v.AC = leg(random);
+        v.angleA = angle(random);
+        if (i % 3 == 1) {
+            solveSphericalTriangle(v, earth);
+            v.angleA = v.angleB = v.angleC = 0;
+        } else if (i % 3 == 2) {
+            solveSphericalTriangle(v, earth);
+            v.AB = v.AC = 0;
+            v.angleA = 0;
+        }
+        std::fill_n(&v.median_AM, FieldCount - Field_median_AM, 0.0);
+    }
+    return rows;
+}
+
+}
+
+void benchSpherical()
+{
+    const int count = 1000000;
+    std::vector<TriangleValues> inputs = makeRouteLegs(count);
+    std::vector<TriangleValues> outputs(count);
+    std::vector<uint32_t> masks(count);
+    SphericalOptions earth;
+    earth.radius = EarthRadiusKm;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++) {
+        outputs[i] = inputs[i];
+        masks[i] = solveSphericalTriangle(outputs[i], earth);
+    }
+    benchReport("solveSphericalTriangle per row", benchSeconds(start), count, "rows");
+    benchKeep(outputs);
+
+    start = std::chrono::steady_clock::now();
+    std::size_t solved = solveSphericalBatch(inputs.data(), outputs.data(), count, earth, masks.data());
+    double seconds = benchSeconds(start);
+    benchReport("solveSphericalBatch", seconds, count, "rows");
+    benchKeep(outputs);
+
+    std::vector<TriangleValues> planar(inputs);
+    start = std::chrono::steady_clock::now();
+    for (TriangleValues& values : planar) {
+        solveTriangle(values);
+    }
+    benchReport("solveTriangle (planar, same rows)", benchSeconds(start), count, "rows");
+    benchKeep(planar);
+
+    std::printf("%zu of %d solved, %.0fM route legs per minute\n", solved, count, count / seconds * 60 / 1e6);
+}
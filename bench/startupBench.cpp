@@ -0,0 +1,58 @@
+#include "benchUtil.h"
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#endif
+
+// Cold-ish start of a one-shot CLI solve: spawns the trianglesolver binary
+// (path from TRIANGLESOLVER_CLI, default ../cli/trianglesolver) repeatedly
+// and reports the median and worst wall time per run. The budget is 5 ms.
+void benchStartup()
+{
+#ifdef _WIN32
+    std::printf("startup benchmark needs posix_spawn\n");
+#else
+    const char* path = std::getenv("TRIANGLESOLVER_CLI");
+    if (!path) {
+        path = "../cli/trianglesolver";
+    }
+    char* const argv[] = {const_cast<char*>(path), const_cast<char*>("--AB"), const_cast<char*>("3"),
+                          const_cast<char*>("--AC"), const_cast<char*>("4"), const_cast<char*>("--angleA"),
+                          const_cast<char*>("90"), const_cast<char*>("--json"), nullptr};
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, 1, "/dev/null", O_WRONLY, 0);
+
+    const int runs = 200;
+    std::vector<double> times;
+    for (int run = 0; run < runs; run++) {
+        auto start = std::chrono::steady_clock::now();
+        pid_t pid;
+        if (posix_spawn(&pid, path, &actions, nullptr, argv, nullptr) != 0) {
+            std::printf("cannot run %s (set TRIANGLESOLVER_CLI)\n", path);
+            posix_spawn_file_actions_destroy(&actions);
+            return;
+        }
+        int status = 0;
+        waitpid(pid, &status, 0);
+        times.push_back(benchSeconds(start));
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            std::printf("%s failed\n", path);
+            break;
+        }
+    }
+    posix_spawn_file_actions_destroy(&actions);
+    if (times.empty()) {
+        return;
+    }
+    std::sort(times.begin(), times.end());
+    double median = times[times.size() / 2];
+    benchReport("trianglesolver one-shot, median", median, 1, "runs");
+    std::printf("%36s worst %.3f ms over %zu runs%s\n", "", times.back() * 1e3, times.size(),
+                median > 0.005 ? "  ** over the 5 ms budget **" : "");
+#endif
+}
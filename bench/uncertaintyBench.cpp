@@ -0,0 +1,34 @@
+#include "benchUtil.h"
+#include "../uncertainty.h"
+
+// 10^6 Monte Carlo samples for one SSS triangle (batched kernel path) and
+// one SAS triangle (row solver path).
+void benchUncertainty()
+{
+    MonteCarloOptions options;
+
+    TriangleValues sss;
+    sss.AB = 3;
+    sss.AC = 4;
+    sss.BC = 5;
+    InputDistribution sides[InputFieldCount];
+    for (int field : {Field_AB, Field_AC, Field_BC}) {
+        sides[field].kind = InputDistribution::Normal;
+        sides[field].spread = 0.0005;
+    }
+    MonteCarloResult result = propagateUncertainty(sss, sides, options);
+    benchReport("propagateUncertainty, SSS", result.seconds, double(result.samples), "samples");
+    std::printf("%36s Area %.6f +- %.6f\n", "", result.outputs[Field_Area].mean, result.outputs[Field_Area].stddev);
+
+    TriangleValues sas;
+    sas.AB = 3;
+    sas.BC = 4;
+    sas.angleB = 70;
+    InputDistribution tolerances[InputFieldCount];
+    tolerances[Field_AB] = {InputDistribution::Uniform, 0.0005};
+    tolerances[Field_BC] = {InputDistribution::Uniform, 0.0005};
+    tolerances[Field_angleB] = {InputDistribution::Normal, 0.1};
+    result = propagateUncertainty(sas, tolerances, options);
+    benchReport("propagateUncertainty, SAS", result.seconds, double(result.samples), "samples");
+    std::printf("%36s Area %.6f +- %.6f\n", "", result.outputs[Field_Area].mean, result.outputs[Field_Area].stddev);
+}
@@ -0,0 +1,23 @@
+# libtrianglesolver: C ABI over the solver core for FFI consumers; no Qt.
+QT -= core gui
+
+TEMPLATE = lib
+CONFIG += c++17 shared hide_symbols thread
+TARGET = trianglesolver
+# Keep the major version in step with TS_ABI_VERSION_MAJOR (it sets the SONAME).
+VERSION = 1.1.0
+
+DEFINES += TRIANGLESOLVER_C_BUILD
+INCLUDEPATH += ..
+
+SOURCES += \
+    triangleSolverC.cpp \
+    ../sphericalTriangle.cpp \
+    ../triangleCore.cpp
+
+HEADERS += \
+    triangleSolverC.h \
+    ../angleTables.h \
+    ../sphericalTriangle.h \
+    ../triangleCore.h \
+    ../triangleCoreT.h
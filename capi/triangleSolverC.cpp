@@ -0,0 +1,181 @@
+#include "triangleSolverC.h"
+#include "../sphericalTriangle.h"
+#include "../triangleCore.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+static_assert(int(TS_FIELD_COUNT) == int(FieldCount) && int(TS_INPUT_COUNT) == InputFieldCount,
+              "C ABI column order must match TriangleField");
+
+namespace {
+
+const std::size_t BlockRows = 256;
+
+// ts_batch as 1.0 laid it out, the smallest struct_size any caller passes.
+// A field appended later is read only when the caller's struct_size covers
+// it; otherwise it takes its 1.0 behaviour.
+const std::size_t BatchSize_1_0 = offsetof(ts_batch, threads) + sizeof(unsigned);
+
+// The known inputs the solver left as given, plus the finite fields its
+// branch derives; 0 when no branch applies, since nothing was solved.
+uint32_t solvedMask(const TriangleValues& input, const TriangleValues& solved)
+{
+    uint32_t known = knownMask(input);
+    const TriangleBranch* branch = triangleBranch(known);
+    if (!branch) {
+        return 0;
+    }
+    uint32_t mask = 0;
+    for (int field = 0; field < FieldCount; field++) {
+        double value = fieldValue(solved, field);
+        if ((known & (1u << field)) ? value == fieldValue(input, field)
+                                    : (branch->derives & (1u << field)) && std::isfinite(value)) {
+            mask |= 1u << field;
+        }
+    }
+    return mask;
+}
+
+// sphereRadius > 0 solves spherical triangles instead.
+void solveRows(const ts_batch& batch, std::size_t begin, std::size_t end, double sphereRadius)
+{
+    TriangleValues inputs[BlockRows];
+    TriangleValues block[BlockRows];
+    uint32_t masks[BlockRows];
+    for (std::size_t first = begin; first < end; first += BlockRows) {
+        std::size_t count = std::min(BlockRows, end - first);
+        for (std::size_t i = 0; i < count; i++) {
+            std::size_t row = first + i;
+            uint32_t known = batch.known_mask ? batch.known_mask[row] : TS_KNOWN_INFER;
+            inputs[i] = TriangleValues();
+            for (int field = 0; field < InputFieldCount; field++) {
+                if (batch.inputs[field] && (known & (1u << field))) {
+                    fieldValue(inputs[i], field) = batch.inputs[field][row];
+                }
+            }
+        }
+        if (sphereRadius > 0) {
+            SphericalOptions options;
+            options.radius = sphereRadius;
+            solveSphericalBatch(inputs, block, count, options, masks);
+        } else {
+            for (std::size_t i = 0; i < count; i++) {
+                block[i] = inputs[i];
+                solveTriangle(block[i]);
+                masks[i] = solvedMask(inputs[i], block[i]);
+            }
+        }
+        for (int field = 0; field < FieldCount; field++) {
+            if (double* column = batch.outputs[field]) {
+                for (std::size_t i = 0; i < count; i++) {
+                    column[first + i] = fieldValue(block[i], field);
+                }
+            }
+        }
+        if (batch.output_mask) {
+            for (std::size_t i = 0; i < count; i++) {
+                batch.output_mask[first + i] = masks[i];
+            }
+        }
+    }
+}
+
+ts_status solveBatchRows(const ts_batch* batch, double sphereRadius)
+{
+    if (!batch) {
+        return TS_ERROR_NULL_ARGUMENT;
+    }
+    if (batch->struct_size < BatchSize_1_0) {
+        return TS_ERROR_STRUCT_SIZE;
+    }
+    unsigned threads = std::max(1u, batch->threads);
+    std::size_t rows = batch->rows;
+    if (threads == 1 || rows < BlockRows * 2) {
+        solveRows(*batch, 0, rows, sphereRadius);
+        return TS_OK;
+    }
+    threads = unsigned(std::min<std::size_t>(threads, rows / BlockRows));
+    std::size_t perThread = (rows + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++) {
+        std::size_t begin = std::min(rows, t * perThread);
+        std::size_t end = std::min(rows, begin + perThread);
+        workers.emplace_back(solveRows, std::cref(*batch), begin, end, sphereRadius);
+    }
+    solveRows(*batch, 0, std::min(rows, perThread), sphereRadius);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    return TS_OK;
+}
+
+}
+
+uint32_t ts_abi_version(void)
+{
+    return TS_ABI_VERSION;
+}
+
+ts_status ts_solve_one(double* values, uint32_t known_mask, uint32_t* out_mask)
+{
+    if (!values) {
+        return TS_ERROR_NULL_ARGUMENT;
+    }
+    TriangleValues row;
+    for (int field = 0; field < InputFieldCount; field++) {
+        if (known_mask & (1u << field)) {
+            fieldValue(row, field) = values[field];
+        }
+    }
+    TriangleValues input = row;
+    solveTriangle(row);
+    for (int field = 0; field < FieldCount; field++) {
+        values[field] = fieldValue(row, field);
+    }
+    if (out_mask) {
+        *out_mask = solvedMask(input, row);
+    }
+    return TS_OK;
+}
+
+ts_status ts_solve_batch(const ts_batch* batch)
+{
+    return solveBatchRows(batch, 0);
+}
+
+ts_status ts_solve_spherical_one(double* values, uint32_t known_mask, double radius, uint32_t* out_mask)
+{
+    if (!values) {
+        return TS_ERROR_NULL_ARGUMENT;
+    }
+    if (!(radius > 0) || !std::isfinite(radius)) {
+        return TS_ERROR_INVALID_ARGUMENT;
+    }
+    TriangleValues row;
+    for (int field = 0; field < InputFieldCount; field++) {
+        if (known_mask & (1u << field)) {
+            fieldValue(row, field) = values[field];
+        }
+    }
+    SphericalOptions options;
+    options.radius = radius;
+    uint32_t mask = solveSphericalTriangle(row, options);
+    for (int field = 0; field < FieldCount; field++) {
+        values[field] = fieldValue(row, field);
+    }
+    if (out_mask) {
+        *out_mask = mask;
+    }
+    return TS_OK;
+}
+
+ts_status ts_solve_spherical_batch(const ts_batch* batch, double radius)
+{
+    if (!(radius > 0) || !std::isfinite(radius)) {
+        return batch ? TS_ERROR_INVALID_ARGUMENT : TS_ERROR_NULL_ARGUMENT;
+    }
+    return solveBatchRows(batch, radius);
+}
@@ -0,0 +1,106 @@
+#ifndef TRIANGLESOLVERC_H
+#define TRIANGLESOLVERC_H
+
+/*
+ * C ABI for the triangle solver, for FFI consumers (ctypes/cffi, Rust, cgo).
+ *
+ * Versioning: TS_ABI_VERSION_MAJOR changes only when an existing function or
+ * struct layout changes incompatibly; minor bumps only add. Check
+ * ts_abi_version() at load time. ts_batch starts with struct_size so later
+ * minor versions can append fields without breaking older callers: the
+ * library accepts any struct_size from the 1.0 layout up and reads an
+ * appended field only when struct_size covers it.
+ *
+ * Thread safety: the library has no global mutable state. Any function may be
+ * called from any number of threads at once as long as the output buffers of
+ * concurrent calls do not overlap. Input buffers are only read.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  if defined(TRIANGLESOLVER_C_BUILD)
+#    define TS_API __declspec(dllexport)
+#  else
+#    define TS_API __declspec(dllimport)
+#  endif
+#else
+#  define TS_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TS_ABI_VERSION_MAJOR 1
+#define TS_ABI_VERSION_MINOR 1
+#define TS_ABI_VERSION ((TS_ABI_VERSION_MAJOR << 16) | TS_ABI_VERSION_MINOR)
+
+/* Column order; the first TS_INPUT_COUNT are the possible inputs. */
+enum {
+    TS_AB, TS_AC, TS_BC,
+    TS_ANGLE_A, TS_ANGLE_B, TS_ANGLE_C,
+    TS_MEDIAN_AM, TS_MEDIAN_BM, TS_MEDIAN_CM,
+    TS_AREA,
+    TS_BISECTOR_A, TS_BISECTOR_B, TS_BISECTOR_C,
+    TS_HEIGHT_AH, TS_HEIGHT_BH, TS_HEIGHT_CH,
+    TS_IN_RADIUS, TS_CIRCUM_RADIUS,
+    TS_FIELD_COUNT,
+    TS_INPUT_COUNT = TS_IN_RADIUS
+};
+
+/* known_mask value meaning "treat every input > 0 as known", like the window does. */
+#define TS_KNOWN_INFER 0xFFFFFFFFu
+
+typedef enum ts_status {
+    TS_OK = 0,
+    TS_ERROR_NULL_ARGUMENT = -1,
+    TS_ERROR_STRUCT_SIZE = -2,
+    TS_ERROR_INVALID_ARGUMENT = -3      /* since 1.1 */
+} ts_status;
+
+/* TS_ABI_VERSION of the loaded library. */
+TS_API uint32_t ts_abi_version(void);
+
+/*
+ * Solves one triangle in place. values holds TS_FIELD_COUNT doubles; inputs
+ * whose bit is not set in known_mask are ignored. On return bit i of
+ * *out_mask (if not NULL) is set when values[i] is a known input the solver
+ * kept, or a finite value the solver derived from the inputs. Fields it
+ * never set keep their bit clear even though they read 0; 0 means the known
+ * inputs matched no solver case.
+ */
+TS_API ts_status ts_solve_one(double* values, uint32_t known_mask, uint32_t* out_mask);
+
+/*
+ * Structure-of-arrays batch over caller-owned columns of `rows` contiguous
+ * doubles, e.g. numpy arrays or Arrow buffers, used without copying.
+ */
+typedef struct ts_batch {
+    size_t struct_size;                     /* sizeof(ts_batch) as the caller was compiled */
+    size_t rows;
+    const double* inputs[TS_INPUT_COUNT];   /* NULL column = unknown for every row */
+    double* outputs[TS_FIELD_COUNT];        /* NULL column = not wanted */
+    const uint32_t* known_mask;             /* per row; NULL = TS_KNOWN_INFER for all rows */
+    uint32_t* output_mask;                  /* per row, as ts_solve_one's out_mask; NULL = not wanted */
+    unsigned threads;                       /* worker threads; 0 or 1 = calling thread only */
+} ts_batch;
+
+TS_API ts_status ts_solve_batch(const ts_batch* batch);
+
+/*
+ * Since 1.1: the same two calls for spherical triangles on a sphere of the
+ * given radius (> 0, else TS_ERROR_INVALID_ARGUMENT). Sides, heights and the
+ * radii are arcs in the unit of the radius, TS_AREA is the excess times
+ * radius^2. Only the sides and angles are used as inputs; the medians and
+ * bisectors are never set, so their out_mask bits stay clear.
+ */
+TS_API ts_status ts_solve_spherical_one(double* values, uint32_t known_mask, double radius, uint32_t* out_mask);
+TS_API ts_status ts_solve_spherical_batch(const ts_batch* batch, double radius);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRIANGLESOLVERC_H */
@@ -0,0 +1,68 @@
+# trianglesolver: command-line front end over the solver core. No Qt modules,
+# so a one-shot solve never pays for QtWidgets or the resource file.
+QT -= core gui
+
+CONFIG += c++17 console thread
+CONFIG -= app_bundle
+
+TARGET = trianglesolver
+
+INCLUDEPATH += ..
+
+# shm_open lives in librt on older glibc
+linux: LIBS += -lrt
+
+SOURCES += \
+    cliMain.cpp \
+    ../allocationTracker.cpp \
+    ../batchKernels.cpp \
+    ../batchPipeline.cpp \
+    ../batchSolver.cpp \
+    ../columnarWriter.cpp \
+    ../derivationPlanner.cpp \
+    ../feasibility.cpp \
+    ../integerTriangles.cpp \
+    ../meshAnalysis.cpp \
+    ../persistentCache.cpp \
+    ../reconcile.cpp \
+    ../ruleSet.cpp \
+    ../sensitivity.cpp \
+    ../shapeCache.cpp \
+    ../shmSolver.cpp \
+    ../solveArena.cpp \
+    ../sphericalTriangle.cpp \
+    ../sweep.cpp \
+    ../triangleCore.cpp \
+    ../uncertainty.cpp \
+    ../vertexInput.cpp
+
+HEADERS += \
+    ../allocationTracker.h \
+    ../angleTables.h \
+    ../batchKernels.h \
+    ../batchPipeline.h \
+    ../batchSolver.h \
+    ../columnarWriter.h \
+    ../derivationPlanner.h \
+    ../dualNumber.h \
+    ../feasibility.h \
+    ../integerTriangles.h \
+    ../meshAnalysis.h \
+    ../persistentCache.h \
+    ../philox.h \
+    ../reconcile.h \
+    ../ringBuffer.h \
+    ../ruleSet.h \
+    ../sensitivity.h \
+    ../shapeCache.h \
+    ../shmSolver.h \
+    ../solveArena.h \
+    ../sphericalTriangle.h \
+    ../sweep.h \
+    ../triangleCore.h \
+    ../triangleCoreT.h \
+    ../uncertainty.h \
+    ../vertexInput.h
+
+DISTFILES += \
+    ../rules/default.rules
@@ -0,0 +1,851 @@
+#include "../batchPipeline.h"
+#include "../batchSolver.h"
+#include "../derivationPlanner.h"
+#include "../feasibility.h"
+#include "../integerTriangles.h"
+#include "../meshAnalysis.h"
+#include "../persistentCache.h"
+#include "../reconcile.h"
+#include "../ruleSet.h"
+#include "../sensitivity.h"
+#include "../shmSolver.h"
+#include "../sphericalTriangle.h"
+#include "../sweep.h"
+#include "../triangleCore.h"
+#include "../uncertainty.h"
+#include "../vertexInput.h"
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+// trianglesolver: the solver without the window. Links no Qt at all, so a
+// one-shot solve costs process startup and a single solveTriangle call.
+//
+//   trianglesolver --AB 3 --AC 4 --angleA 90 [--json] [--jacobian]
+//   trianglesolver --AB 3 --AC 4 --BC 5 --angleA 90.2 --Area 6.1 --fit [--json]
+//   trianglesolver --AB 1000 --AC 2000 --angleA 60 --sphere 6371.0088 [--json]
+//   trianglesolver --AB 3 --AC 4 --angleA 90 --rules rules/default.rules [--json]
+//   trianglesolver --median_AM 2.5 --median_BM 3.6 --median_CM 4.27 --plan [--json]
+//   trianglesolver --AB 3 --AC 4 --BC 5 --tolerance AB=normal:0.0005 --tolerance angleA=uniform:0.1 [--samples N]
+//   trianglesolver --batch [--threads N] [--cache FILE [--cache-size MB]] [--reject-infeasible] < in.csv > out.csv
+//   trianglesolver --batch --fit [--threads N] < in.csv > out.csv
+//   trianglesolver --batch --sphere RADIUS [--threads N] < in.csv > out.csv
+//   trianglesolver --batch --rules FILE [--threads N] [--reject-infeasible] < in.csv > out.csv
+//   trianglesolver --batch --plan [--threads N] < in.csv > out.csv
+//   trianglesolver --points < triangles.tspt > out.csv
+//   trianglesolver --mesh FILE [--faces FILE]
+//   trianglesolver --sweep AB=1:100:0.5 --sweep angleB=1:179:1 --out FILE [--shard K/N] [--resume]
+//                  [--encode HeightBH=fixed:1e-6@HeightAH ...]
+//   trianglesolver --recode IN --out FILE --encode '*=float32' --encode AB=delta:1e-9
+//   trianglesolver --serve /trianglesolver [--channels N]
+//   trianglesolver --enumerate 1000 [--require area,integerMedian] [--any LIST] [--threads N] > out.csv
+//   trianglesolver --compact-cache FILE [--cache-size MB]
+
+namespace {
+
+const char* const Usage =
+    "usage: trianglesolver --<input> VALUE ... [--json] [--jacobian | --fit | --sphere RADIUS | --rules FILE | --plan]\n"
+    "       trianglesolver --<input> VALUE ... --tolerance INPUT=normal:SD|uniform:HALFWIDTH ... [--samples N]\n"
+    "                      [--threads N]                          (Monte Carlo summary of every output, as CSV)\n"
+    "       trianglesolver --batch [--threads N] [--cache FILE [--cache-size MB]] [--reject-infeasible]\n"
+    "                                                             (CSV on stdin, 18 values per line on stdout)\n"
+    "       trianglesolver --batch --fit [--threads N]            (least-squares fit; 18 values and rms per line)\n"
+    "       trianglesolver --batch --sphere RADIUS [--threads N]  (spherical triangles, sides as arcs)\n"
+    "       trianglesolver --batch --rules FILE [--threads N] [--reject-infeasible]  (formulas from a rule file)\n"
+    "       trianglesolver --batch --plan [--threads N]           (cheapest derivation per input set)\n"
+    "       trianglesolver --points                               (TSPT point stream on stdin)\n"
+    "       trianglesolver --mesh FILE [--faces FILE]\n"
+    "       trianglesolver --sweep FIELD=FROM:TO:STEP ... --out FILE [--shard K/N] [--resume] [--threads N]\n"
+    "                      [--encode COLUMN=ENCODING ...]\n"
+    "       trianglesolver --recode IN --out FILE --encode COLUMN=ENCODING ...  (prints size and error per column)\n"
+    "       trianglesolver --serve NAME [--channels N]            (shared-memory solver for local clients)\n"
+    "       trianglesolver --enumerate MAXSIDE [--require LIST] [--any LIST] [--threads N]\n"
+    "                      (integer-sided triangles; a,b,c,area,properties and 18 values per line)\n"
+    "       trianglesolver --compact-cache FILE [--cache-size MB]  (resize a --cache file, keeping the newest rows)\n"
+    "inputs: AB AC BC angleA angleB angleC median_AM median_BM median_CM Area\n"
+    "        BisectorA BisectorB BisectorC HeightAH HeightBH HeightCH\n"
+    "encodings: float64 float32 float16 fixed:MAXERROR delta:MAXERROR, fixed and delta optionally @COLUMN;\n"
+    "           COLUMN * sets every column\n"
+    "properties: area primitive rationalMedian integerMedian rationalBisector integerBisector integerHeight,\n"
+    "            the last five with an optional vertex A, B or C; --require defaults to area\n";
+
+enum class Mode { Solve, Uncertainty, Batch, Points, Mesh, Sweep, Recode, Serve, Enumerate, CompactCache };
+
+struct Arguments {
+    Mode mode = Mode::Solve;
+    TriangleValues values;
+    bool json = false;
+    bool jacobian = false;
+    bool fit = false;
+    double sphereRadius = 0; // > 0: spherical triangles on this radius
+    std::string rulesPath;   // solve with the rules in this file instead of solveTriangle
+    bool plan = false;       // solve with DerivationPlanner; one-shot prints the plan to stderr
+    InputDistribution tolerances[InputFieldCount];
+    unsigned samples = 1000000;
+    unsigned threads = 0;
+    std::string cachePath;
+    unsigned cacheMegabytes = 0; // 0 = 256; the size --cache creates a file with, or --compact-cache rewrites it to
+    bool rejectInfeasible = false;
+    std::string meshPath;
+    std::string facesPath;
+    std::string outPath;
+    std::vector<SweepAxis> axes;
+    unsigned shardIndex = 0;
+    unsigned shardCount = 1;
+    bool resume = false;
+    std::vector<std::string> encodings; // parseColumnarFormat specs for --sweep and --recode
+    std::string recodePath;
+    std::string serveName; // POSIX shared memory name, "/name"
+    unsigned channels = 8;
+    IntegerTriangleCriteria integerCriteria;
+};
+
+bool parseDouble(const char* text, double& value)
+{
+    const char* end = text + std::strlen(text);
+    auto [ptr, ec] = std::from_chars(text, end, value);
+    return ec == std::errc() && ptr == end;
+}
+
+bool parseUnsigned(const char* text, unsigned& value)
+{
+    const char* end = text + std::strlen(text);
+    auto [ptr, ec] = std::from_chars(text, end, value);
+    return ec == std::errc() && ptr == end;
+}
+
+int inputField(const char* name)
+{
+    for (int field = 0; field < InputFieldCount; field++) {
+        if (std::strcmp(name, kTriangleFieldNames[field]) == 0) {
+            return field;
+        }
+    }
+    return -1;
+}
+
+bool fail(const std::string& message)
+{
+    std::fprintf(stderr, "trianglesolver: %s\n%s", message.c_str(), Usage);
+    return false;
+}
+
+// "angleA=normal:0.1" or "AB=uniform:0.0005".
+bool parseTolerance(const char* text, InputDistribution (&tolerances)[InputFieldCount])
+{
+    const char* equals = std::strchr(text, '=');
+    const char* colon = equals ? std::strchr(equals, ':') : nullptr;
+    if (!colon) {
+        return false;
+    }
+    int field = inputField(std::string(text, equals).c_str());
+    std::string kind(equals + 1, colon);
+    InputDistribution distribution;
+    if (kind == "normal") {
+        distribution.kind = InputDistribution::Normal;
+    } else if (kind == "uniform") {
+        distribution.kind = InputDistribution::Uniform;
+    } else {
+        return false;
+    }
+    if (field < 0 || !parseDouble(colon + 1, distribution.spread) || !(distribution.spread >= 0)) {
+        return false;
+    }
+    tolerances[field] = distribution;
+    return true;
+}
+
+// Accepts "--name value" and "--name=value".
+bool parseArguments(int argc, char* argv[], Arguments& args)
+{
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        if (option.compare(0, 2, "--") != 0) {
+            return fail("unexpected argument " + option);
+        }
+        option.erase(0, 2);
+        std::string inlineValue;
+        bool hasInline = false;
+        std::size_t equals = option.find('=');
+        if (equals != std::string::npos) {
+            inlineValue = option.substr(equals + 1);
+            option.erase(equals);
+            hasInline = true;
+        }
+        auto value = [&](const char*& out) {
+            if (hasInline) {
+                out = inlineValue.c_str();
+                return true;
+            }
+            if (i + 1 >= argc) {
+                return false;
+            }
+            out = argv[++i];
+            return true;
+        };
+
+        const char* text = nullptr;
+        int field = inputField(option.c_str());
+        if (field >= 0) {
+            double number;
+            if (!value(text) || !parseDouble(text, number)) {
+                return fail("--" + option + " needs a number");
+            }
+            fieldValue(args.values, field) = number;
+        } else if (option == "json") {
+            args.json = true;
+        } else if (option == "jacobian") {
+            args.jacobian = true;
+        } else if (option == "fit") {
+            args.fit = true;
+        } else if (option == "sphere") {
+            if (!value(text) || !parseDouble(text, args.sphereRadius) || !(args.sphereRadius > 0)) {
+                return fail("--sphere needs a positive radius");
+            }
+        } else if (option == "rules") {
+            if (!value(text)) {
+                return fail("--rules needs a file");
+            }
+            args.rulesPath = text;
+        } else if (option == "plan") {
+            args.plan = true;
+        } else if (option == "tolerance") {
+            if (!value(text) || !parseTolerance(text, args.tolerances)) {
+                return fail("--tolerance needs INPUT=normal:SD or INPUT=uniform:HALFWIDTH");
+            }
+            args.mode = Mode::Uncertainty;
+        } else if (option == "samples") {
+            if (!value(text) || !parseUnsigned(text, args.samples) || args.samples == 0) {
+                return fail("--samples needs a positive count");
+            }
+        } else if (option == "batch") {
+            args.mode = Mode::Batch;
+        } else if (option == "reject-infeasible") {
+            args.rejectInfeasible = true;
+        } else if (option == "points") {
+            args.mode = Mode::Points;
+        } else if (option == "resume") {
+            args.resume = true;
+        } else if (option == "threads") {
+            if (!value(text) || !parseUnsigned(text, args.threads)) {
+                return fail("--threads needs a count");
+            }
+        } else if (option == "cache") {
+            if (!value(text)) {
+                return fail("--cache needs a file");
+            }
+            args.cachePath = text;
+        } else if (option == "cache-size") {
+            if (!value(text) || !parseUnsigned(text, args.cacheMegabytes) || args.cacheMegabytes == 0) {
+                return fail("--cache-size needs a size in MB");
+            }
+        } else if (option == "compact-cache") {
+            if (!value(text)) {
+                return fail("--compact-cache needs a file");
+            }
+            args.mode = Mode::CompactCache;
+            args.cachePath = text;
+        } else if (option == "mesh") {
+            if (!value(text)) {
+                return fail("--mesh needs a file");
+            }
+            args.mode = Mode::Mesh;
+            args.meshPath = text;
+        } else if (option == "faces") {
+            if (!value(text)) {
+                return fail("--faces needs a file");
+            }
+            args.facesPath = text;
+        } else if (option == "out") {
+            if (!value(text)) {
+                return fail("--out needs a file");
+            }
+            args.outPath = text;
+        } else if (option == "shard") {
+            const char* slash = value(text) ? std::strchr(text, '/') : nullptr;
+            if (!slash || !parseUnsigned(std::string(text, slash).c_str(), args.shardIndex)
+                || !parseUnsigned(slash + 1, args.shardCount)) {
+                return fail("--shard needs K/N");
+            }
+        } else if (option == "sweep") {
+            if (!value(text)) {
+                return fail("--sweep needs FIELD=FROM:TO:STEP");
+            }
+            SweepAxis axis;
+            std::string error;
+            if (!parseSweepAxis(text, axis, error)) {
+                return fail(error);
+            }
+            args.mode = Mode::Sweep;
+            args.axes.push_back(axis);
+        } else if (option == "encode") {
+            if (!value(text)) {
+                return fail("--encode needs COLUMN=ENCODING");
+            }
+            args.encodings.push_back(text);
+        } else if (option == "recode") {
+            if (!value(text)) {
+                return fail("--recode needs a columnar file");
+            }
+            args.mode = Mode::Recode;
+            args.recodePath = text;
+        } else if (option == "serve") {
+            if (!value(text)) {
+                return fail("--serve needs a shared memory name");
+            }
+            args.mode = Mode::Serve;
+            args.serveName = text;
+        } else if (option == "channels") {
+            if (!value(text) || !parseUnsigned(text, args.channels) || args.channels == 0) {
+                return fail("--channels needs a positive count");
+            }
+        } else if (option == "enumerate") {
+            if (!value(text) || !parseUnsigned(text, args.integerCriteria.maxSide)) {
+                return fail("--enumerate needs the largest side");
+            }
+            args.mode = Mode::Enumerate;
+        } else if (option == "require" || option == "any") {
+            std::string error;
+            if (!value(text)
+                || !parseIntegerProperties(text, option == "require" ? args.integerCriteria.required
+                                                                     : args.integerCriteria.anyOf, error)) {
+                return fail("--" + option + " needs a property list" + (error.empty() ? "" : ": " + error));
+            }
+        } else if (option == "help") {
+            std::fputs(Usage, stdout);
+            std::exit(0);
+        } else {
+            return fail("unknown option --" + option);
+        }
+    }
+    if (args.fit && args.jacobian) {
+        return fail("--fit and --jacobian do not combine");
+    }
+    if (args.mode == Mode::Uncertainty && (args.fit || args.jacobian || args.sphereRadius > 0
+                                           || !args.rulesPath.empty() || args.plan)) {
+        return fail("--tolerance does not combine with --fit, --jacobian, --sphere, --rules or --plan");
+    }
+    if (args.cacheMegabytes && args.cachePath.empty()) {
+        return fail("--cache-size needs --cache or --compact-cache");
+    }
+    if (args.sphereRadius > 0 && (args.fit || args.jacobian || args.rejectInfeasible || !args.cachePath.empty())) {
+        return fail("--sphere does not combine with --fit, --jacobian, --reject-infeasible or --cache");
+    }
+    if (!args.rulesPath.empty() && (args.fit || args.jacobian || args.sphereRadius > 0 || !args.cachePath.empty())) {
+        return fail("--rules does not combine with --fit, --jacobian, --sphere or --cache");
+    }
+    if (args.plan && (args.fit || args.jacobian || args.sphereRadius > 0 || !args.rulesPath.empty()
+                      || !args.cachePath.empty())) {
+        return fail("--plan does not combine with --fit, --jacobian, --sphere, --rules or --cache");
+    }
+    return true;
+}
+
+// Shortest round-trip text, like the batch writer; JSON has no NaN or infinity.
+void printNumber(double value, bool json)
+{
+    if (json && !std::isfinite(value)) {
+        std::fputs("null", stdout);
+        return;
+    }
+    char text[32];
+    *std::to_chars(text, text + sizeof text - 1, value).ptr = '\0';
+    std::fputs(text, stdout);
+}
+
+bool loadRules(const std::string& path, RuleSet& rules)
+{
+    std::string error;
+    if (!rules.load(path, error)) {
+        std::fprintf(stderr, "trianglesolver: %s\n", error.c_str());
+        return false;
+    }
+    return true;
+}
+
+int solveOne(const Arguments& args)
+{
+    TriangleValues values = args.values;
+    if (knownMask(values) == 0) {
+        fail("no inputs given");
+        return 2;
+    }
+    RuleSet rules;
+    if (!args.rulesPath.empty() && !loadRules(args.rulesPath, rules)) {
+        return 1;
+    }
+    TriangleJacobian jacobian;
+    if (args.sphereRadius > 0) {
+        SphericalOptions options;
+        options.radius = args.sphereRadius;
+        if (!solveSphericalTriangle(values, options)) {
+            std::fprintf(stderr, "trianglesolver: the inputs make no spherical triangle "
+                                 "(need three sides, SAS, ASA or three angles, sides shorter than half a great circle)\n");
+            return 1;
+        }
+    } else if (args.plan) {
+        // checkFeasibility follows solveTriangle's branches, which the planner does not use.
+        DerivationPlanner planner;
+        std::fputs(describePlan(planner.solve(values)).c_str(), stderr);
+    } else if (uint32_t reasons = checkFeasibility(values)) {
+        std::fprintf(stderr, "trianglesolver: %s\n", feasibilityReasonText(reasons));
+        return 1;
+    } else if (args.jacobian) {
+        solveWithJacobian(values, jacobian);
+    } else if (rules.size()) {
+        if (rules.solve(values) < 0) {
+            std::fprintf(stderr, "trianglesolver: no rule in %s applies to these inputs\n", args.rulesPath.c_str());
+            return 1;
+        }
+    } else {
+        solveTriangle(values);
+    }
+
+    if (args.json) {
+        std::fputc('{', stdout);
+        for (int field = 0; field < FieldCount; field++) {
+            std::printf("%s\"%s\":", field ? "," : "", kTriangleFieldNames[field]);
+            printNumber(fieldValue(values, field), true);
+        }
+        if (args.jacobian) {
+            std::fputs(",\"jacobian\":{", stdout);
+            for (int output = 0; output < FieldCount; output++) {
+                std::printf("%s\"%s\":{", output ? "," : "", kTriangleFieldNames[output]);
+                bool first = true;
+                for (int input = 0; input < InputFieldCount; input++) {
+                    if (jacobian.knownMask & (1u << input)) {
+                        std::printf("%s\"%s\":", first ? "" : ",", kTriangleFieldNames[input]);
+                        printNumber(jacobian(output, input), true);
+                        first = false;
+                    }
+                }
+                std::fputc('}', stdout);
+            }
+            std::fputc('}', stdout);
+        }
+        std::fputs("}\n", stdout);
+        return 0;
+    }
+
+    for (int field = 0; field < FieldCount; field++) {
+        std::printf("%-13s ", kTriangleFieldNames[field]);
+        printNumber(fieldValue(values, field), false);
+        std::fputc('\n', stdout);
+    }
+    if (args.jacobian) {
+        for (int output = 0; output < FieldCount; output++) {
+            for (int input = 0; input < InputFieldCount; input++) {
+                if (jacobian.knownMask & (1u << input)) {
+                    std::printf("d(%s)/d(%s) ", kTriangleFieldNames[output], kTriangleFieldNames[input]);
+                    printNumber(jacobian(output, input), false);
+                    std::fputc('\n', stdout);
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+// Least-squares fit of every known input, with the residual of each.
+int fitOne(const Arguments& args)
+{
+    ReconcileResult result;
+    if (!reconcileTriangle(args.values, nullptr, result)) {
+        std::fprintf(stderr, "trianglesolver: --fit needs at least three inputs, one of them a length\n");
+        return 1;
+    }
+
+    if (args.json) {
+        std::fputc('{', stdout);
+        for (int field = 0; field < FieldCount; field++) {
+            std::printf("%s\"%s\":", field ? "," : "", kTriangleFieldNames[field]);
+            printNumber(fieldValue(result.values, field), true);
+        }
+        std::fputs(",\"residuals\":{", stdout);
+        bool first = true;
+        for (int field = 0; field < InputFieldCount; field++) {
+            if (fieldValue(args.values, field) > 0) {
+                std::printf("%s\"%s\":", first ? "" : ",", kTriangleFieldNames[field]);
+                printNumber(result.residuals[field], true);
+                first = false;
+            }
+        }
+        std::fputs("},\"rms\":", stdout);
+        printNumber(result.rms, true);
+        std::printf(",\"iterations\":%d,\"converged\":%s}\n", result.iterations, result.converged ? "true" : "false");
+        return 0;
+    }
+
+    for (int field = 0; field < FieldCount; field++) {
+        std::printf("%-13s ", kTriangleFieldNames[field]);
+        printNumber(fieldValue(result.values, field), false);
+        std::fputc('\n', stdout);
+    }
+    for (int field = 0; field < InputFieldCount; field++) {
+        if (fieldValue(args.values, field) > 0) {
+            std::printf("residual(%s) ", kTriangleFieldNames[field]);
+            printNumber(result.residuals[field], false);
+            std::fputc('\n', stdout);
+        }
+    }
+    std::fputs("rms           ", stdout);
+    printNumber(result.rms, false);
+    std::printf("\n%d iterations%s\n", result.iterations, result.converged ? "" : ", not converged");
+    return 0;
+}
+
+// Samples every --tolerance input around its value and prints
+// writeUncertaintyReport: mean, spread, range and percentiles per output.
+int runUncertainty(const Arguments& args)
+{
+    if (knownMask(args.values) == 0) {
+        fail("no inputs given");
+        return 2;
+    }
+    for (int field = 0; field < InputFieldCount; field++) {
+        if (args.tolerances[field].kind != InputDistribution::Exact && !(fieldValue(args.values, field) > 0)) {
+            fail(std::string("--tolerance ") + kTriangleFieldNames[field] + " needs --" + kTriangleFieldNames[field]);
+            return 2;
+        }
+    }
+    if (uint32_t reasons = checkFeasibility(args.values)) {
+        std::fprintf(stderr, "trianglesolver: %s\n", feasibilityReasonText(reasons));
+        return 1;
+    }
+    MonteCarloOptions options;
+    options.samples = args.samples;
+    options.threads = args.threads;
+    MonteCarloResult result = propagateUncertainty(args.values, args.tolerances, options);
+    writeUncertaintyReport(std::cout, result);
+    return 0;
+}
+
+// --batch --fit: rows are read and fitted in chunks; rows that cannot be
+// fitted come out as all-NaN rows with a NaN rms.
+int runFitBatch(const Arguments& args)
+{
+    std::ios::sync_with_stdio(false);
+    const std::size_t chunkRows = 65536;
+    std::vector<TriangleValues> rows;
+    std::vector<unsigned char> valid;
+    std::vector<ReconcileResult> results(chunkRows);
+    ReconcileOptions options;
+    options.threads = args.threads;
+    std::string line;
+    std::string out;
+    char text[MaxFormattedRowLength];
+    std::size_t total = 0;
+    std::size_t unfitted = 0;
+    bool more = true;
+    while (more) {
+        rows.clear();
+        valid.clear();
+        while (rows.size() < chunkRows) {
+            if (!std::getline(std::cin, line)) {
+                more = false;
+                break;
+            }
+            if (line.empty() || line == "\r") {
+                continue;
+            }
+            rows.emplace_back();
+            valid.push_back(parseTriangleRow(line.data(), line.data() + line.size(), rows.back()));
+        }
+        reconcileBatch(rows.data(), rows.size(), nullptr, results.data(), options);
+        out.clear();
+        for (std::size_t row = 0; row < rows.size(); row++) {
+            ReconcileResult& result = results[row];
+            if (!valid[row] || !result.iterations) {
+                std::fill_n(&result.values.AB, FieldCount, std::numeric_limits<double>::quiet_NaN());
+                result.rms = std::numeric_limits<double>::quiet_NaN();
+                unfitted++;
+            }
+            std::size_t length = formatTriangleRow(result.values, text, sizeof text);
+            out.append(text, length - 1);
+            out += ',';
+            char* end = std::to_chars(text, text + sizeof text, result.rms).ptr;
+            out.append(text, end);
+            out += '\n';
+        }
+        std::cout.write(out.data(), out.size());
+        total += rows.size();
+    }
+    std::fprintf(stderr, "%zu rows (%zu not fitted)\n", total, unfitted);
+    return unfitted ? 1 : 0;
+}
+
+std::size_t cacheBytes(const Arguments& args)
+{
+    return std::size_t(args.cacheMegabytes ? args.cacheMegabytes : 256) << 20;
+}
+
+int runBatch(const Arguments& args)
+{
+    std::ios::sync_with_stdio(false);
+    PipelineOptions options;
+    options.solverThreads = args.threads;
+    options.rejectInfeasible = args.rejectInfeasible;
+    SphericalOptions sphere;
+    sphere.radius = args.sphereRadius;
+    if (args.sphereRadius > 0) {
+        options.solve = [&sphere](const TriangleValues* inputs, TriangleValues* outputs, std::size_t count,
+                                  unsigned char*) { solveSphericalBatch(inputs, outputs, count, sphere); };
+    }
+    RuleSet rules;
+    if (!args.rulesPath.empty()) {
+        if (!loadRules(args.rulesPath, rules)) {
+            return 1;
+        }
+        options.solve = [&rules](const TriangleValues* inputs, TriangleValues* outputs, std::size_t count,
+                                 unsigned char* solved) {
+            thread_local std::vector<int> used; // one per solver thread, sized by the first chunk
+            used.resize(count);
+            rules.solveBatch(inputs, outputs, count, used.data());
+            // No rule matched: the row passed through unsolved, so it is invalid.
+            for (std::size_t i = 0; i < count; i++) {
+                solved[i] = used[i] >= 0;
+            }
+        };
+    }
+    DerivationPlanner planner;
+    if (args.plan) {
+        options.solve = [&planner](const TriangleValues* inputs, TriangleValues* outputs, std::size_t count,
+                                   unsigned char*) { planner.solveBatch(inputs, outputs, count); };
+    }
+    PersistentSolveCache cache;
+    if (!args.cachePath.empty()) {
+        std::string error;
+        if (!cache.open(args.cachePath, cacheBytes(args), error)) {
+            std::fprintf(stderr, "trianglesolver: %s\n", error.c_str());
+            return 1;
+        }
+        options.solve = [&cache](const TriangleValues* inputs, TriangleValues* outputs, std::size_t count,
+                                 unsigned char*) { cache.solve(inputs, outputs, count); };
+    }
+    PipelineStats stats = runBatchPipeline(std::cin, std::cout, options);
+    std::fprintf(stderr, "%zu rows (%zu invalid) in %.3f s\n", stats.rows, stats.invalidRows, stats.wallSeconds);
+    if (args.rejectInfeasible) {
+        std::fprintf(stderr, "%zu rejected\n", stats.rejected.rejected);
+        for (int bit = 0; bit < FeasibilityReasonCount; bit++) {
+            if (stats.rejected.byReason[bit]) {
+                std::fprintf(stderr, "  %-22s %zu\n", feasibilityReasonName(bit), stats.rejected.byReason[bit]);
+            }
+        }
+    }
+    if (cache.isOpen()) {
+        PersistentCacheStats cacheStats = cache.stats();
+        std::fprintf(stderr, "cache: %zu of %zu rows hit (%.1f%%), %zu inserted, %zu inserts failed; %zu of %zu records\n",
+                     cacheStats.hits, cacheStats.lookups, 100.0 * cacheStats.hitRate(), cacheStats.inserts,
+                     cacheStats.insertFailures, cacheStats.records, cacheStats.recordCapacity);
+        if (cacheStats.insertFailures) {
+            std::fprintf(stderr, "cache: %s is full; --compact-cache it, with a larger --cache-size to grow it\n",
+                         args.cachePath.c_str());
+        }
+    }
+    return stats.invalidRows ? 1 : 0;
+}
+
+int runCompactCache(const Arguments& args)
+{
+    std::string error;
+    if (!compactSolveCache(args.cachePath, cacheBytes(args), error)) {
+        std::fprintf(stderr, "trianglesolver: %s\n", error.c_str());
+        return 1;
+    }
+    PersistentSolveCache cache;
+    if (cache.openReadOnly(args.cachePath, error)) {
+        PersistentCacheStats stats = cache.stats();
+        std::fprintf(stderr, "%zu records, room for %zu\n", stats.records, stats.recordCapacity);
+    }
+    return 0;
+}
+
+int runMesh(const Arguments& args)
+{
+    Mesh mesh;
+    std::string error;
+    if (!loadMesh(args.meshPath, mesh, error)) {
+        std::fprintf(stderr, "trianglesolver: %s\n", error.c_str());
+        return 1;
+    }
+    MeshAnalysisOptions options;
+    options.threads = args.threads;
+    MeshFaceMetrics faces;
+    MeshReport report = analyzeMesh(mesh, options, args.facesPath.empty() ? nullptr : &faces);
+    writeMeshReport(std::cout, report);
+    if (!args.facesPath.empty()) {
+        std::ofstream out(args.facesPath);
+        writeFaceMetricsCsv(out, faces);
+        if (!out) {
+            std::fprintf(stderr, "trianglesolver: cannot write %s\n", args.facesPath.c_str());
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int runSweepMode(const Arguments& args)
+{
+    if (args.outPath.empty()) {
+        fail("--sweep needs --out FILE");
+        return 2;
+    }
+    SweepOptions options;
+    options.threads = args.threads;
+    options.shardIndex = args.shardIndex;
+    options.shardCount = args.shardCount;
+    options.resume = args.resume;
+    std::string error;
+    std::vector<std::string> names(kTriangleFieldNames, kTriangleFieldNames + FieldCount);
+    for (const std::string& spec : args.encodings) {
+        if (!parseColumnarFormat(spec, names, options.formats, error)) {
+            fail(error);
+            return 2;
+        }
+    }
+    SweepStats stats;
+    if (!runSweep(args.axes, args.outPath, options, stats, error)) {
+        std::fprintf(stderr, "trianglesolver: %s\n", error.c_str());
+        return 1;
+    }
+    std::fprintf(stderr, "rows %llu..%llu of %llu, solved %llu from row %llu in %.3f s\n",
+                 (unsigned long long)stats.firstRow, (unsigned long long)stats.endRow, (unsigned long long)stats.gridRows,
+                 (unsigned long long)stats.rowsWritten, (unsigned long long)stats.resumedAt, stats.seconds);
+    return 0;
+}
+
+int runRecode(const Arguments& args)
+{
+    if (args.outPath.empty()) {
+        fail("--recode needs --out FILE");
+        return 2;
+    }
+    std::vector<ColumnarColumnReport> report;
+    std::string error;
+    if (!recodeColumnarFile(args.recodePath, args.outPath, args.encodings, report, error)) {
+        std::fprintf(stderr, "trianglesolver: %s\n", error.c_str());
+        return 1;
+    }
+    uint64_t inputBytes = 0;
+    uint64_t outputBytes = 0;
+    std::printf("%-14s %14s %14s %7s %12s\n", "column", "input bytes", "output bytes", "ratio", "max error");
+    for (const ColumnarColumnReport& column : report) {
+        std::printf("%-14s %14llu %14llu %7.2f %12.3g\n", column.name.c_str(), (unsigned long long)column.inputBytes,
+                    (unsigned long long)column.outputBytes, double(column.inputBytes) / double(column.outputBytes),
+                    column.maxError);
+        inputBytes += column.inputBytes;
+        outputBytes += column.outputBytes;
+    }
+    std::printf("%-14s %14llu %14llu %7.2f\n", "total", (unsigned long long)inputBytes,
+                (unsigned long long)outputBytes, double(inputBytes) / double(outputBytes));
+    return 0;
+}
+
+std::atomic<bool> serveStop{false};
+
+extern "C" void stopServing(int)
+{
+    serveStop.store(true, std::memory_order_relaxed);
+}
+
+// Solves for ShmSolverClients until SIGINT or SIGTERM, then removes the segment.
+int runServe(const Arguments& args)
+{
+    const unsigned ringRecords = 4096;
+    ShmSolverServer server;
+    std::string error;
+    if (!server.create(args.serveName, args.channels, ringRecords, error)) {
+        std::fprintf(stderr, "trianglesolver: %s\n", error.c_str());
+        return 1;
+    }
+    std::signal(SIGINT, stopServing);
+    std::signal(SIGTERM, stopServing);
+    std::fprintf(stderr, "serving %s with %u channels of %u records\n", args.serveName.c_str(), args.channels,
+                 ringRecords);
+    std::size_t solved = server.serve(serveStop);
+    server.close();
+    std::fprintf(stderr, "solved %zu triangles\n", solved);
+    return 0;
+}
+
+// One line per triangle in order of c, a, b: the sides, the exact area (0
+// unless integer), the property bits in hex, then the solved values.
+int runEnumerate(const Arguments& args)
+{
+    IntegerTriangleCriteria criteria = args.integerCriteria;
+    criteria.threads = args.threads;
+    std::ios::sync_with_stdio(false);
+    std::string out;
+    char text[MaxFormattedRowLength];
+    auto sink = [&](const IntegerTriangle* rows, std::size_t count) {
+        out.clear();
+        for (std::size_t row = 0; row < count; row++) {
+            const IntegerTriangle& triangle = rows[row];
+            int prefix = std::snprintf(text, sizeof text, "%u,%u,%u,%llu,%x,", triangle.a, triangle.b, triangle.c,
+                                       (unsigned long long)triangle.area, triangle.properties);
+            out.append(text, prefix);
+            out.append(text, formatTriangleRow(triangle.values, text, sizeof text));
+        }
+        std::cout.write(out.data(), out.size());
+    };
+    IntegerEnumerationStats stats;
+    std::string error;
+    if (!enumerateIntegerTriangles(criteria, sink, stats, error)) {
+        fail(error);
+        return 2;
+    }
+    std::cout.flush();
+    std::fprintf(stderr, "%llu triangles from %llu candidates in %.3f s\n", (unsigned long long)stats.found,
+                 (unsigned long long)stats.candidates, stats.seconds);
+    return 0;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    Arguments args;
+    if (!parseArguments(argc, argv, args)) {
+        return 2;
+    }
+    switch (args.mode) {
+    case Mode::Batch:
+        return args.fit ? runFitBatch(args) : runBatch(args);
+    case Mode::Points: {
+        std::ios::sync_with_stdio(false);
+        std::string error;
+        long long count = solvePointStream(std::cin, std::cout, error);
+        if (count < 0) {
+            std::cout.flush();
+            std::fprintf(stderr, "trianglesolver: %s\n", error.c_str());
+            return 1;
+        }
+        return 0;
+    }
+    case Mode::Mesh:
+        return runMesh(args);
+    case Mode::Sweep:
+        return runSweepMode(args);
+    case Mode::Recode:
+        return runRecode(args);
+    case Mode::Serve:
+        return runServe(args);
+    case Mode::Enumerate:
+        return runEnumerate(args);
+    case Mode::CompactCache:
+        return runCompactCache(args);
+    case Mode::Uncertainty:
+        return runUncertainty(args);
+    case Mode::Solve:
+        break;
+    }
+    return args.fit ? fitOne(args) : solveOne(args);
+}
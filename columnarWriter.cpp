@@ -0,0 +1,699 @@
+#include "columnarWriter.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+
+struct FileHeader {
+    char magic[4] = {'T', 'C', 'O', 'L'};
+    uint16_t version = 2;
+    uint16_t columnCount = 0;
+    uint32_t metadataBytes = 0;
+};
+
+static_assert(sizeof(FileHeader) == 12, "columnar header must stay 12 bytes");
+static_assert(sizeof(ColumnarGroupHeader) == 16, "columnar group header must stay 16 bytes");
+static_assert(sizeof(ColumnarColumnHeader) == 8, "columnar column header must stay 8 bytes");
+static_assert(sizeof(ColumnarFixedHeader) == 24, "columnar fixed header must stay 24 bytes");
+
+const double FixedLimit = 4503599627370496.0; // 2^52 steps: codes stay exact and differences cannot overflow
+const unsigned MaxFixedBits = 56;             // so one unaligned 64-bit load covers any code
+const uint32_t FixedBlockRows = 64;           // rows per bit width; a block of any width ends on a byte
+const std::size_t PackedPadding = 8;
+
+// FNV-1a over 8-byte words (the tail byte-wise); only has to catch torn writes.
+uint32_t checksum(const char* data, std::size_t size)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    std::size_t words = size / 8;
+    for (std::size_t i = 0; i < words; i++) {
+        uint64_t word;
+        std::memcpy(&word, data + 8 * i, 8);
+        hash = (hash ^ word) * 0x100000001b3ull;
+    }
+    for (std::size_t i = words * 8; i < size; i++) {
+        hash = (hash ^ uint8_t(data[i])) * 0x100000001b3ull;
+    }
+    return uint32_t(hash ^ (hash >> 32));
+}
+
+bool isFixed(uint8_t encoding)
+{
+    return encoding == Columnar_Fixed || encoding == Columnar_FixedDelta;
+}
+
+template <typename T>
+void append(std::vector<char>& out, const T& value)
+{
+    std::size_t offset = out.size();
+    out.resize(offset + sizeof value);
+    std::memcpy(out.data() + offset, &value, sizeof value);
+}
+
+// Round to nearest even, overflowing to infinity; NaN stays NaN.
+uint16_t toHalf(double value)
+{
+    float f = float(value);
+    uint32_t x;
+    std::memcpy(&x, &f, 4);
+    uint16_t sign = uint16_t((x >> 16) & 0x8000);
+    x &= 0x7fffffff;
+    if (x >= 0x7f800000) {
+        return sign | 0x7c00 | (x > 0x7f800000 ? 0x200 : 0);
+    }
+    if (x >= 0x477ff000) { // 65520 and up round past the largest half
+        return sign | 0x7c00;
+    }
+    if (x < 0x38800000) { // below 2^-14: a subnormal half, in units of 2^-24
+        return sign | uint16_t(std::nearbyint(std::fabs(f) * 16777216.0f));
+    }
+    // Rebias the exponent and round the 13 dropped mantissa bits in one add.
+    x += 0xc8000fff + ((x >> 13) & 1);
+    return sign | uint16_t(x >> 13);
+}
+
+// Branch-free so the decode loop vectorizes: scaling by 2^112 rebiases
+// normals and normalizes subnormals alike.
+float fromHalf(uint16_t half)
+{
+    uint32_t x = uint32_t(half & 0x7fff) << 13;
+    float f;
+    std::memcpy(&f, &x, 4);
+    f *= 5.192296858534828e33f;
+    std::memcpy(&x, &f, 4);
+    x |= f >= 65536.0f ? 0x7f800000u : 0u; // exponent 31: infinity or NaN
+    x |= uint32_t(half & 0x8000) << 16;
+    std::memcpy(&f, &x, 4);
+    return f;
+}
+
+// The code a reference value predicts; the writer and the reader must agree bit for bit.
+inline int64_t referenceCode(const double* reference, uint32_t row, double step)
+{
+    if (!reference) {
+        return 0;
+    }
+    double scaled = reference[row] / step;
+    return std::fabs(scaled) < FixedLimit ? std::llround(scaled) : 0;
+}
+
+// Appends a fixed column; false if its codes need more than MaxFixedBits.
+bool encodeFixed(const double* values, uint32_t rows, const ColumnarFormat& format, const double* reference,
+                 std::vector<char>& out, std::vector<int64_t>& codes)
+{
+    const bool delta = format.encoding == Columnar_FixedDelta;
+    ColumnarFixedHeader header;
+    header.step = 2 * format.maxError;
+    codes.resize(rows);
+    int64_t previous = 0;
+    int64_t low = 0;
+    for (uint32_t i = 0; i < rows; i++) {
+        double scaled = values[i] / header.step;
+        int64_t residual = delta ? previous : 0; // exceptions code as a zero step
+        if (std::fabs(scaled) < FixedLimit) {
+            residual = std::llround(scaled) - referenceCode(reference, i, header.step);
+        } else {
+            header.exceptions++;
+        }
+        codes[i] = delta ? residual - previous : residual;
+        previous = residual;
+        low = i ? std::min(low, codes[i]) : codes[i];
+    }
+    header.base = low;
+
+    // Each block gets the width of its own largest code, so the long runs
+    // of equal steps in sorted columns cost nothing.
+    const uint32_t blocks = (rows + FixedBlockRows - 1) / FixedBlockRows;
+    std::size_t widthsAt = out.size() + sizeof header;
+    out.resize(widthsAt + blocks);
+    std::size_t packedBytes = 0;
+    for (uint32_t block = 0; block < blocks; block++) {
+        uint64_t spread = 0;
+        for (uint32_t i = block * FixedBlockRows; i < std::min(rows, (block + 1) * FixedBlockRows); i++) {
+            spread |= uint64_t(codes[i] - low);
+        }
+        uint8_t bits = 0;
+        while (bits < 64 && (spread >> bits)) {
+            bits++;
+        }
+        if (bits > MaxFixedBits) {
+            out.resize(widthsAt - sizeof header);
+            return false;
+        }
+        out[widthsAt + block] = char(bits);
+        packedBytes += bits * FixedBlockRows / 8;
+    }
+    std::memcpy(out.data() + widthsAt - sizeof header, &header, sizeof header);
+
+    std::size_t packedAt = out.size();
+    out.resize(packedAt + packedBytes + PackedPadding, 0);
+    char* packed = out.data() + packedAt;
+    for (uint32_t block = 0; block < blocks; block++) {
+        unsigned bits = uint8_t(out[widthsAt + block]);
+        uint32_t first = block * FixedBlockRows;
+        for (uint32_t i = first; i < std::min(rows, first + FixedBlockRows); i++) {
+            uint64_t position = uint64_t(i - first) * bits;
+            uint64_t word;
+            std::memcpy(&word, packed + (position >> 3), 8);
+            word |= uint64_t(codes[i] - low) << (position & 7);
+            std::memcpy(packed + (position >> 3), &word, 8);
+        }
+        packed += bits * FixedBlockRows / 8;
+    }
+    for (uint32_t i = 0; i < rows && header.exceptions; i++) {
+        if (!(std::fabs(values[i] / header.step) < FixedLimit)) {
+            append(out, i);
+            append(out, values[i]);
+        }
+    }
+    return true;
+}
+
+bool decodeFixed(const char* data, std::size_t bytes, bool delta, uint32_t rows, const double* reference, double* out)
+{
+    ColumnarFixedHeader header;
+    const uint32_t blocks = (rows + FixedBlockRows - 1) / FixedBlockRows;
+    if (bytes < sizeof header + blocks) {
+        return false;
+    }
+    std::memcpy(&header, data, sizeof header);
+    const uint8_t* widths = reinterpret_cast<const uint8_t*>(data + sizeof header);
+    std::size_t packedBytes = 0;
+    for (uint32_t block = 0; block < blocks; block++) {
+        if (widths[block] > MaxFixedBits) {
+            return false;
+        }
+        packedBytes += widths[block] * FixedBlockRows / 8;
+    }
+    const std::size_t exceptionBytes = std::size_t(header.exceptions) * (sizeof(uint32_t) + sizeof(double));
+    if (bytes != sizeof header + blocks + packedBytes + PackedPadding + exceptionBytes) {
+        return false;
+    }
+
+    const char* packed = data + sizeof header + blocks;
+    const double step = header.step;
+    int64_t residual = 0;
+    int64_t codes[FixedBlockRows];
+    for (uint32_t block = 0; block < blocks; block++) {
+        // Unpack a whole block at one width (a loop the compiler can
+        // vectorize), then undo the base, delta and reference in a second pass.
+        const unsigned bits = widths[block];
+        const uint64_t mask = (uint64_t(1) << bits) - 1;
+        for (uint32_t j = 0; j < FixedBlockRows; j++) {
+            uint64_t position = uint64_t(j) * bits;
+            uint64_t word;
+            std::memcpy(&word, packed + (position >> 3), 8);
+            codes[j] = header.base + int64_t((word >> (position & 7)) & mask);
+        }
+        packed += bits * FixedBlockRows / 8;
+
+        const uint32_t first = block * FixedBlockRows;
+        const uint32_t count = std::min(FixedBlockRows, rows - first);
+        double* values = out + first;
+        if (delta) {
+            for (uint32_t j = 0; j < count; j++) {
+                residual += codes[j];
+                codes[j] = residual;
+            }
+        }
+        if (reference) {
+            for (uint32_t j = 0; j < count; j++) {
+                values[j] = double(codes[j] + referenceCode(reference, first + j, step)) * step;
+            }
+        } else {
+            for (uint32_t j = 0; j < count; j++) {
+                values[j] = double(codes[j]) * step;
+            }
+        }
+    }
+
+    const char* exception = packed + PackedPadding;
+    for (uint32_t e = 0; e < header.exceptions; e++, exception += sizeof(uint32_t) + sizeof(double)) {
+        uint32_t row;
+        std::memcpy(&row, exception, sizeof row);
+        if (row >= rows) {
+            return false;
+        }
+        std::memcpy(&out[row], exception + sizeof row, sizeof(double));
+    }
+    return true;
+}
+
+// Appends one column's data to out and returns the encoding it got.
+uint8_t encodeColumn(const double* values, uint32_t rows, const ColumnarFormat& format, const double* reference,
+                     std::vector<char>& out, std::vector<int64_t>& codes)
+{
+    std::size_t start = out.size();
+    switch (format.encoding) {
+    case Columnar_Float32:
+        out.resize(start + std::size_t(rows) * sizeof(float));
+        for (uint32_t i = 0; i < rows; i++) {
+            float value = float(values[i]);
+            std::memcpy(out.data() + start + i * sizeof value, &value, sizeof value);
+        }
+        return Columnar_Float32;
+    case Columnar_Float16:
+        out.resize(start + std::size_t(rows) * sizeof(uint16_t));
+        for (uint32_t i = 0; i < rows; i++) {
+            uint16_t value = toHalf(values[i]);
+            std::memcpy(out.data() + start + i * sizeof value, &value, sizeof value);
+        }
+        return Columnar_Float16;
+    case Columnar_Fixed:
+    case Columnar_FixedDelta:
+        if (encodeFixed(values, rows, format, reference, out, codes)) {
+            return format.encoding;
+        }
+        out.resize(start);
+        break;
+    default:
+        break;
+    }
+    out.resize(start + std::size_t(rows) * sizeof(double));
+    std::memcpy(out.data() + start, values, std::size_t(rows) * sizeof(double));
+    return Columnar_Float64;
+}
+
+// Decodes rows values of one column into out; false for a malformed column.
+bool decodeColumn(const ColumnarColumnHeader& header, const char* data, uint32_t rows, const double* reference,
+                  double* out)
+{
+    switch (header.encoding) {
+    case Columnar_Float64:
+        if (header.bytes != std::size_t(rows) * sizeof(double)) {
+            return false;
+        }
+        std::memcpy(out, data, header.bytes);
+        return true;
+    case Columnar_Float32:
+        if (header.bytes != std::size_t(rows) * sizeof(float)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < rows; i++) {
+            float value;
+            std::memcpy(&value, data + i * sizeof value, sizeof value);
+            out[i] = value;
+        }
+        return true;
+    case Columnar_Float16:
+        if (header.bytes != std::size_t(rows) * sizeof(uint16_t)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < rows; i++) {
+            uint16_t value;
+            std::memcpy(&value, data + i * sizeof value, sizeof value);
+            out[i] = fromHalf(value);
+        }
+        return true;
+    case Columnar_Fixed:
+    case Columnar_FixedDelta:
+        return decodeFixed(data, header.bytes, header.encoding == Columnar_FixedDelta, rows, reference, out);
+    default:
+        return false;
+    }
+}
+
+bool readHeader(std::istream& in, std::vector<std::string>& names, std::string& metadata, std::string& error)
+{
+    FileHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof header) || std::memcmp(header.magic, "TCOL", 4) != 0) {
+        error = "not a columnar file";
+        return false;
+    }
+    if (header.version != 1 && header.version != 2) {
+        error = "unsupported columnar version " + std::to_string(header.version);
+        return false;
+    }
+    names.clear();
+    for (int c = 0; c < header.columnCount; c++) {
+        uint8_t length = 0;
+        std::string name;
+        if (in.read(reinterpret_cast<char*>(&length), 1)) {
+            name.resize(length);
+            in.read(&name[0], length);
+        }
+        if (!in) {
+            error = "truncated columnar header";
+            return false;
+        }
+        names.push_back(name);
+    }
+    metadata.assign(header.version == 1 ? 0 : header.metadataBytes, '\0');
+    if (!metadata.empty() && !in.read(&metadata[0], metadata.size())) {
+        error = "truncated columnar header";
+        return false;
+    }
+    return true;
+}
+
+// Reads the next group into payload (column headers + data). False at the
+// end of the file or at a torn group; torn tells the two apart.
+bool readGroup(std::istream& in, std::size_t columnCount, ColumnarGroupHeader& group, std::vector<char>& payload, bool& torn)
+{
+    torn = false;
+    if (!in.read(reinterpret_cast<char*>(&group), sizeof group)) {
+        torn = in.gcount() > 0;
+        return false;
+    }
+    payload.clear();
+    for (std::size_t c = 0; c < columnCount; c++) {
+        ColumnarColumnHeader column;
+        std::size_t offset = payload.size();
+        if (!in.read(reinterpret_cast<char*>(&column), sizeof column)) {
+            torn = true;
+            return false;
+        }
+        payload.resize(offset + sizeof column + column.bytes);
+        std::memcpy(payload.data() + offset, &column, sizeof column);
+        if (!in.read(payload.data() + offset + sizeof column, column.bytes)) {
+            torn = true;
+            return false;
+        }
+    }
+    torn = checksum(payload.data(), payload.size()) != group.checksum;
+    return !torn;
+}
+
+}
+
+bool parseColumnarFormat(const std::string& text, const std::vector<std::string>& columns,
+                         std::vector<ColumnarFormat>& formats, std::string& error)
+{
+    std::size_t equals = text.find('=');
+    if (equals == std::string::npos) {
+        error = "expected column=encoding, got " + text;
+        return false;
+    }
+    std::string name = text.substr(0, equals);
+    std::string spec = text.substr(equals + 1);
+    auto columnIndex = [&](const std::string& column) {
+        auto found = std::find(columns.begin(), columns.end(), column);
+        return found == columns.end() ? -1 : int(found - columns.begin());
+    };
+
+    ColumnarFormat format;
+    std::size_t at = spec.find('@');
+    if (at != std::string::npos) {
+        format.reference = columnIndex(spec.substr(at + 1));
+        if (format.reference < 0) {
+            error = "unknown reference column in " + text;
+            return false;
+        }
+        spec.erase(at);
+    }
+    std::size_t colon = spec.find(':');
+    std::string kind = spec.substr(0, colon);
+    if (kind == "fixed" || kind == "delta") {
+        format.encoding = kind == "fixed" ? Columnar_Fixed : Columnar_FixedDelta;
+        const char* end = spec.data() + spec.size();
+        auto [ptr, ec] = colon == std::string::npos ? std::from_chars(end, end, format.maxError)
+                                                    : std::from_chars(spec.data() + colon + 1, end, format.maxError);
+        if (ec != std::errc() || ptr != end || !(format.maxError > 0) || !std::isfinite(format.maxError)) {
+            error = kind + " needs a positive error bound, as in " + name + "=" + kind + ":1e-6";
+            return false;
+        }
+    } else if (colon != std::string::npos) {
+        error = "bad encoding in " + text;
+        return false;
+    } else if (kind == "float64") {
+        format.encoding = Columnar_Float64;
+    } else if (kind == "float32") {
+        format.encoding = Columnar_Float32;
+    } else if (kind == "float16") {
+        format.encoding = Columnar_Float16;
+    } else {
+        error = "unknown encoding " + kind + " (float64, float32, float16, fixed:ERROR or delta:ERROR)";
+        return false;
+    }
+    if (format.reference >= 0 && !isFixed(format.encoding)) {
+        error = "only fixed and delta columns take a reference: " + text;
+        return false;
+    }
+
+    formats.resize(columns.size());
+    if (name == "*") {
+        std::fill(formats.begin(), formats.end(), format);
+        return true;
+    }
+    int column = columnIndex(name);
+    if (column < 0) {
+        error = "unknown column " + name;
+        return false;
+    }
+    formats[column] = format;
+    return true;
+}
+
+ColumnarWriter::~ColumnarWriter()
+{
+    close();
+}
+
+bool ColumnarWriter::open(const std::string& path, const std::vector<std::string>& columns, const std::string& metadata,
+                          bool resume, std::string& error)
+{
+    close();
+    columnCount = columns.size();
+    groups = 0;
+    nextRow = 0;
+    formats.assign(columnCount, ColumnarFormat());
+    referenced.assign(columnCount, 0);
+
+    std::error_code ec;
+    if (resume && std::filesystem::exists(path, ec)) {
+        std::uintmax_t validEnd = 0;
+        {
+            std::ifstream in(path, std::ios::binary);
+            std::vector<std::string> names;
+            std::string stored;
+            if (!readHeader(in, names, stored, error)) {
+                return false;
+            }
+            if (names != columns) {
+                error = "columns of " + path + " do not match";
+                return false;
+            }
+            if (stored != metadata) {
+                error = path + " was written for \"" + stored + "\", not \"" + metadata + "\"";
+                return false;
+            }
+            validEnd = std::uintmax_t(in.tellg());
+            ColumnarGroupHeader group;
+            std::vector<char> payload;
+            bool torn;
+            while (readGroup(in, columnCount, group, payload, torn)) {
+                validEnd = std::uintmax_t(in.tellg());
+                nextRow = group.firstRow + group.rows;
+                groups++;
+            }
+        }
+        std::filesystem::resize_file(path, validEnd, ec);
+        if (ec) {
+            error = "cannot truncate " + path + ": " + ec.message();
+            return false;
+        }
+        out.open(path, std::ios::binary | std::ios::app);
+        if (!out) {
+            error = "cannot open " + path;
+            return false;
+        }
+        return true;
+    }
+
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        error = "cannot create " + path;
+        return false;
+    }
+    FileHeader header;
+    header.columnCount = uint16_t(columnCount);
+    header.metadataBytes = uint32_t(metadata.size());
+    out.write(reinterpret_cast<const char*>(&header), sizeof header);
+    for (const std::string& name : columns) {
+        uint8_t length = uint8_t(std::min<std::size_t>(name.size(), 255));
+        out.write(reinterpret_cast<const char*>(&length), 1);
+        out.write(name.data(), length);
+    }
+    out.write(metadata.data(), metadata.size());
+    out.flush();
+    return bool(out);
+}
+
+bool ColumnarWriter::setFormats(const std::vector<ColumnarFormat>& newFormats, std::string& error)
+{
+    if (newFormats.size() != columnCount) {
+        error = "expected " + std::to_string(columnCount) + " column formats";
+        return false;
+    }
+    std::vector<char> newReferenced(columnCount, 0);
+    for (std::size_t c = 0; c < columnCount; c++) {
+        const ColumnarFormat& format = newFormats[c];
+        if (format.encoding > Columnar_FixedDelta) {
+            error = "unknown encoding for column " + std::to_string(c);
+            return false;
+        }
+        if (isFixed(format.encoding) && !(format.maxError > 0 && std::isfinite(format.maxError))) {
+            error = "column " + std::to_string(c) + " needs a positive error bound";
+            return false;
+        }
+        if (format.reference >= 0) {
+            // A reader decodes columns in order, so the reference must come first.
+            if (!isFixed(format.encoding) || std::size_t(format.reference) >= c || format.reference > 254) {
+                error = "column " + std::to_string(c) + " can only predict from an earlier column";
+                return false;
+            }
+            newReferenced[format.reference] = 1;
+        }
+    }
+    formats = newFormats;
+    referenced = newReferenced;
+    decoded.resize(columnCount);
+    return true;
+}
+
+bool ColumnarWriter::writeGroup(uint64_t firstRow, const double* const* columns, uint32_t rows)
+{
+    buffer.resize(sizeof(ColumnarGroupHeader));
+    for (std::size_t c = 0; c < columnCount; c++) {
+        const ColumnarFormat& format = formats[c];
+        const double* reference = format.reference >= 0 ? decoded[format.reference].data() : nullptr;
+        std::size_t headerAt = buffer.size();
+        buffer.resize(headerAt + sizeof(ColumnarColumnHeader));
+        ColumnarColumnHeader column;
+        column.encoding = encodeColumn(columns[c], rows, format, reference, buffer, scratch);
+        column.reference = isFixed(column.encoding) && reference ? uint8_t(format.reference + 1) : 0;
+        column.bytes = uint32_t(buffer.size() - headerAt - sizeof column);
+        std::memcpy(buffer.data() + headerAt, &column, sizeof column);
+        if (referenced[c]) {
+            // Later columns predict from what a reader will decode, not from the exact values.
+            decoded[c].resize(rows);
+            decodeColumn(column, buffer.data() + headerAt + sizeof column, rows,
+                         column.reference ? decoded[column.reference - 1].data() : nullptr, decoded[c].data());
+        }
+    }
+    ColumnarGroupHeader group;
+    group.firstRow = firstRow;
+    group.rows = rows;
+    group.checksum = checksum(buffer.data() + sizeof group, buffer.size() - sizeof group);
+    std::memcpy(buffer.data(), &group, sizeof group);
+
+    out.write(buffer.data(), buffer.size());
+    out.flush();
+    groups++;
+    nextRow = firstRow + rows;
+    return bool(out);
+}
+
+bool ColumnarWriter::close()
+{
+    if (!out.is_open()) {
+        return true;
+    }
+    out.close();
+    return !out.fail();
+}
+
+bool readColumnarFile(const std::string& path, ColumnarTable& table, std::string& error)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+    table = ColumnarTable();
+    if (!readHeader(in, table.names, table.metadata, error)) {
+        return false;
+    }
+    table.columns.resize(table.names.size());
+    table.columnBytes.assign(table.names.size(), 0);
+    ColumnarGroupHeader group;
+    std::vector<char> payload;
+    while (readGroup(in, table.names.size(), group, payload, table.torn)) {
+        const char* p = payload.data();
+        std::size_t offset = table.rows();
+        for (std::size_t c = 0; c < table.columns.size(); c++) {
+            ColumnarColumnHeader header;
+            std::memcpy(&header, p, sizeof header);
+            p += sizeof header;
+            if (header.encoding > Columnar_FixedDelta) {
+                error = "unsupported column encoding " + std::to_string(header.encoding);
+                return false;
+            }
+            if (header.reference > c) {
+                error = "column " + table.names[c] + " predicts from a later column";
+                return false;
+            }
+            std::vector<double>& column = table.columns[c];
+            column.resize(offset + group.rows);
+            const double* reference = header.reference ? table.columns[header.reference - 1].data() + offset : nullptr;
+            if (!decodeColumn(header, p, group.rows, reference, column.data() + offset)) {
+                error = "malformed column " + table.names[c] + " in the group at row " + std::to_string(group.firstRow);
+                return false;
+            }
+            table.columnBytes[c] += sizeof header + header.bytes;
+            p += header.bytes;
+        }
+        table.groups.push_back(group);
+    }
+    return true;
+}
+
+bool recodeColumnarFile(const std::string& inPath, const std::string& outPath, const std::vector<std::string>& specs,
+                        std::vector<ColumnarColumnReport>& report, std::string& error)
+{
+    ColumnarTable input;
+    if (!readColumnarFile(inPath, input, error)) {
+        return false;
+    }
+    std::vector<ColumnarFormat> formats(input.names.size());
+    for (const std::string& spec : specs) {
+        if (!parseColumnarFormat(spec, input.names, formats, error)) {
+            return false;
+        }
+    }
+    ColumnarWriter writer;
+    if (!writer.open(outPath, input.names, input.metadata, false, error) || !writer.setFormats(formats, error)) {
+        return false;
+    }
+    std::vector<const double*> columns(input.names.size());
+    std::size_t offset = 0;
+    for (const ColumnarGroupHeader& group : input.groups) {
+        for (std::size_t c = 0; c < columns.size(); c++) {
+            columns[c] = input.columns[c].data() + offset;
+        }
+        if (!writer.writeGroup(group.firstRow, columns.data(), group.rows)) {
+            error = "cannot write " + outPath;
+            return false;
+        }
+        offset += group.rows;
+    }
+    if (!writer.close()) {
+        error = "cannot write " + outPath;
+        return false;
+    }
+
+    ColumnarTable output;
+    if (!readColumnarFile(outPath, output, error)) {
+        return false;
+    }
+    report.assign(input.names.size(), ColumnarColumnReport());
+    for (std::size_t c = 0; c < report.size(); c++) {
+        ColumnarColumnReport& column = report[c];
+        column.name = input.names[c];
+        column.inputBytes = input.columnBytes[c];
+        column.outputBytes = output.columnBytes[c];
+        for (std::size_t row = 0; row < input.rows(); row++) {
+            double before = input.columns[c][row];
+            double after = output.columns[c][row];
+            if (before == after || (std::isnan(before) && std::isnan(after))) {
+                continue;
+            }
+            double difference = std::fabs(after - before);
+            column.maxError = std::max(column.maxError, std::isnan(difference) ? HUGE_VAL : difference);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,131 @@
+#ifndef COLUMNARWRITER_H
+#define COLUMNARWRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Append-only columnar result file ("TCOL"), written in row groups that
+// store each column contiguously:
+//   header: char magic[4] = "TCOL", uint16 version = 2, uint16 column count,
+//           uint32 metadata length, then per column uint8 name length + name,
+//           then the metadata (version 1 had none and the length was 0)
+//   group:  ColumnarGroupHeader, then per column ColumnarColumnHeader + data
+//   fixed column data: ColumnarFixedHeader, one uint8 bit width per block of
+//           64 rows, the blocks' codes bit-packed little-endian (8 * width
+//           bytes each, the last block padded too), 8 zero bytes, then per
+//           exception uint32 row + float64 value
+// A group counts only if its checksum matches, so a file cut off mid-write
+// (crash, kill) still reads back every group before the torn one, and a
+// resumed writer truncates the torn tail and carries on from there.
+
+struct ColumnarGroupHeader {
+    uint64_t firstRow = 0; // row index of the group's first row, e.g. a sweep grid index
+    uint32_t rows = 0;
+    uint32_t checksum = 0; // over the column headers and data that follow
+};
+
+enum ColumnarEncoding : uint8_t {
+    Columnar_Float64 = 0,    // rows little-endian float64 values
+    Columnar_Float32 = 1,    // rows float32 values, about 7 significant digits
+    Columnar_Float16 = 2,    // rows IEEE half values, about 3 digits and |x| up to 65504
+    Columnar_Fixed = 3,      // value = (base + code) * step; non-finite values are exceptions
+    Columnar_FixedDelta = 4, // the same over differences of consecutive rows, for sorted or smooth columns
+};
+
+struct ColumnarColumnHeader {
+    uint8_t encoding = Columnar_Float64;
+    uint8_t reference = 0; // fixed encodings: 1 + index of an earlier column subtracted first, 0 none
+    uint8_t reserved[2] = {0, 0};
+    uint32_t bytes = 0; // size of the column data that follows
+};
+
+// Decoding a fixed column: q[i] = base + code[i], prefix-summed for
+// FixedDelta, plus round(reference[i] / step) of the decoded reference
+// column, times step; exception rows then take their stored value.
+struct ColumnarFixedHeader {
+    double step = 0;
+    int64_t base = 0;
+    uint32_t exceptions = 0;
+    uint32_t reserved = 0;
+};
+
+// How the writer stores one column. Fixed encodings keep every finite value
+// within maxError, except that a column group whose codes would need more
+// than 56 bits (a range over 2^56 steps) falls back to float64.
+struct ColumnarFormat {
+    ColumnarEncoding encoding = Columnar_Float64;
+    double maxError = 0; // fixed encodings: the absolute error bound, > 0
+    int reference = -1;  // fixed encodings: an earlier column that predicts this one, e.g. HeightBH from HeightAH
+};
+
+// Parses "column=encoding" into formats[column], with encoding one of
+// float64, float32, float16, fixed:MAXERROR or delta:MAXERROR, optionally
+// followed by @REFERENCE. Column "*" sets every column.
+bool parseColumnarFormat(const std::string& text, const std::vector<std::string>& columns,
+                         std::vector<ColumnarFormat>& formats, std::string& error);
+
+class ColumnarWriter
+{
+public:
+    ~ColumnarWriter();
+
+    // Creates path, or with resume reopens it: the column names and the
+    // metadata (free text describing what produced the rows, e.g. a sweep's
+    // grid) must match and a torn last group is cut off. Returns false and
+    // sets error on failure.
+    bool open(const std::string& path, const std::vector<std::string>& columns, const std::string& metadata,
+              bool resume, std::string& error);
+    // Per column formats for the groups written from now on, one per column
+    // (all float64 by default). Returns false and sets error for a bad one.
+    bool setFormats(const std::vector<ColumnarFormat>& formats, std::string& error);
+
+    bool hasGroups() const { return groups > 0; }
+    uint64_t endRow() const { return nextRow; } // one past the last row of the last complete group
+
+    // columns[c] points at rows values of column c, in open() order.
+    bool writeGroup(uint64_t firstRow, const double* const* columns, uint32_t rows);
+    bool close();
+
+private:
+    std::ofstream out;
+    std::size_t columnCount = 0;
+    std::size_t groups = 0;
+    uint64_t nextRow = 0;
+    std::vector<ColumnarFormat> formats;
+    std::vector<char> referenced; // columns another column predicts from
+    std::vector<std::vector<double>> decoded; // their values as a reader will see them
+    std::vector<char> buffer;
+    std::vector<int64_t> scratch;
+};
+
+struct ColumnarTable {
+    std::vector<std::string> names;
+    std::string metadata;
+    std::vector<std::vector<double>> columns;
+    std::vector<ColumnarGroupHeader> groups;
+    std::vector<uint64_t> columnBytes; // stored size per column, column headers included
+    bool torn = false; // the file ended in an incomplete group, which was skipped
+
+    std::size_t rows() const { return columns.empty() ? 0 : columns[0].size(); }
+};
+
+// Reads every complete group. Returns false and sets error for a bad header.
+bool readColumnarFile(const std::string& path, ColumnarTable& table, std::string& error);
+
+struct ColumnarColumnReport {
+    std::string name;
+    uint64_t inputBytes = 0;
+    uint64_t outputBytes = 0;
+    double maxError = 0; // largest |output - input|; infinite where a NaN or infinity was not kept
+};
+
+// Rewrites every group of inPath to outPath with the formats given as
+// parseColumnarFormat specs, reads the result back and reports the size and
+// the largest error of each column.
+bool recodeColumnarFile(const std::string& inPath, const std::string& outPath, const std::vector<std::string>& specs,
+                        std::vector<ColumnarColumnReport>& report, std::string& error);
+
+#endif // COLUMNARWRITER_H
@@ -0,0 +1,99 @@
+#include "csvImportWorker.h"
+#include "batchPipeline.h"
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+// How often solved rows and progress are handed to the GUI thread
+const qint64 UpdateIntervalMs = 100;
+
+// Whether the solver produced a triangle: every side, angle and the area
+// positive. AB alone says nothing, since it is usually an input; rows with no
+// solution come back with NaN or zeros in the derived fields instead.
+bool hasSolution(const TriangleValues &row)
+{
+    return row.AB > 0 && row.AC > 0 && row.BC > 0 && row.angleA > 0 && row.angleB > 0 && row.angleC > 0
+        && row.Area > 0;
+}
+
+}
+
+CsvImportWorker::CsvImportWorker(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void CsvImportWorker::cancel()
+{
+    cancelRequested.store(true, std::memory_order_relaxed);
+}
+
+void CsvImportWorker::resetCancel()
+{
+    cancelRequested.store(false, std::memory_order_relaxed);
+}
+
+void CsvImportWorker::importFile(const QString &path)
+{
+    std::ifstream in(QFile::encodeName(path).constData(), std::ios::binary);
+    if (!in) {
+        emit failed("Cannot open " + path);
+        return;
+    }
+    run(in, std::size_t(QFileInfo(path).size()));
+}
+
+void CsvImportWorker::importText(const QString &text)
+{
+    std::istringstream in(text.toStdString());
+    run(in, in.str().size());
+}
+
+void CsvImportWorker::run(std::istream &in, std::size_t totalBytes)
+{
+    std::atomic<std::size_t> bytesRead{0};
+
+    PipelineOptions options;
+    options.cancel = &cancelRequested;
+    options.bytesRead = &bytesRead;
+
+    QVector<TriangleValues> pending;
+    qulonglong rows = 0;
+    qulonglong unsolvedRows = 0;
+    QElapsedTimer clock;
+    clock.start();
+    qint64 lastUpdate = 0;
+
+    auto flush = [&] {
+        if (!pending.isEmpty()) {
+            emit rowsSolved(pending);
+            pending.clear();
+        }
+        double seconds = clock.elapsed() / 1000.0;
+        int percent = totalBytes ? int(100.0 * bytesRead.load(std::memory_order_relaxed) / totalBytes) : 100;
+        emit progress(qMin(percent, 100), rows, seconds > 0 ? rows / seconds : 0);
+    };
+
+    PipelineStats stats = runBatchPipeline(in, [&](const TriangleValues *solved, std::size_t count) {
+        for (std::size_t i = 0; i < count; i++) {
+            // Unparseable rows (all NaN) and unsolvable ones are only counted
+            if (hasSolution(solved[i])) {
+                pending.append(solved[i]);
+                rows++;
+            } else {
+                unsolvedRows++;
+            }
+        }
+        if (clock.elapsed() - lastUpdate >= UpdateIntervalMs) {
+            lastUpdate = clock.elapsed();
+            flush();
+        }
+    }, options);
+    flush();
+
+    emit finished(rows, stats.invalidRows, unsolvedRows - stats.invalidRows, stats.cancelled);
+}
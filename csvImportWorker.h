@@ -0,0 +1,47 @@
+#ifndef CSVIMPORTWORKER_H
+#define CSVIMPORTWORKER_H
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <cstddef>
+#include <iosfwd>
+#include "triangleCore.h"
+
+Q_DECLARE_METATYPE(TriangleValues)
+
+// Solves a CSV of triangles (the batch pipeline's row format) off the GUI
+// thread. Lives on its own QThread; solved rows come back in input order
+// through rowsSolved, a few times a second, so the window stays responsive.
+class CsvImportWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CsvImportWorker(QObject *parent = nullptr);
+
+    // Safe to call from any thread. Rows already read are still delivered.
+    void cancel();
+    // Call before queuing an import, not from the worker: a cancel() made
+    // while the import is still queued must stick.
+    void resetCancel();
+
+public slots:
+    void importFile(const QString &path);
+    void importText(const QString &text);
+
+signals:
+    void rowsSolved(const QVector<TriangleValues> &rows);
+    void progress(int percent, qulonglong rows, double rowsPerSecond);
+    // invalidRows could not be parsed; unsolvedRows parsed but had no solution.
+    void finished(qulonglong rows, qulonglong invalidRows, qulonglong unsolvedRows, bool cancelled);
+    void failed(const QString &message);
+
+private:
+    void run(std::istream &in, std::size_t totalBytes);
+
+    std::atomic<bool> cancelRequested{false};
+};
+
+#endif // CSVIMPORTWORKER_H
@@ -0,0 +1,425 @@
+#include "derivationPlanner.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+namespace {
+
+// Sides are indexed by the vertex they face, like the angles: side[0] = BC
+// faces A. Rotating (i, j, k) through the vertices gives every formula
+// three times.
+const int kSide[3] = {Field_BC, Field_AC, Field_AB};
+const int kAngle[3] = {Field_angleA, Field_angleB, Field_angleC};
+const int kMedian[3] = {Field_median_AM, Field_median_BM, Field_median_CM};
+const int kBisector[3] = {Field_BisectorA, Field_BisectorB, Field_BisectorC};
+const int kHeight[3] = {Field_HeightAH, Field_HeightBH, Field_HeightCH};
+
+inline double square(double x)
+{
+    return x * x;
+}
+
+// acos/asin in degrees, with the argument clamped against rounding just past +-1.
+inline double acosDegrees(double x)
+{
+    return toDegrees(std::acos(std::clamp(x, -1.0, 1.0)));
+}
+
+inline double asinDegrees(double x)
+{
+    return toDegrees(std::asin(std::clamp(x, -1.0, 1.0)));
+}
+
+// Heron's formula in Kahan's form, accurate for needle-shaped triangles.
+double heron(double a, double b, double c)
+{
+    if (a < b) {
+        std::swap(a, b);
+    }
+    if (b < c) {
+        std::swap(b, c);
+    }
+    if (a < b) {
+        std::swap(a, b);
+    }
+    return 0.25 * std::sqrt((a + (b + c)) * (c - (a - b)) * (c + (a - b)) * (a + (b - c)));
+}
+
+// The evaluators read their inputs in the order the formula lists them.
+#define IN(n) v[in[n]]
+
+double lawOfCosinesSide(const double* v, const uint8_t* in) // b, c, A
+{
+    return std::sqrt(square(IN(0)) + square(IN(1)) - 2 * IN(0) * IN(1) * cosDegrees(IN(2)));
+}
+
+double lawOfSinesSide(const double* v, const uint8_t* in) // b, A, B
+{
+    return IN(0) * sinDegrees(IN(1)) / sinDegrees(IN(2));
+}
+
+double medianOppositeSide(const double* v, const uint8_t* in) // b, c, m_a
+{
+    return std::sqrt(2 * square(IN(0)) + 2 * square(IN(1)) - 4 * square(IN(2)));
+}
+
+double medianAdjacentSide(const double* v, const uint8_t* in) // b, c, m_b -> a
+{
+    return std::sqrt((4 * square(IN(2)) + square(IN(0)) - 2 * square(IN(1))) / 2);
+}
+
+double sideFromMedians(const double* v, const uint8_t* in) // m_a, m_b, m_c -> a
+{
+    return (2.0 / 3.0) * std::sqrt(2 * square(IN(1)) + 2 * square(IN(2)) - square(IN(0)));
+}
+
+double bisectorOppositeSide(const double* v, const uint8_t* in) // b, c, t_a
+{
+    return (IN(0) + IN(1)) * std::sqrt(1 - square(IN(2)) / (IN(0) * IN(1)));
+}
+
+double bisectorAdjacentSide(const double* v, const uint8_t* in) // c, A, t_a -> b
+{
+    return IN(2) * IN(0) / (2 * IN(0) * cosDegrees(0.5 * IN(1)) - IN(2));
+}
+
+double sideFromArea(const double* v, const uint8_t* in) // Area, h_a -> a
+{
+    return 2 * IN(0) / IN(1);
+}
+
+double sideFromHeight(const double* v, const uint8_t* in) // h_a, B -> c
+{
+    return IN(0) / sinDegrees(IN(1));
+}
+
+double lawOfCosinesAngle(const double* v, const uint8_t* in) // a, b, c
+{
+    return acosDegrees((square(IN(1)) + square(IN(2)) - square(IN(0))) / (2 * IN(1) * IN(2)));
+}
+
+double angleSum(const double* v, const uint8_t* in) // B, C
+{
+    return 180 - IN(0) - IN(1);
+}
+
+double angleFromArea(const double* v, const uint8_t* in) // b, c, Area
+{
+    return asinDegrees(2 * IN(2) / (IN(0) * IN(1)));
+}
+
+double lawOfSinesAngle(const double* v, const uint8_t* in) // a, b, B
+{
+    return asinDegrees(IN(0) * sinDegrees(IN(2)) / IN(1));
+}
+
+double angleFromBisector(const double* v, const uint8_t* in) // b, c, t_a
+{
+    return 2 * acosDegrees(IN(2) * (IN(0) + IN(1)) / (2 * IN(0) * IN(1)));
+}
+
+double angleFromHeight(const double* v, const uint8_t* in) // c, h_b
+{
+    return asinDegrees(IN(1) / IN(0));
+}
+
+double areaFromAngle(const double* v, const uint8_t* in) // b, c, A
+{
+    return 0.5 * IN(0) * IN(1) * sinDegrees(IN(2));
+}
+
+double areaFromSides(const double* v, const uint8_t* in) // a, b, c
+{
+    return heron(IN(0), IN(1), IN(2));
+}
+
+double areaFromHeight(const double* v, const uint8_t* in) // a, h_a
+{
+    return 0.5 * IN(0) * IN(1);
+}
+
+double areaFromMedians(const double* v, const uint8_t* in) // m_a, m_b, m_c
+{
+    return (4.0 / 3.0) * heron(IN(0), IN(1), IN(2));
+}
+
+double median(const double* v, const uint8_t* in) // a, b, c
+{
+    return 0.5 * std::sqrt(2 * square(IN(1)) + 2 * square(IN(2)) - square(IN(0)));
+}
+
+double bisectorFromAngle(const double* v, const uint8_t* in) // b, c, A
+{
+    return 2 * IN(0) * IN(1) * cosDegrees(0.5 * IN(2)) / (IN(0) + IN(1));
+}
+
+double bisectorFromSides(const double* v, const uint8_t* in) // a, b, c
+{
+    return std::sqrt(IN(1) * IN(2) * (1 - square(IN(0)) / square(IN(1) + IN(2))));
+}
+
+double heightFromArea(const double* v, const uint8_t* in) // Area, a
+{
+    return 2 * IN(0) / IN(1);
+}
+
+double heightFromAngle(const double* v, const uint8_t* in) // c, B
+{
+    return IN(0) * sinDegrees(IN(1));
+}
+
+double inRadius(const double* v, const uint8_t* in) // Area, a, b, c
+{
+    return 2 * IN(0) / (IN(1) + IN(2) + IN(3));
+}
+
+double circumRadiusFromArea(const double* v, const uint8_t* in) // Area, a, b, c
+{
+    return IN(1) * IN(2) * IN(3) / (4 * IN(0));
+}
+
+double circumRadiusFromAngle(const double* v, const uint8_t* in) // a, A
+{
+    return IN(0) / (2 * sinDegrees(IN(1)));
+}
+
+#undef IN
+
+std::vector<DerivationFormula> buildFormulas()
+{
+    std::vector<DerivationFormula> formulas;
+    auto add = [&](const char* name, int target, std::initializer_list<int> inputs,
+                   double (*evaluate)(const double*, const uint8_t*), double cost, double conditioning) {
+        DerivationFormula formula{name, uint8_t(target), uint8_t(inputs.size()), {}, evaluate, cost, conditioning};
+        std::copy(inputs.begin(), inputs.end(), formula.inputs);
+        formulas.push_back(formula);
+    };
+    for (int i = 0; i < 3; i++) {
+        const int j = (i + 1) % 3;
+        const int k = (i + 2) % 3;
+        const int a = kSide[i], b = kSide[j], c = kSide[k];
+        const int A = kAngle[i], B = kAngle[j], C = kAngle[k];
+        const int ma = kMedian[i], mb = kMedian[j], mc = kMedian[k];
+        const int ta = kBisector[i], ha = kHeight[i], hb = kHeight[j], hc = kHeight[k];
+
+        add("law of cosines", a, {b, c, A}, lawOfCosinesSide, 22, 1);
+        add("law of sines", a, {b, A, B}, lawOfSinesSide, 25, 0.5);
+        add("law of sines", a, {c, A, C}, lawOfSinesSide, 25, 0.5);
+        add("median", a, {b, c, ma}, medianOppositeSide, 12, 2);
+        add("median", a, {b, c, mb}, medianAdjacentSide, 14, 2);
+        add("median", a, {c, b, mc}, medianAdjacentSide, 14, 2);
+        add("three medians", a, {ma, mb, mc}, sideFromMedians, 14, 1);
+        add("bisector", a, {b, c, ta}, bisectorOppositeSide, 16, 1);
+        add("angle bisector", b, {c, A, ta}, bisectorAdjacentSide, 22, 1);
+        add("angle bisector", c, {b, A, ta}, bisectorAdjacentSide, 22, 1);
+        add("area and height", a, {Field_Area, ha}, sideFromArea, 5, 0);
+        add("height", c, {ha, B}, sideFromHeight, 15, 0.5);
+        add("height", b, {ha, C}, sideFromHeight, 15, 0.5);
+
+        add("law of cosines", A, {a, b, c}, lawOfCosinesAngle, 30, 1);
+        add("angle sum", A, {B, C}, angleSum, 2, 0);
+        add("area", A, {b, c, Field_Area}, angleFromArea, 25, 4);
+        add("law of sines", A, {a, b, B}, lawOfSinesAngle, 35, 4);
+        add("law of sines", A, {a, c, C}, lawOfSinesAngle, 35, 4);
+        add("bisector", A, {b, c, ta}, angleFromBisector, 30, 1);
+        add("height", A, {c, hb}, angleFromHeight, 25, 4);
+        add("height", A, {b, hc}, angleFromHeight, 25, 4);
+
+        add("two sides and angle", Field_Area, {b, c, A}, areaFromAngle, 13, 0);
+        add("base and height", Field_Area, {a, ha}, areaFromHeight, 2, 0);
+
+        add("median", ma, {a, b, c}, median, 10, 0);
+        add("bisector", ta, {b, c, A}, bisectorFromAngle, 18, 0);
+        add("bisector", ta, {a, b, c}, bisectorFromSides, 16, 0.5);
+        add("area", ha, {Field_Area, a}, heightFromArea, 5, 0);
+        add("height", ha, {c, B}, heightFromAngle, 11, 0);
+        add("height", ha, {b, C}, heightFromAngle, 11, 0);
+        add("circumradius", Field_circumRadius, {a, A}, circumRadiusFromAngle, 15, 0.5);
+    }
+    add("Heron", Field_Area, {Field_BC, Field_AC, Field_AB}, areaFromSides, 20, 0.5);
+    add("three medians", Field_Area, {Field_median_AM, Field_median_BM, Field_median_CM}, areaFromMedians, 22, 0.5);
+    add("inradius", Field_inRadius, {Field_Area, Field_BC, Field_AC, Field_AB}, inRadius, 7, 0);
+    add("circumradius", Field_circumRadius, {Field_Area, Field_BC, Field_AC, Field_AB}, circumRadiusFromArea, 8, 0);
+    return formulas;
+}
+
+}
+
+const std::vector<DerivationFormula>& derivationFormulas()
+{
+    static const std::vector<DerivationFormula> formulas = buildFormulas();
+    return formulas;
+}
+
+// Each round settles the unknown field with the cheapest formula whose
+// inputs are all settled, at the formula's weight plus the cost of reaching
+// its inputs. Reaching a field never gets cheaper once settled, so the
+// settling order is an execution order.
+DerivationPlan planDerivation(uint32_t knownMask, const PlannerOptions& options)
+{
+    const std::vector<DerivationFormula>& formulas = derivationFormulas();
+    const uint32_t inputMask = (1u << InputFieldCount) - 1;
+    DerivationPlan plan;
+    plan.knownMask = knownMask & inputMask;
+    double reach[FieldCount] = {};
+    uint32_t settled = plan.knownMask;
+    for (;;) {
+        int best = -1;
+        double bestCost = std::numeric_limits<double>::infinity();
+        for (std::size_t f = 0; f < formulas.size(); f++) {
+            const DerivationFormula& formula = formulas[f];
+            if (settled & (1u << formula.target)) {
+                continue;
+            }
+            double cost = formula.cost + options.conditioningWeight * formula.conditioning;
+            bool ready = true;
+            for (int n = 0; n < formula.inputCount && ready; n++) {
+                ready = settled & (1u << formula.inputs[n]);
+                cost += reach[formula.inputs[n]];
+            }
+            if (ready && cost < bestCost) {
+                best = int(f);
+                bestCost = cost;
+            }
+        }
+        if (best < 0) {
+            break;
+        }
+        const DerivationFormula& formula = formulas[best];
+        reach[formula.target] = bestCost;
+        settled |= 1u << formula.target;
+        plan.derivedMask |= 1u << formula.target;
+        plan.cost += formula.cost + options.conditioningWeight * formula.conditioning;
+        plan.steps.push_back(uint16_t(best));
+    }
+    return plan;
+}
+
+std::string describePlan(const DerivationPlan& plan)
+{
+    const std::vector<DerivationFormula>& formulas = derivationFormulas();
+    std::string text = "known:";
+    for (int field = 0; field < InputFieldCount; field++) {
+        if (plan.knownMask & (1u << field)) {
+            text += std::string(" ") + kTriangleFieldNames[field];
+        }
+    }
+    text += "\n";
+    char line[160];
+    for (uint16_t step : plan.steps) {
+        const DerivationFormula& formula = formulas[step];
+        std::string call = std::string(kTriangleFieldNames[formula.target]) + " = " + formula.name + "(";
+        for (int n = 0; n < formula.inputCount; n++) {
+            call += std::string(n ? ", " : "") + kTriangleFieldNames[formula.inputs[n]];
+        }
+        call += ")";
+        std::snprintf(line, sizeof line, "  %-48s cost %g  conditioning %g\n", call.c_str(), formula.cost,
+                      formula.conditioning);
+        text += line;
+    }
+    std::snprintf(line, sizeof line, "total weight %g\n", plan.cost);
+    text += line;
+    uint32_t unreached = ((1u << FieldCount) - 1) & ~(plan.knownMask | plan.derivedMask);
+    if (unreached) {
+        text += "not reached:";
+        for (int field = 0; field < FieldCount; field++) {
+            if (unreached & (1u << field)) {
+                text += std::string(" ") + kTriangleFieldNames[field];
+            }
+        }
+        text += "\n";
+    }
+    return text;
+}
+
+DerivationPlanner::DerivationPlanner(const PlannerOptions& options)
+    : options(options), plans(new std::atomic<DerivationPlan*>[std::size_t(1) << InputFieldCount])
+{
+    for (std::size_t mask = 0; mask < (std::size_t(1) << InputFieldCount); mask++) {
+        plans[mask].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+DerivationPlanner::~DerivationPlanner()
+{
+    for (std::size_t mask = 0; mask < (std::size_t(1) << InputFieldCount); mask++) {
+        delete plans[mask].load(std::memory_order_relaxed);
+    }
+}
+
+const DerivationPlan& DerivationPlanner::plan(uint32_t knownMask)
+{
+    std::atomic<DerivationPlan*>& slot = plans[knownMask & ((1u << InputFieldCount) - 1)];
+    DerivationPlan* cached = slot.load(std::memory_order_acquire);
+    if (cached) {
+        return *cached;
+    }
+    DerivationPlan* built = new DerivationPlan(planDerivation(knownMask, options));
+    if (slot.compare_exchange_strong(cached, built, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        planCount.fetch_add(1, std::memory_order_relaxed);
+        return *built;
+    }
+    delete built;
+    return *cached;
+}
+
+const DerivationPlan& DerivationPlanner::solve(TriangleValues& values)
+{
+    const DerivationPlan& chosen = plan(knownMask(values));
+    const std::vector<DerivationFormula>& formulas = derivationFormulas();
+    values.inRadius = 0;
+    values.circumRadius = 0;
+    double* v = &values.AB;
+    for (uint16_t step : chosen.steps) {
+        const DerivationFormula& formula = formulas[step];
+        v[formula.target] = formula.evaluate(v, formula.inputs);
+    }
+    return chosen;
+}
+
+void DerivationPlanner::solveBatch(const TriangleValues* inputs, TriangleValues* outputs, std::size_t count)
+{
+    if (count == 0) {
+        return;
+    }
+    // Counting sort by knownMask, so each plan is looked up once and its
+    // steps run as loops over the rows that share it.
+    const std::size_t masks = std::size_t(1) << InputFieldCount;
+    std::vector<uint32_t> rowMask(count);
+    std::vector<uint32_t> start(masks + 1, 0);
+    for (std::size_t i = 0; i < count; i++) {
+        rowMask[i] = knownMask(inputs[i]);
+        start[rowMask[i] + 1]++;
+    }
+    for (std::size_t mask = 0; mask < masks; mask++) {
+        start[mask + 1] += start[mask];
+    }
+    std::vector<uint32_t> order(count);
+    {
+        std::vector<uint32_t> next(start.begin(), start.end() - 1);
+        for (std::size_t i = 0; i < count; i++) {
+            order[next[rowMask[i]]++] = uint32_t(i);
+        }
+    }
+
+    for (std::size_t i = 0; i < count; i++) {
+        outputs[i] = inputs[i];
+        outputs[i].inRadius = 0;
+        outputs[i].circumRadius = 0;
+    }
+    const std::vector<DerivationFormula>& formulas = derivationFormulas();
+    for (std::size_t first = 0; first < count;) {
+        uint32_t mask = rowMask[order[first]];
+        std::size_t last = start[mask + 1];
+        const DerivationPlan& chosen = plan(mask);
+        for (uint16_t step : chosen.steps) {
+            const DerivationFormula& formula = formulas[step];
+            for (std::size_t n = first; n < last; n++) {
+                double* v = &outputs[order[n]].AB;
+                v[formula.target] = formula.evaluate(v, formula.inputs);
+            }
+        }
+        first = last;
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef DERIVATIONPLANNER_H
+#define DERIVATIONPLANNER_H
+
+#include "triangleCore.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// solveTriangle takes the first branch whose knowns are present, even when
+// a later one would be cheaper or better conditioned, and has no branch at
+// all for many input sets. The planner instead treats the 18 quantities as
+// nodes and every formula as a weighted edge from its inputs to its target,
+// and finds the cheapest way to reach each unknown from the knowns of a row
+// (a Knuth-style shortest-path search over the formula hypergraph). Plans
+// depend only on the knownMask, so each is built once and replayed for
+// every row with that mask.
+
+// One formula: target = evaluate(values) from the fields in inputs.
+struct DerivationFormula {
+    const char* name;
+    uint8_t target;
+    uint8_t inputCount;
+    uint8_t inputs[4];
+    double (*evaluate)(const double* values, const uint8_t* inputs); // values in TriangleField order
+    double cost;         // rough operation count: 1 per add or multiply, more for division, sqrt and trig
+    double conditioning; // 0 well conditioned, 1-2 cancellation or acos near +-1, 4 asin that assumes an acute angle
+};
+
+// Every formula the planner knows, one entry per rotation of the vertices.
+const std::vector<DerivationFormula>& derivationFormulas();
+
+struct PlannerOptions {
+    // Cost units one unit of conditioning is worth; 0 plans for speed alone.
+    double conditioningWeight = 10;
+};
+
+struct DerivationPlan {
+    uint32_t knownMask = 0;
+    uint32_t derivedMask = 0;    // fields the steps fill in; known | derived may miss some fields
+    double cost = 0;             // summed weight (cost + conditioningWeight * conditioning) of the steps
+    std::vector<uint16_t> steps; // derivationFormulas() indices in execution order
+};
+
+DerivationPlan planDerivation(uint32_t knownMask, const PlannerOptions& options = PlannerOptions());
+// One line per step ("BC = law of cosines(AC, AB, angleA)  cost 22  conditioning 1"),
+// then the fields the plan cannot reach, for logs and --plan.
+std::string describePlan(const DerivationPlan& plan);
+
+// Plans cached per knownMask. Lookups never lock: a missing plan is built by
+// the calling thread and published with one CAS; a thread that loses the
+// race drops its copy.
+class DerivationPlanner
+{
+public:
+    explicit DerivationPlanner(const PlannerOptions& options = PlannerOptions());
+    ~DerivationPlanner();
+    DerivationPlanner(const DerivationPlanner&) = delete;
+    DerivationPlanner& operator=(const DerivationPlanner&) = delete;
+
+    const DerivationPlan& plan(uint32_t knownMask);
+
+    // Replays the plan for values' knownMask in place. Fields the plan does
+    // not reach keep their input, except inRadius and circumRadius, which
+    // start at 0 as in solveTriangle. Returns the plan used.
+    const DerivationPlan& solve(TriangleValues& values);
+    // The same for count rows; inputs and outputs may be the same array.
+    // Rows are grouped by knownMask and each plan runs step by step over its rows.
+    void solveBatch(const TriangleValues* inputs, TriangleValues* outputs, std::size_t count);
+
+    std::size_t cachedPlans() const { return planCount.load(std::memory_order_relaxed); }
+
+private:
+    PlannerOptions options;
+    std::unique_ptr<std::atomic<DerivationPlan*>[]> plans; // indexed by knownMask
+    std::atomic<std::size_t> planCount{0};
+};
+
+#endif // DERIVATIONPLANNER_H
@@ -0,0 +1,93 @@
+#ifndef DUALNUMBER_H
+#define DUALNUMBER_H
+
+#include <cmath>
+
+// Forward-mode dual number: a value and its derivatives against N seeded
+// inputs. Running solveTriangleT over Dual<N> carries the derivatives of
+// every output through the same branch the plain solve takes.
+// Comparisons only look at the value, so branching is unchanged.
+template <int N>
+struct Dual {
+    double value = 0;
+    double d[N] = {};
+
+    Dual() = default;
+    Dual(double v) : value(v) {}
+
+    static Dual seed(double v, int input) {
+        Dual x(v);
+        x.d[input] = 1;
+        return x;
+    }
+
+    friend Dual operator+(const Dual& a, const Dual& b) {
+        Dual r(a.value + b.value);
+        for (int i = 0; i < N; i++) r.d[i] = a.d[i] + b.d[i];
+        return r;
+    }
+    friend Dual operator-(const Dual& a, const Dual& b) {
+        Dual r(a.value - b.value);
+        for (int i = 0; i < N; i++) r.d[i] = a.d[i] - b.d[i];
+        return r;
+    }
+    friend Dual operator*(const Dual& a, const Dual& b) {
+        Dual r(a.value * b.value);
+        for (int i = 0; i < N; i++) r.d[i] = a.d[i] * b.value + a.value * b.d[i];
+        return r;
+    }
+    friend Dual operator/(const Dual& a, const Dual& b) {
+        double inverse = 1 / b.value;
+        Dual r(a.value * inverse);
+        for (int i = 0; i < N; i++) r.d[i] = (a.d[i] - r.value * b.d[i]) * inverse;
+        return r;
+    }
+    friend Dual operator-(const Dual& a) {
+        return scaled(a, -a.value, -1);
+    }
+
+    // Mixed forms skip the zero derivatives of a constant operand.
+    friend Dual operator+(const Dual& a, double b) { return shifted(a, a.value + b); }
+    friend Dual operator+(double a, const Dual& b) { return shifted(b, a + b.value); }
+    friend Dual operator-(const Dual& a, double b) { return shifted(a, a.value - b); }
+    friend Dual operator-(double a, const Dual& b) { return scaled(b, a - b.value, -1); }
+    friend Dual operator*(const Dual& a, double b) { return scaled(a, a.value * b, b); }
+    friend Dual operator*(double a, const Dual& b) { return scaled(b, a * b.value, a); }
+    friend Dual operator/(const Dual& a, double b) { return scaled(a, a.value / b, 1 / b); }
+    friend Dual operator/(double a, const Dual& b) {
+        double value = a / b.value;
+        return scaled(b, value, -value / b.value);
+    }
+
+    friend bool operator>(const Dual& a, double b) { return a.value > b; }
+    friend bool operator<(const Dual& a, double b) { return a.value < b; }
+    friend bool operator>(const Dual& a, const Dual& b) { return a.value > b.value; }
+    friend bool operator<(const Dual& a, const Dual& b) { return a.value < b.value; }
+
+    friend Dual sqrt(const Dual& a) {
+        double value = std::sqrt(a.value);
+        return scaled(a, value, 0.5 / value);
+    }
+    friend Dual sin(const Dual& a) { return scaled(a, std::sin(a.value), std::cos(a.value)); }
+    friend Dual cos(const Dual& a) { return scaled(a, std::cos(a.value), -std::sin(a.value)); }
+    friend Dual tan(const Dual& a) {
+        double value = std::tan(a.value);
+        return scaled(a, value, 1 + value * value);
+    }
+    friend Dual asin(const Dual& a) { return scaled(a, std::asin(a.value), 1 / std::sqrt(1 - a.value * a.value)); }
+    friend Dual acos(const Dual& a) { return scaled(a, std::acos(a.value), -1 / std::sqrt(1 - a.value * a.value)); }
+
+private:
+    static Dual shifted(const Dual& a, double value) {
+        Dual r = a;
+        r.value = value;
+        return r;
+    }
+    static Dual scaled(const Dual& a, double value, double slope) {
+        Dual r(value);
+        for (int i = 0; i < N; i++) r.d[i] = a.d[i] * slope;
+        return r;
+    }
+};
+
+#endif // DUALNUMBER_H
@@ -0,0 +1,450 @@
+#include "feasibility.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+enum BranchFamily : uint8_t {
+    Family_None,             // no solver branch: underdetermined
+    Family_SAS,              // two sides and the angle between them
+    Family_AreaSides,        // two sides and the area
+    Family_ASA,              // two angles and a side
+    Family_TwoAngles,        // two angles and no usable side: only the third angle comes out
+    Family_SSS,
+    Family_Median,           // a median and two sides
+    Family_BisectorBetween,  // a bisector and the two sides around it
+    Family_BisectorOpposite, // a bisector, the side opposite it and one more
+    Family_BisectorOppositeScaled, // the same, written 4p^2 - (x+y)^2 instead of 4p^2/(x+y)^2 - 1
+    Family_AngleBisector,    // an angle, a side next to it and its bisector
+    Family_Unchecked,        // a solver branch with no rule below; never rejected
+    FamilyCount
+};
+
+// Sides of the law of sines step asin(num * sin / den): the two sides the
+// branch starts from, or the third one it computes.
+enum SideRole : uint8_t { Role_S1, Role_S2, Role_Z };
+
+struct BranchRule {
+    uint32_t needs;      // TriangleBranch::needs of the branch this rule checks
+    uint8_t family;
+    uint8_t x, y;        // the two sides (for Family_AngleBisector: the side and the bisector)
+    uint8_t p, q;        // angle, area, median, bisector or third side; q is the second angle of ASA
+    uint8_t num, den;
+    bool lawOfSines;     // den is opposite the known angle, so asin gives the angle opposite num
+    double alpha, beta, gamma; // median: third side^2 = alpha p^2 + beta x^2 + gamma y^2
+};
+
+constexpr uint32_t bits(int a, int b, int c)
+{
+    return (1u << a) | (1u << b) | (1u << c);
+}
+
+constexpr BranchRule sas(int x, int y, int angle, SideRole num)
+{
+    return {bits(x, y, angle), Family_SAS, uint8_t(x), uint8_t(y), uint8_t(angle), uint8_t(angle),
+            num, Role_Z, true, 0, 0, 0};
+}
+
+constexpr BranchRule areaSides(int x, int y, SideRole num, SideRole den)
+{
+    return {bits(x, y, Field_Area), Family_AreaSides, uint8_t(x), uint8_t(y), Field_Area, Field_Area,
+            num, den, den == Role_Z, 0, 0, 0};
+}
+
+constexpr BranchRule asa(int angle1, int angle2, int side)
+{
+    return {bits(angle1, angle2, side), Family_ASA, uint8_t(side), uint8_t(side), uint8_t(angle1), uint8_t(angle2),
+            Role_S1, Role_S1, false, 0, 0, 0};
+}
+
+constexpr BranchRule twoAngles(int angle1, int angle2)
+{
+    return {(1u << angle1) | (1u << angle2), Family_TwoAngles, 0, 0, uint8_t(angle1), uint8_t(angle2),
+            Role_S1, Role_S1, false, 0, 0, 0};
+}
+
+constexpr BranchRule median(int m, int x, int y, double alpha, double beta, double gamma)
+{
+    return {bits(m, x, y), Family_Median, uint8_t(x), uint8_t(y), uint8_t(m), uint8_t(m),
+            Role_S1, Role_S1, false, alpha, beta, gamma};
+}
+
+constexpr BranchRule bisectorBetween(int b, int x, int y)
+{
+    return {bits(b, x, y), Family_BisectorBetween, uint8_t(x), uint8_t(y), uint8_t(b), uint8_t(b),
+            Role_S1, Role_S1, false, 0, 0, 0};
+}
+
+constexpr BranchRule bisectorOpposite(int b, int x, int y, bool scaled = false)
+{
+    return {bits(b, x, y), uint8_t(scaled ? Family_BisectorOppositeScaled : Family_BisectorOpposite),
+            uint8_t(x), uint8_t(y), uint8_t(b), uint8_t(b), Role_S1, Role_S1, false, 0, 0, 0};
+}
+
+constexpr BranchRule angleBisector(int angle, int side, int bisector, SideRole num)
+{
+    return {bits(angle, side, bisector), Family_AngleBisector, uint8_t(side), uint8_t(bisector), uint8_t(angle), uint8_t(angle),
+            num, Role_Z, true, 0, 0, 0};
+}
+
+// One rule per solver branch, matched to triangleBranch() by its needs mask,
+// so the order here does not matter. Each one mirrors the first formulas of
+// its branch.
+const BranchRule kBranchRules[] = {
+    sas(Field_AB, Field_BC, Field_angleB, Role_S1),
+    sas(Field_AC, Field_BC, Field_angleC, Role_S2),
+    sas(Field_AB, Field_AC, Field_angleA, Role_S2),
+    areaSides(Field_AB, Field_AC, Role_S2, Role_Z),
+    areaSides(Field_AC, Field_BC, Role_S2, Role_S1),
+    areaSides(Field_AB, Field_BC, Role_S1, Role_S2),
+    asa(Field_angleA, Field_angleB, Field_AC),
+    asa(Field_angleA, Field_angleB, Field_BC),
+    twoAngles(Field_angleA, Field_angleB),
+    asa(Field_angleA, Field_angleC, Field_AB),
+    asa(Field_angleA, Field_angleC, Field_BC),
+    twoAngles(Field_angleA, Field_angleC),
+    asa(Field_angleB, Field_angleC, Field_AB),
+    asa(Field_angleB, Field_angleC, Field_AC),
+    twoAngles(Field_angleB, Field_angleC),
+    {bits(Field_AB, Field_AC, Field_BC), Family_SSS, Field_AB, Field_AC, Field_BC, Field_BC,
+     Role_S1, Role_S1, false, 0, 0, 0},
+    median(Field_median_AM, Field_AB, Field_AC, -4, 2, 2),
+    median(Field_median_AM, Field_AB, Field_BC, 2, -1, 0.5),
+    median(Field_median_AM, Field_AC, Field_BC, 4, -2, 0.5), // as written: square(BC)/2 sits inside the sum
+    median(Field_median_BM, Field_AB, Field_BC, -4, 2, 2),
+    median(Field_median_BM, Field_AC, Field_BC, 2, 0.5, -1),
+    median(Field_median_BM, Field_AB, Field_AC, -4, 2, 2),
+    median(Field_median_CM, Field_AC, Field_BC, -4, 2, 2),
+    median(Field_median_CM, Field_AB, Field_BC, 2, 0.5, -1),
+    median(Field_median_CM, Field_AB, Field_AC, -4, 2, 2),
+    bisectorBetween(Field_BisectorA, Field_AB, Field_AC),
+    bisectorOpposite(Field_BisectorA, Field_AB, Field_BC, true),
+    bisectorOpposite(Field_BisectorA, Field_AC, Field_BC),
+    bisectorBetween(Field_BisectorB, Field_AB, Field_BC),
+    bisectorOpposite(Field_BisectorB, Field_AC, Field_BC),
+    bisectorOpposite(Field_BisectorB, Field_AB, Field_AC),
+    bisectorBetween(Field_BisectorC, Field_BC, Field_AC),
+    bisectorOpposite(Field_BisectorC, Field_AB, Field_BC),
+    bisectorOpposite(Field_BisectorC, Field_AC, Field_AB),
+    angleBisector(Field_angleA, Field_AC, Field_BisectorA, Role_S1),
+    angleBisector(Field_angleA, Field_AB, Field_BisectorA, Role_S2),
+    angleBisector(Field_angleB, Field_BC, Field_BisectorB, Role_S2),
+    angleBisector(Field_angleB, Field_AB, Field_BisectorB, Role_S1),
+    angleBisector(Field_angleC, Field_AC, Field_BisectorC, Role_S2),
+    angleBisector(Field_angleC, Field_BC, Field_BisectorC, Role_S1),
+};
+
+const int RuleCount = sizeof kBranchRules / sizeof kBranchRules[0];
+const BranchRule kNoBranchRule = {0, Family_None, 0, 0, 0, 0, Role_S1, Role_S1, false, 0, 0, 0};
+const BranchRule kUncheckedRule = {0, Family_Unchecked, 0, 0, 0, 0, Role_S1, Role_S1, false, 0, 0, 0};
+
+// No branch condition looks at the heights, so the table only spans the
+// fields up to BisectorC and stays within the L1 cache (8 KB).
+const int BranchFieldCount = Field_BisectorC + 1;
+const uint32_t BranchFieldMask = (1u << BranchFieldCount) - 1;
+
+// Rule for every knownMask, so a row finds its rule with one load. Built
+// from triangleBranch(), so it always follows the solver's branch order.
+struct BranchTable {
+    const BranchRule* rules[RuleCount + 2];
+    uint8_t rule[1u << BranchFieldCount];
+
+    BranchTable() {
+        for (int index = 0; index < RuleCount; index++) {
+            rules[index] = &kBranchRules[index];
+        }
+        rules[RuleCount] = &kNoBranchRule;
+        rules[RuleCount + 1] = &kUncheckedRule;
+        for (uint32_t mask = 0; mask < (1u << BranchFieldCount); mask++) {
+            const TriangleBranch* branch = triangleBranch(mask);
+            int index = branch ? RuleCount + 1 : RuleCount;
+            for (int candidate = 0; branch && candidate < RuleCount; candidate++) {
+                if (kBranchRules[candidate].needs == branch->needs) {
+                    index = candidate;
+                    break;
+                }
+            }
+            rule[mask] = uint8_t(index);
+        }
+    }
+};
+
+const BranchTable& branchTable()
+{
+    static const BranchTable table;
+    return table;
+}
+
+// Rows checked per block.
+const std::size_t Block = 64;
+
+// Relative slack on the checks that use the approximate sine and cosine, so
+// right angles and exact fits are not rejected by rounding.
+const double Slack = 1e-9;
+
+// sin and cos of an angle in [0, 180] degrees with no branches and no libm,
+// good to about 1e-12: Taylor series around 90 degrees.
+inline void sinCosDegrees(double degree, double& sine, double& cosine)
+{
+    double t = (std::min(std::max(degree, 0.0), 180.0) - 90) * (3.14159265358979323846 / 180);
+    double t2 = t * t;
+    double sinT = t * (1 + t2 * (-1.0 / 6 + t2 * (1.0 / 120 + t2 * (-1.0 / 5040 + t2 * (1.0 / 362880
+                 + t2 * (-1.0 / 39916800 + t2 * (1.0 / 6227020800 + t2 * (-1.0 / 1307674368000))))))));
+    double cosT = 1 + t2 * (-1.0 / 2 + t2 * (1.0 / 24 + t2 * (-1.0 / 720 + t2 * (1.0 / 40320
+                 + t2 * (-1.0 / 3628800 + t2 * (1.0 / 479001600 + t2 * (-1.0 / 87178291200
+                 + t2 * (1.0 / 20922789888000))))))));
+    sine = cosT;
+    cosine = -sinT;
+}
+
+inline uint32_t reasonIf(bool condition, uint32_t reason)
+{
+    return condition ? reason : 0;
+}
+
+// Every kernel below checks the rows order[0..count) of one rule, reading
+// the rule's fields straight from the rows: the fields and the rule's
+// constants are the same for the whole loop, with no per-row dispatch.
+
+inline double input(const TriangleValues& row, int field)
+{
+    return (&row.AB)[field];
+}
+
+// Families solved by the law of cosines: sides s1 and s2 around an angle,
+// then asin for a second angle.
+template <int Family>
+void checkAngleFamily(const BranchRule& rule, const TriangleValues* rows, const uint8_t* order, std::size_t count,
+                      uint32_t* reasons)
+{
+    for (std::size_t k = 0; k < count; k++) {
+        const TriangleValues& row = rows[order[k]];
+        uint32_t bad = 0;
+        double s1 = input(row, rule.x);
+        double s2 = input(row, rule.y);
+        double p = input(row, rule.p);
+        double sinG, cosG;
+        if constexpr (Family == Family_AreaSides) {
+            sinG = 2 * p / (s1 * s2);
+            cosG = std::sqrt(std::max(0.0, 1 - sinG * sinG));
+            bad |= reasonIf(sinG > 1 + Slack, Reject_AsinDomain);
+        } else {
+            sinCosDegrees(p, sinG, cosG);
+        }
+        if constexpr (Family == Family_AngleBisector) {
+            // -Bis * side / (Bis - 2 side cos(angle/2)) is only positive for a negative denominator.
+            double side = s1;
+            double bisector = s2;
+            double cosHalf = std::sqrt(std::max(0.0, (1 + cosG) / 2));
+            double denominator = bisector - 2 * side * cosHalf;
+            s2 = -bisector * side / denominator;
+            bad |= reasonIf(!(denominator < 0), Reject_NegativeDenominator);
+        }
+        double z2 = s1 * s1 + s2 * s2 - 2 * s1 * s2 * cosG;
+        double z = std::sqrt(std::max(0.0, z2));
+        double numerator = rule.num == Role_S1 ? s1 : rule.num == Role_S2 ? s2 : z;
+        double denominator = rule.den == Role_S1 ? s1 : rule.den == Role_S2 ? s2 : z;
+        bool sinesStep = bad == 0;
+        bad |= reasonIf(sinesStep & (numerator * sinG > denominator * (1 + Slack)), Reject_AsinDomain);
+        bad |= reasonIf(sinesStep & rule.lawOfSines
+                        & (2 * numerator * numerator > (s1 * s1 + s2 * s2 + z2) * (1 + Slack)), Reject_ObtuseAsin);
+        reasons[order[k]] |= bad;
+    }
+}
+
+// Families that compute the third side from two sides and one more length,
+// then have to satisfy the triangle inequality.
+template <int Family>
+void checkSideFamily(const BranchRule& rule, const TriangleValues* rows, const uint8_t* order, std::size_t count,
+                     uint32_t* reasons)
+{
+    for (std::size_t k = 0; k < count; k++) {
+        const TriangleValues& row = rows[order[k]];
+        double x = input(row, rule.x);
+        double y = input(row, rule.y);
+        double p = input(row, rule.p);
+        uint32_t bad = 0;
+        double z2;
+        if constexpr (Family == Family_SSS) {
+            z2 = p * p;
+        } else if constexpr (Family == Family_Median) {
+            z2 = rule.alpha * p * p + rule.beta * x * x + rule.gamma * y * y;
+            bad |= reasonIf(!(z2 > 0), Reject_NegativeRoot);
+        } else if constexpr (Family == Family_BisectorBetween) {
+            double xy = x * y;
+            z2 = (xy - p * p) * (x + y) * (x + y) / xy;
+            bad |= reasonIf(!(xy > p * p), Reject_NegativeRoot);
+        } else {
+            // 4p^2/(x+y)^2 - 1 has the sign of 4p^2 - (x+y)^2.
+            double sum = x + y;
+            double denominator = 4 * p * p - sum * sum;
+            double z = x * y * sum / denominator;
+            if constexpr (Family == Family_BisectorOpposite) {
+                z *= sum * sum;
+            }
+            z2 = z * z;
+            bad |= reasonIf(!(denominator > 0), Reject_NegativeDenominator);
+        }
+        double z = std::sqrt(std::max(0.0, z2));
+        bool closes = 2 * std::max(std::max(x, y), z) < x + y + z;
+        bad |= reasonIf((bad == 0) & !closes, Reject_TriangleInequality);
+        reasons[order[k]] |= bad;
+    }
+}
+
+// Two angles, with a side (ASA) or without one, when the row determines no triangle.
+template <int Family>
+void checkAngles(const BranchRule& rule, const TriangleValues* rows, const uint8_t* order, std::size_t count,
+                 uint32_t* reasons)
+{
+    const uint32_t always = Family == Family_TwoAngles ? uint32_t(Reject_Underdetermined) : 0;
+    for (std::size_t k = 0; k < count; k++) {
+        const TriangleValues& row = rows[order[k]];
+        reasons[order[k]] |= reasonIf(!(input(row, rule.p) + input(row, rule.q) < 180), Reject_AngleSum) | always;
+    }
+}
+
+void checkRule(const BranchRule& rule, const TriangleValues* rows, const uint8_t* order, std::size_t count,
+               uint32_t* reasons)
+{
+    switch (rule.family) {
+    case Family_None:
+        for (std::size_t k = 0; k < count; k++) {
+            reasons[order[k]] |= Reject_Underdetermined;
+        }
+        break;
+    case Family_SAS:
+        checkAngleFamily<Family_SAS>(rule, rows, order, count, reasons);
+        break;
+    case Family_AreaSides:
+        checkAngleFamily<Family_AreaSides>(rule, rows, order, count, reasons);
+        break;
+    case Family_AngleBisector:
+        checkAngleFamily<Family_AngleBisector>(rule, rows, order, count, reasons);
+        break;
+    case Family_ASA:
+        checkAngles<Family_ASA>(rule, rows, order, count, reasons);
+        break;
+    case Family_TwoAngles:
+        checkAngles<Family_TwoAngles>(rule, rows, order, count, reasons);
+        break;
+    case Family_SSS:
+        checkSideFamily<Family_SSS>(rule, rows, order, count, reasons);
+        break;
+    case Family_Median:
+        checkSideFamily<Family_Median>(rule, rows, order, count, reasons);
+        break;
+    case Family_BisectorBetween:
+        checkSideFamily<Family_BisectorBetween>(rule, rows, order, count, reasons);
+        break;
+    case Family_BisectorOpposite:
+        checkSideFamily<Family_BisectorOpposite>(rule, rows, order, count, reasons);
+        break;
+    case Family_BisectorOppositeScaled:
+        checkSideFamily<Family_BisectorOppositeScaled>(rule, rows, order, count, reasons);
+        break;
+    default:
+        break;
+    }
+}
+
+void checkBlock(const TriangleValues* rows, std::size_t count, uint32_t* reasons, const BranchTable& table)
+{
+    // Input errors and the rule of each row. The tests work on the bits: a
+    // known input is a positive double short of NaN, an invalid one is below
+    // -0.0, infinite or NaN.
+    const uint64_t Infinity = 0x7ff0000000000000ull;
+    const uint64_t NegativeZero = 0x8000000000000000ull;
+    uint8_t rule[Block];
+    std::size_t ruleCount[RuleCount + 2] = {};
+    for (std::size_t i = 0; i < count; i++) {
+        uint64_t bits[InputFieldCount];
+        std::memcpy(bits, &rows[i].AB, sizeof bits);
+        uint32_t known = 0;
+        uint64_t invalid = 0;
+        for (int field = 0; field < InputFieldCount; field++) {
+            known |= uint32_t(bits[field] - 1 < Infinity) << field;
+            invalid |= (bits[field] > NegativeZero) | ((bits[field] & ~NegativeZero) >= Infinity);
+        }
+        bool angleRange = (rows[i].angleA >= 180) | (rows[i].angleB >= 180) | (rows[i].angleC >= 180);
+        reasons[i] = reasonIf(invalid != 0, Reject_InvalidInput) | reasonIf(angleRange, Reject_AngleRange);
+        rule[i] = table.rule[known & BranchFieldMask];
+        ruleCount[rule[i]]++;
+    }
+
+    // Row indices grouped by rule, so each rule's kernel runs once per block;
+    // a batch of one input layout is a single group.
+    std::size_t start[RuleCount + 3] = {};
+    for (int index = 0; index < RuleCount + 2; index++) {
+        start[index + 1] = start[index] + ruleCount[index];
+    }
+    std::size_t next[RuleCount + 2];
+    std::copy(start, start + RuleCount + 2, next);
+    uint8_t order[Block];
+    for (std::size_t i = 0; i < count; i++) {
+        order[next[rule[i]]++] = uint8_t(i);
+    }
+    for (int index = 0; index < RuleCount + 2; index++) {
+        if (ruleCount[index]) {
+            checkRule(*table.rules[index], rows, order + start[index], ruleCount[index], reasons);
+        }
+    }
+}
+
+const char* const kReasonNames[FeasibilityReasonCount] = {
+    "invalid_input",
+    "underdetermined",
+    "angle_range",
+    "angle_sum",
+    "triangle_inequality",
+    "asin_domain",
+    "obtuse_asin",
+    "negative_root",
+    "negative_denominator",
+};
+
+const char* const kReasonTexts[FeasibilityReasonCount] = {
+    "An input is negative or not a number.",
+    "These inputs do not determine a triangle.",
+    "An angle must be less than 180 degrees.",
+    "The two angles add up to 180 degrees or more.",
+    "The sides do not satisfy the triangle inequality.",
+    "No angle has the sine these values need (area or side too large).",
+    "The triangle is obtuse where the solver can only find an acute angle.",
+    "A side would be the square root of a negative number.",
+    "The bisector is too long for these values.",
+};
+
+}
+
+void checkFeasibility(const TriangleValues* rows, std::size_t count, uint32_t* reasons)
+{
+    const BranchTable& table = branchTable();
+    for (std::size_t start = 0; start < count; start += Block) {
+        checkBlock(rows + start, std::min(Block, count - start), reasons + start, table);
+    }
+}
+
+uint32_t checkFeasibility(const TriangleValues& values)
+{
+    uint32_t reasons;
+    checkFeasibility(&values, 1, &reasons);
+    return reasons;
+}
+
+const char* feasibilityReasonName(int bit)
+{
+    return bit >= 0 && bit < FeasibilityReasonCount ? kReasonNames[bit] : "";
+}
+
+const char* feasibilityReasonText(uint32_t reasons)
+{
+    for (int bit = 0; bit < FeasibilityReasonCount; bit++) {
+        if (reasons & (1u << bit)) {
+            return kReasonTexts[bit];
+        }
+    }
+    return "";
+}
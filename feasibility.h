@@ -0,0 +1,57 @@
+#ifndef FEASIBILITY_H
+#define FEASIBILITY_H
+
+#include "triangleCore.h"
+#include <cstddef>
+#include <cstdint>
+
+// Cheap checks run before solving that flag rows solveTriangle cannot turn
+// into a real triangle, so batches can skip them and say why. The checks
+// follow the branch solveTriangle would take for the row's known inputs.
+
+enum FeasibilityReason : uint32_t {
+    Reject_InvalidInput = 1u << 0,         // an input is negative, NaN or infinite
+    Reject_Underdetermined = 1u << 1,      // no solver branch uses these inputs
+    Reject_AngleRange = 1u << 2,           // a known angle is 180 degrees or more
+    Reject_AngleSum = 1u << 3,             // the two known angles add up to 180 or more
+    Reject_TriangleInequality = 1u << 4,   // the three sides do not close
+    Reject_AsinDomain = 1u << 5,           // an asin argument is above 1 (e.g. area too large for the sides)
+    Reject_ObtuseAsin = 1u << 6,           // the law of sines step would report an obtuse angle as acute
+    Reject_NegativeRoot = 1u << 7,         // a side would be the square root of a negative number
+    Reject_NegativeDenominator = 1u << 8,  // a bisector formula would give a negative side
+};
+
+const int FeasibilityReasonCount = 9;
+
+// Rejected rows, in total and per reason bit (a row can count under several).
+struct FeasibilityCounts {
+    std::size_t rejected = 0;
+    std::size_t byReason[FeasibilityReasonCount] = {};
+
+    void add(uint32_t reasons) {
+        rejected += reasons != 0;
+        for (int bit = 0; bit < FeasibilityReasonCount; bit++) {
+            byReason[bit] += (reasons >> bit) & 1;
+        }
+    }
+    FeasibilityCounts& operator+=(const FeasibilityCounts& other) {
+        rejected += other.rejected;
+        for (int bit = 0; bit < FeasibilityReasonCount; bit++) {
+            byReason[bit] += other.byReason[bit];
+        }
+        return *this;
+    }
+};
+
+// Sets reasons[i] to the FeasibilityReason bits of rows[i]; 0 means the row
+// is worth solving. Rows go in blocks of 64, grouped by solver branch; each
+// group is checked by one loop that reads the branch's fields from the rows.
+void checkFeasibility(const TriangleValues* rows, std::size_t count, uint32_t* reasons);
+uint32_t checkFeasibility(const TriangleValues& values);
+
+// Short identifier ("triangle_inequality") of reason bit number bit.
+const char* feasibilityReasonName(int bit);
+// Sentence for the lowest reason bit set, for the error field and logs.
+const char* feasibilityReasonText(uint32_t reasons);
+
+#endif // FEASIBILITY_H
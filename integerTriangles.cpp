@@ -0,0 +1,427 @@
+#include "integerTriangles.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const uint32_t AreaGroup = Integer_Area | Integer_HeightA | Integer_HeightB | Integer_HeightC;
+const uint32_t MedianGroup[3] = {Integer_RationalMedianA | Integer_MedianA, Integer_RationalMedianB | Integer_MedianB,
+                                 Integer_RationalMedianC | Integer_MedianC};
+const uint32_t BisectorGroup[3] = {Integer_RationalBisectorA | Integer_BisectorA,
+                                   Integer_RationalBisectorB | Integer_BisectorB,
+                                   Integer_RationalBisectorC | Integer_BisectorC};
+
+// Squares mod 64 are 0, 1, 4, 9, 16, 17, 25, 33, 36, 41, 49 and 57: one
+// lookup rejects 81% of non-squares before the square root.
+const uint64_t SquaresMod64 = 0x0202021202030213ull;
+
+bool isSquare(uint64_t n, uint64_t& root)
+{
+    if (!((SquaresMod64 >> (n & 63)) & 1)) {
+        return false;
+    }
+    uint64_t r = uint64_t(std::sqrt(double(n)));
+    while (r * r > n) {
+        r--;
+    }
+    while ((r + 1) * (r + 1) <= n) {
+        r++;
+    }
+    root = r;
+    return r * r == n;
+}
+
+// sqrt(x * y) when x * y is a square, without forming the product:
+// x / g and y / g are coprime, so both have to be squares.
+bool isSquareProduct(uint64_t x, uint64_t y, uint64_t& root)
+{
+    uint64_t g = std::gcd(x, y);
+    uint64_t rx, ry;
+    if (!isSquare(x / g, rx) || !isSquare(y / g, ry)) {
+        return false;
+    }
+    root = g * rx * ry;
+    return true;
+}
+
+// The property bits of wanted's groups; the others stay clear.
+uint32_t evaluate(uint32_t a, uint32_t b, uint32_t c, uint32_t wanted, uint64_t& area)
+{
+    const uint64_t side[3] = {a, b, c};
+    uint32_t properties = 0;
+    area = 0;
+    if (wanted & AreaGroup) {
+        uint64_t perimeter = side[0] + side[1] + side[2];
+        uint64_t root;
+        // An odd perimeter never gives an integer area.
+        if (perimeter % 2 == 0) {
+            uint64_t s = perimeter / 2;
+            if (isSquareProduct(s * (s - side[0]), (s - side[1]) * (s - side[2]), root)) {
+                area = root;
+                properties |= Integer_Area;
+                for (int v = 0; v < 3; v++) {
+                    if (2 * area % side[v] == 0) {
+                        properties |= Integer_HeightA << v;
+                    }
+                }
+            }
+        }
+    }
+    for (int v = 0; v < 3; v++) {
+        const uint64_t opposite = side[v];
+        const uint64_t p = side[(v + 1) % 3];
+        const uint64_t q = side[(v + 2) % 3];
+        uint64_t root;
+        // 4 * median^2 = 2p^2 + 2q^2 - opposite^2
+        if ((wanted & MedianGroup[v]) && isSquare(2 * p * p + 2 * q * q - opposite * opposite, root)) {
+            properties |= Integer_RationalMedianA << v;
+            if (root % 2 == 0) {
+                properties |= Integer_MedianA << v;
+            }
+        }
+        // bisector = sqrt(p * q * ((p + q)^2 - opposite^2)) / (p + q)
+        if ((wanted & BisectorGroup[v]) && isSquareProduct(p * q, (p + q) * (p + q) - opposite * opposite, root)) {
+            properties |= Integer_RationalBisectorA << v;
+            if (root % (p + q) == 0) {
+                properties |= Integer_BisectorA << v;
+            }
+        }
+    }
+    if ((wanted & Integer_Primitive) && std::gcd(std::gcd(a, b), c) == 1) {
+        properties |= Integer_Primitive;
+    }
+    return properties;
+}
+
+bool accepted(uint32_t properties, const IntegerTriangleCriteria& criteria)
+{
+    return (properties & criteria.required) == criteria.required && (!criteria.anyOf || (properties & criteria.anyOf));
+}
+
+// Squarefree part and the rest's square root of every n <= limit:
+// n = kernel[n] * root[n]^2.
+struct KernelTable {
+    std::vector<uint32_t> kernel;
+    std::vector<uint32_t> root;
+    std::vector<uint32_t> smallestPrime;
+
+    explicit KernelTable(uint32_t limit)
+        : kernel(limit + 1, 1)
+        , root(limit + 1, 1)
+        , smallestPrime(limit + 1, 0)
+    {
+        for (uint32_t n = 2; n <= limit; n++) {
+            if (smallestPrime[n] == 0) {
+                for (uint64_t multiple = n; multiple <= limit; multiple += n) {
+                    if (smallestPrime[multiple] == 0) {
+                        smallestPrime[multiple] = n;
+                    }
+                }
+            }
+            uint32_t p = smallestPrime[n];
+            uint32_t rest = n / p;
+            if (kernel[rest] % p == 0) {
+                kernel[n] = kernel[rest] / p;
+                root[n] = root[rest] * p;
+            } else {
+                kernel[n] = kernel[rest] * p;
+                root[n] = root[rest];
+            }
+        }
+    }
+
+};
+
+// Kernel and root of x * y where y = 2c - x or y = x + 2c. Any prime the two
+// kernels share divides 2c, so instead of a gcd per pair, each of the few
+// distinct primes of 2c keeps x mod p as x steps, and only a prime that
+// divides x is checked against both kernels.
+struct SharedPrimes {
+    uint32_t prime[8];
+    uint32_t residue[8];
+    int count = 0;
+
+    SharedPrimes(const KernelTable& table, uint32_t c, uint32_t x)
+    {
+        for (uint32_t n = 2 * c; n > 1; count++) {
+            prime[count] = table.smallestPrime[n];
+            residue[count] = x % prime[count];
+            while (n % prime[count] == 0) {
+                n /= prime[count];
+            }
+        }
+    }
+
+    void decrement()
+    {
+        for (int i = 0; i < count; i++) {
+            residue[i] = residue[i] ? residue[i] - 1 : prime[i] - 1;
+        }
+    }
+
+    void addTwo()
+    {
+        for (int i = 0; i < count; i++) {
+            residue[i] += 2;
+            if (residue[i] >= prime[i]) {
+                residue[i] -= prime[i];
+            }
+        }
+    }
+
+    void product(const KernelTable& table, uint32_t x, uint32_t y, uint64_t& kernel, uint64_t& root) const
+    {
+        uint32_t g = 1;
+        for (int i = 0; i < count; i++) {
+            if (residue[i] == 0 && table.kernel[x] % prime[i] == 0 && table.kernel[y] % prime[i] == 0) {
+                g *= prime[i];
+            }
+        }
+        kernel = uint64_t(table.kernel[x] / g) * (table.kernel[y] / g);
+        root = uint64_t(table.root[x]) * table.root[y] * g;
+    }
+};
+
+// Per-thread scratch for one c: v values chained by the kernel of c^2 - v^2,
+// in an open-addressing table of chain heads. Reused for every c.
+struct KernelIndex {
+    std::vector<uint64_t> keys;
+    std::vector<int32_t> heads;
+    std::vector<int32_t> next;
+    std::vector<uint64_t> roots;
+    uint64_t mask = 0;
+
+    void reset(uint32_t entries)
+    {
+        std::size_t capacity = 16;
+        while (capacity < 2 * std::size_t(entries)) {
+            capacity <<= 1;
+        }
+        keys.resize(capacity);
+        heads.assign(capacity, -1);
+        next.resize(entries);
+        roots.resize(entries);
+        mask = capacity - 1;
+    }
+
+    std::size_t slot(uint64_t key) const
+    {
+        std::size_t i = std::size_t((key * 0x9e3779b97f4a7c15ull) >> 32) & mask;
+        while (heads[i] >= 0 && keys[i] != key) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    void insert(uint64_t key, uint32_t v, uint64_t root)
+    {
+        std::size_t i = slot(key);
+        keys[i] = key;
+        next[v] = heads[i];
+        heads[i] = int32_t(v);
+        roots[v] = root;
+    }
+
+    int32_t find(uint64_t key) const { return heads[slot(key)]; }
+};
+
+// Heronian triangles with largest side c, unordered.
+void heronianForSide(uint32_t c, const KernelTable& table, KernelIndex& index, const IntegerTriangleCriteria& criteria,
+                     std::vector<IntegerTriangle>& found, uint64_t& candidates)
+{
+    // v = b - a in [0, c): c^2 - v^2 = (c - v)(c + v).
+    index.reset(c);
+    SharedPrimes shared(table, c, c);
+    for (uint32_t v = 0; v < c; v++, shared.decrement()) {
+        uint64_t kernel, root;
+        shared.product(table, c - v, c + v, kernel, root);
+        index.insert(kernel, v, root);
+    }
+    // u = a + b in (c, 2c], with u + c even; u^2 - c^2 = (u - c)(u + c).
+    shared = SharedPrimes(table, c, 2);
+    for (uint32_t u = c + 2; u <= 2 * c; u += 2, shared.addTwo()) {
+        uint64_t kernel, root;
+        shared.product(table, u - c, u + c, kernel, root);
+        for (int32_t v = index.find(kernel); v >= 0; v = index.next[v]) {
+            // b = (u + v) / 2 <= c, and a and b whole.
+            if (uint32_t(v) > 2 * c - u || (u - uint32_t(v)) % 2 != 0) {
+                continue;
+            }
+            candidates++;
+            // 16 * Area^2 = kernel^2 * root_u^2 * root_v^2
+            uint64_t sixteenArea = kernel * root * index.roots[v];
+            if (sixteenArea % 4 != 0) {
+                continue;
+            }
+            IntegerTriangle triangle;
+            triangle.a = (u - uint32_t(v)) / 2;
+            triangle.b = (u + uint32_t(v)) / 2;
+            triangle.c = c;
+            uint64_t area;
+            triangle.properties = evaluate(triangle.a, triangle.b, c, ~0u, area);
+            if (accepted(triangle.properties, criteria)) {
+                triangle.area = area;
+                found.push_back(triangle);
+            }
+        }
+    }
+}
+
+// Every triple with largest side c; the required groups are tested first.
+void walkSide(uint32_t c, const IntegerTriangleCriteria& criteria, std::vector<IntegerTriangle>& found,
+              uint64_t& candidates)
+{
+    for (uint32_t a = 1; a <= c; a++) {
+        for (uint32_t b = std::max(a, c - a + 1); b <= c; b++) {
+            candidates++;
+            uint64_t area;
+            uint32_t properties = evaluate(a, b, c, criteria.required | criteria.anyOf, area);
+            if (!accepted(properties, criteria)) {
+                continue;
+            }
+            IntegerTriangle triangle;
+            triangle.a = a;
+            triangle.b = b;
+            triangle.c = c;
+            triangle.properties = evaluate(a, b, c, ~0u, triangle.area);
+            found.push_back(triangle);
+        }
+    }
+}
+
+struct PropertyName {
+    const char* name;
+    uint32_t bitA; // the A bit; B and C follow
+};
+
+const PropertyName propertyNames[] = {
+    {"rationalMedian", Integer_RationalMedianA}, {"integerMedian", Integer_MedianA},
+    {"rationalBisector", Integer_RationalBisectorA}, {"integerBisector", Integer_BisectorA},
+    {"integerHeight", Integer_HeightA},
+};
+
+}
+
+uint32_t integerTriangleProperties(uint32_t a, uint32_t b, uint32_t c, uint64_t& area)
+{
+    return evaluate(a, b, c, ~0u, area);
+}
+
+bool parseIntegerProperties(const std::string& text, uint32_t& properties, std::string& error)
+{
+    properties = 0;
+    std::size_t begin = 0;
+    while (begin <= text.size()) {
+        std::size_t end = std::min(text.find(',', begin), text.size());
+        std::string name = text.substr(begin, end - begin);
+        begin = end + 1;
+        if (name == "area") {
+            properties |= Integer_Area;
+            continue;
+        }
+        if (name == "primitive") {
+            properties |= Integer_Primitive;
+            continue;
+        }
+        bool known = false;
+        for (const PropertyName& property : propertyNames) {
+            std::size_t length = std::strlen(property.name);
+            if (name.compare(0, length, property.name) != 0) {
+                continue;
+            }
+            if (name.size() == length) {
+                properties |= property.bitA * 7;
+                known = true;
+            } else if (name.size() == length + 1 && name[length] >= 'A' && name[length] <= 'C') {
+                properties |= property.bitA << (name[length] - 'A');
+                known = true;
+            }
+        }
+        if (!known) {
+            error = "unknown property " + name;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool enumerateIntegerTriangles(const IntegerTriangleCriteria& criteria, const IntegerTriangleSink& sink,
+                               IntegerEnumerationStats& stats, std::string& error)
+{
+    auto start = std::chrono::steady_clock::now();
+    stats = IntegerEnumerationStats();
+    if (criteria.maxSide < 1 || criteria.maxSide > IntegerMaxSide) {
+        error = "the largest side must be 1 to " + std::to_string(IntegerMaxSide);
+        return false;
+    }
+    const bool heronian = criteria.required & Integer_Area;
+    // u + c and c + v reach 3c - 1 and 2c - 1.
+    const KernelTable table(heronian ? 3 * criteria.maxSide : 1);
+    unsigned threads = criteria.threads ? criteria.threads : std::max(1u, std::thread::hardware_concurrency());
+
+    // Sides are solved in any order but handed to sink strictly in order of
+    // c; whichever thread completes the next side flushes what is ready.
+    std::atomic<uint32_t> nextSide{1};
+    std::atomic<uint64_t> candidates{0};
+    std::mutex sinkMutex;
+    std::map<uint32_t, std::vector<IntegerTriangle>> finished;
+    uint32_t nextToSink = 1;
+
+    auto worker = [&] {
+        KernelIndex index;
+        uint64_t tested = 0;
+        for (;;) {
+            uint32_t c = nextSide.fetch_add(1, std::memory_order_relaxed);
+            if (c > criteria.maxSide) {
+                break;
+            }
+            std::vector<IntegerTriangle> found;
+            if (heronian) {
+                heronianForSide(c, table, index, criteria, found, tested);
+            } else {
+                walkSide(c, criteria, found, tested);
+            }
+            std::sort(found.begin(), found.end(), [](const IntegerTriangle& x, const IntegerTriangle& y) {
+                return x.a != y.a ? x.a < y.a : x.b < y.b;
+            });
+            for (IntegerTriangle& triangle : found) {
+                triangle.values.BC = triangle.a;
+                triangle.values.AC = triangle.b;
+                triangle.values.AB = triangle.c;
+                solveTriangle(triangle.values);
+            }
+
+            std::lock_guard<std::mutex> lock(sinkMutex);
+            finished.emplace(c, std::move(found));
+            for (auto ready = finished.begin(); ready != finished.end() && ready->first == nextToSink;
+                 ready = finished.erase(ready)) {
+                if (!ready->second.empty()) {
+                    sink(ready->second.data(), ready->second.size());
+                    stats.found += ready->second.size();
+                }
+                nextToSink++;
+            }
+        }
+        candidates.fetch_add(tested, std::memory_order_relaxed);
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+    stats.candidates = candidates.load();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
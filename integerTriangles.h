@@ -0,0 +1,86 @@
+#ifndef INTEGERTRIANGLES_H
+#define INTEGERTRIANGLES_H
+
+#include "triangleCore.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// Enumerates triangles with integer sides a <= b <= c <= maxSide that have
+// integer or rational area, medians, bisectors or heights, in exact integer
+// arithmetic. The sides go to BC = a, AC = b, AB = c, so property "A"
+// belongs to the cevian from A onto side a.
+//
+// When an integer area is required, each c is handled in O(c) instead of
+// walking its c^2 / 4 pairs: with u = a + b and v = b - a, Heron's formula
+// reads 16 * Area^2 = (u^2 - c^2)(c^2 - v^2), which is a square exactly when
+// both factors have the same squarefree part. So the u side and the v side
+// are each reduced to squarefree kernels (from a sieve over 1..3 * maxSide)
+// and only matching kernels pair up; odd perimeters are skipped outright,
+// since no Heronian triangle has one. Other criteria walk every triple of
+// each c, with cheap square filters before the exact tests.
+
+enum IntegerTriangleProperty : uint32_t {
+    Integer_Area = 1u << 0, // Heronian; a rational area of integer sides is always an integer
+    Integer_RationalMedianA = 1u << 1,
+    Integer_RationalMedianB = 1u << 2,
+    Integer_RationalMedianC = 1u << 3,
+    Integer_MedianA = 1u << 4,
+    Integer_MedianB = 1u << 5,
+    Integer_MedianC = 1u << 6,
+    Integer_RationalBisectorA = 1u << 7,
+    Integer_RationalBisectorB = 1u << 8,
+    Integer_RationalBisectorC = 1u << 9,
+    Integer_BisectorA = 1u << 10,
+    Integer_BisectorB = 1u << 11,
+    Integer_BisectorC = 1u << 12,
+    Integer_HeightA = 1u << 13,
+    Integer_HeightB = 1u << 14,
+    Integer_HeightC = 1u << 15,
+    Integer_Primitive = 1u << 16, // gcd(a, b, c) == 1
+};
+
+const uint32_t IntegerMaxSide = 65535; // keeps every exact intermediate within 64 bits
+
+struct IntegerTriangleCriteria {
+    uint32_t maxSide = 1000;
+    uint32_t required = Integer_Area; // every one of these properties
+    uint32_t anyOf = 0;               // and, if nonzero, at least one of these
+    unsigned threads = 0;             // 0 = one per hardware thread
+};
+
+struct IntegerTriangle {
+    uint32_t a = 0;
+    uint32_t b = 0;
+    uint32_t c = 0;
+    uint32_t properties = 0; // IntegerTriangleProperty bits that hold, all of them
+    uint64_t area = 0;       // exact when Integer_Area is set, else 0
+    TriangleValues values;   // solveTriangle from the three sides
+};
+
+struct IntegerEnumerationStats {
+    uint64_t candidates = 0; // triples tested exactly: kernel matches, or every triple without the area filter
+    uint64_t found = 0;
+    double seconds = 0;
+};
+
+// Receives the triangles of one or more consecutive c, ordered by c, then
+// a, then b; called from one thread at a time.
+using IntegerTriangleSink = std::function<void(const IntegerTriangle* rows, std::size_t count)>;
+
+// Returns false and sets error for a maxSide outside 1..IntegerMaxSide.
+bool enumerateIntegerTriangles(const IntegerTriangleCriteria& criteria, const IntegerTriangleSink& sink,
+                               IntegerEnumerationStats& stats, std::string& error);
+
+// All IntegerTriangleProperty bits of the triangle with sides a, b, c
+// (a <= b <= c, a + b > c); area receives the exact area when it is an integer.
+uint32_t integerTriangleProperties(uint32_t a, uint32_t b, uint32_t c, uint64_t& area);
+
+// Parses a comma-separated list such as "area,integerMedian,primitive".
+// Names: area, primitive, and rationalMedian, integerMedian,
+// rationalBisector, integerBisector, integerHeight, each with a vertex
+// suffix A, B or C, or without one for all three vertices.
+bool parseIntegerProperties(const std::string& text, uint32_t& properties, std::string& error);
+
+#endif // INTEGERTRIANGLES_H
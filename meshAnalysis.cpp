@@ -0,0 +1,364 @@
+#include "meshAnalysis.h"
+#include "batchKernels.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <thread>
+
+namespace {
+
+const std::size_t FaceBlock = 4096;
+
+bool readFile(const std::string& path, std::string& contents, std::string& error)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    file.seekg(0, std::ios::end);
+    contents.resize(std::size_t(file.tellg()));
+    file.seekg(0);
+    file.read(&contents[0], contents.size());
+    if (!file) {
+        error = "cannot read " + path;
+        return false;
+    }
+    return true;
+}
+
+const char* skipSpaces(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        p++;
+    }
+    return p;
+}
+
+bool endsWith(const std::string& text, const char* suffix)
+{
+    std::size_t length = std::strlen(suffix);
+    if (text.size() < length) {
+        return false;
+    }
+    for (std::size_t i = 0; i < length; i++) {
+        if (std::tolower(static_cast<unsigned char>(text[text.size() - length + i])) != suffix[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+void Histogram::add(double value)
+{
+    if (counts.empty() || std::isnan(value)) {
+        return;
+    }
+    double position = (value - minValue) / (maxValue - minValue) * counts.size();
+    std::size_t bin = position <= 0 ? 0 : std::min(counts.size() - 1, std::size_t(position));
+    counts[bin]++;
+}
+
+Histogram& Histogram::operator+=(const Histogram& other)
+{
+    for (std::size_t i = 0; i < counts.size() && i < other.counts.size(); i++) {
+        counts[i] += other.counts[i];
+    }
+    return *this;
+}
+
+bool loadObjMesh(const std::string& path, Mesh& mesh, std::string& error)
+{
+    std::string contents;
+    if (!readFile(path, contents, error)) {
+        return false;
+    }
+    mesh = Mesh();
+    std::vector<long> polygon;
+    const char* p = contents.data();
+    const char* end = p + contents.size();
+    std::size_t lineNumber = 0;
+    while (p < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+        lineNumber++;
+        const char* q = skipSpaces(p, lineEnd);
+        if (lineEnd - q > 2 && q[0] == 'v' && (q[1] == ' ' || q[1] == '\t')) {
+            q += 2;
+            for (int axis = 0; axis < 3; axis++) {
+                q = skipSpaces(q, lineEnd);
+                double value = 0;
+                auto [next, ec] = std::from_chars(q, lineEnd, value);
+                if (ec != std::errc()) {
+                    error = path + ":" + std::to_string(lineNumber) + ": bad vertex";
+                    return false;
+                }
+                mesh.vertices.push_back(value);
+                q = next;
+            }
+        } else if (lineEnd - q > 2 && q[0] == 'f' && (q[1] == ' ' || q[1] == '\t')) {
+            q += 2;
+            polygon.clear();
+            for (;;) {
+                q = skipSpaces(q, lineEnd);
+                if (q >= lineEnd || *q == '\r') {
+                    break;
+                }
+                long index = 0;
+                auto [next, ec] = std::from_chars(q, lineEnd, index);
+                if (ec != std::errc() || index == 0) {
+                    error = path + ":" + std::to_string(lineNumber) + ": bad face";
+                    return false;
+                }
+                // Indices are 1-based; negative ones count back from the last vertex.
+                long resolved = index > 0 ? index - 1 : long(mesh.vertexCount()) + index;
+                if (resolved < 0 || std::size_t(resolved) >= mesh.vertexCount()) {
+                    error = path + ":" + std::to_string(lineNumber) + ": face index out of range";
+                    return false;
+                }
+                polygon.push_back(resolved);
+                // Skip the /texture/normal parts of "v/vt/vn".
+                q = next;
+                while (q < lineEnd && *q != ' ' && *q != '\t' && *q != '\r') {
+                    q++;
+                }
+            }
+            for (std::size_t i = 2; i < polygon.size(); i++) {
+                mesh.faces.push_back(uint32_t(polygon[0]));
+                mesh.faces.push_back(uint32_t(polygon[i - 1]));
+                mesh.faces.push_back(uint32_t(polygon[i]));
+            }
+        }
+        p = lineEnd + (lineEnd < end ? 1 : 0);
+    }
+    deduplicateVertices(mesh);
+    return true;
+}
+
+bool loadStlMesh(const std::string& path, Mesh& mesh, std::string& error)
+{
+    std::string contents;
+    if (!readFile(path, contents, error)) {
+        return false;
+    }
+    if (contents.size() < 84) {
+        error = path + ": too short for a binary STL";
+        return false;
+    }
+    uint32_t faceCount;
+    std::memcpy(&faceCount, contents.data() + 80, sizeof faceCount);
+    if (contents.size() < 84 + std::size_t(faceCount) * 50) {
+        error = path + ": truncated binary STL (ASCII STL is not supported)";
+        return false;
+    }
+    mesh = Mesh();
+    mesh.vertices.resize(std::size_t(faceCount) * 9);
+    mesh.faces.resize(std::size_t(faceCount) * 3);
+    const char* record = contents.data() + 84;
+    for (std::size_t face = 0; face < faceCount; face++, record += 50) {
+        // 12 bytes of normal, then three float32 vertices, then 2 attribute bytes.
+        float corners[9];
+        std::memcpy(corners, record + 12, sizeof corners);
+        for (int i = 0; i < 9; i++) {
+            mesh.vertices[face * 9 + i] = corners[i];
+        }
+        for (int i = 0; i < 3; i++) {
+            mesh.faces[face * 3 + i] = uint32_t(face * 3 + i);
+        }
+    }
+    deduplicateVertices(mesh);
+    return true;
+}
+
+bool loadMesh(const std::string& path, Mesh& mesh, std::string& error)
+{
+    if (endsWith(path, ".stl")) {
+        return loadStlMesh(path, mesh, error);
+    }
+    if (endsWith(path, ".obj")) {
+        return loadObjMesh(path, mesh, error);
+    }
+    error = path + ": unknown mesh format (expected .obj or .stl)";
+    return false;
+}
+
+void deduplicateVertices(Mesh& mesh)
+{
+    std::size_t count = mesh.vertexCount();
+    const double* v = mesh.vertices.data();
+    std::vector<uint32_t> order(count);
+    for (std::size_t i = 0; i < count; i++) {
+        order[i] = uint32_t(i);
+    }
+    std::sort(order.begin(), order.end(), [v](uint32_t a, uint32_t b) {
+        return std::lexicographical_compare(v + 3 * a, v + 3 * a + 3, v + 3 * b, v + 3 * b + 3);
+    });
+
+    std::vector<uint32_t> remap(count);
+    std::vector<double> unique;
+    unique.reserve(mesh.vertices.size());
+    for (std::size_t i = 0; i < count; i++) {
+        uint32_t index = order[i];
+        if (i == 0 || !std::equal(v + 3 * index, v + 3 * index + 3, v + 3 * order[i - 1])) {
+            unique.insert(unique.end(), v + 3 * index, v + 3 * index + 3);
+        }
+        remap[index] = uint32_t(unique.size() / 3 - 1);
+    }
+    for (uint32_t& index : mesh.faces) {
+        index = remap[index];
+    }
+    mesh.vertices.swap(unique);
+}
+
+MeshReport analyzeMesh(const Mesh& mesh, const MeshAnalysisOptions& options, MeshFaceMetrics* perFace)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::size_t faceCount = mesh.faceCount();
+    if (perFace) {
+        for (std::vector<float>* column : {&perFace->Area, &perFace->angleA, &perFace->angleB, &perFace->angleC,
+                                           &perFace->inRadius, &perFace->circumRadius, &perFace->HeightAH,
+                                           &perFace->HeightBH, &perFace->HeightCH, &perFace->minAngle,
+                                           &perFace->radiusRatio}) {
+            column->resize(faceCount);
+        }
+    }
+
+    MeshReport empty;
+    empty.minAngle.minValue = 0;
+    empty.minAngle.maxValue = 60;
+    empty.minAngle.counts.assign(options.histogramBins, 0);
+    empty.radiusRatio.minValue = 1;
+    empty.radiusRatio.maxValue = options.maxRadiusRatio;
+    empty.radiusRatio.counts.assign(options.histogramBins, 0);
+
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<MeshReport> partial(threads, empty);
+    std::atomic<std::size_t> nextBlock{0};
+
+    auto worker = [&](unsigned t) {
+        MeshReport& report = partial[t];
+        double AB[FaceBlock], AC[FaceBlock], BC[FaceBlock];
+        double area[FaceBlock], angleA[FaceBlock], angleB[FaceBlock], angleC[FaceBlock];
+        double inRadius[FaceBlock], circumRadius[FaceBlock];
+        double heightA[FaceBlock], heightB[FaceBlock], heightC[FaceBlock];
+        SssColumns columns;
+        columns.Area = area;
+        columns.angleA = angleA;
+        columns.angleB = angleB;
+        columns.angleC = angleC;
+        columns.inRadius = inRadius;
+        columns.circumRadius = circumRadius;
+        if (perFace) {
+            columns.HeightAH = heightA;
+            columns.HeightBH = heightB;
+            columns.HeightCH = heightC;
+        }
+        const double* v = mesh.vertices.data();
+        const uint32_t* f = mesh.faces.data();
+        for (;;) {
+            std::size_t first = nextBlock.fetch_add(FaceBlock, std::memory_order_relaxed);
+            if (first >= faceCount) {
+                return;
+            }
+            std::size_t count = std::min(FaceBlock, faceCount - first);
+            for (std::size_t i = 0; i < count; i++) {
+                const double* a = v + 3 * std::size_t(f[3 * (first + i)]);
+                const double* b = v + 3 * std::size_t(f[3 * (first + i) + 1]);
+                const double* c = v + 3 * std::size_t(f[3 * (first + i) + 2]);
+                AB[i] = std::sqrt((b[0] - a[0]) * (b[0] - a[0]) + (b[1] - a[1]) * (b[1] - a[1]) + (b[2] - a[2]) * (b[2] - a[2]));
+                AC[i] = std::sqrt((c[0] - a[0]) * (c[0] - a[0]) + (c[1] - a[1]) * (c[1] - a[1]) + (c[2] - a[2]) * (c[2] - a[2]));
+                BC[i] = std::sqrt((c[0] - b[0]) * (c[0] - b[0]) + (c[1] - b[1]) * (c[1] - b[1]) + (c[2] - b[2]) * (c[2] - b[2]));
+            }
+            solveSssBatch(AB, AC, BC, count, columns);
+            for (std::size_t i = 0; i < count; i++) {
+                double minAngle = std::min(angleA[i], std::min(angleB[i], angleC[i]));
+                double ratio = circumRadius[i] / (2 * inRadius[i]);
+                bool degenerate = !(area[i] > 0) || !std::isfinite(ratio);
+                report.faces++;
+                if (degenerate) {
+                    report.degenerateFaces++;
+                } else {
+                    report.totalArea += area[i];
+                    report.worstMinAngle = std::min(report.worstMinAngle, minAngle);
+                    report.worstRadiusRatio = std::max(report.worstRadiusRatio, ratio);
+                    report.minAngle.add(minAngle);
+                    report.radiusRatio.add(ratio);
+                }
+                if (perFace) {
+                    std::size_t face = first + i;
+                    perFace->Area[face] = float(area[i]);
+                    perFace->angleA[face] = float(angleA[i]);
+                    perFace->angleB[face] = float(angleB[i]);
+                    perFace->angleC[face] = float(angleC[i]);
+                    perFace->inRadius[face] = float(inRadius[i]);
+                    perFace->circumRadius[face] = float(circumRadius[i]);
+                    perFace->HeightAH[face] = float(heightA[i]);
+                    perFace->HeightBH[face] = float(heightB[i]);
+                    perFace->HeightCH[face] = float(heightC[i]);
+                    perFace->minAngle[face] = float(minAngle);
+                    perFace->radiusRatio[face] = float(ratio);
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++) {
+        workers.emplace_back(worker, t);
+    }
+    worker(0);
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+    MeshReport report = empty;
+    for (const MeshReport& part : partial) {
+        report.faces += part.faces;
+        report.degenerateFaces += part.degenerateFaces;
+        report.totalArea += part.totalArea;
+        report.worstMinAngle = std::min(report.worstMinAngle, part.worstMinAngle);
+        report.worstRadiusRatio = std::max(report.worstRadiusRatio, part.worstRadiusRatio);
+        report.minAngle += part.minAngle;
+        report.radiusRatio += part.radiusRatio;
+    }
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+void writeMeshReport(std::ostream& out, const MeshReport& report)
+{
+    out << "faces," << report.faces << "\n"
+        << "degenerate_faces," << report.degenerateFaces << "\n"
+        << "total_area," << report.totalArea << "\n"
+        << "worst_min_angle," << report.worstMinAngle << "\n"
+        << "worst_radius_ratio," << report.worstRadiusRatio << "\n"
+        << "seconds," << report.seconds << "\n";
+    for (const Histogram* histogram : {&report.minAngle, &report.radiusRatio}) {
+        out << (histogram == &report.minAngle ? "min_angle_histogram" : "radius_ratio_histogram") << "\n";
+        double width = (histogram->maxValue - histogram->minValue) / histogram->counts.size();
+        for (std::size_t i = 0; i < histogram->counts.size(); i++) {
+            out << histogram->minValue + i * width << "," << histogram->counts[i] << "\n";
+        }
+    }
+}
+
+void writeFaceMetricsCsv(std::ostream& out, const MeshFaceMetrics& metrics)
+{
+    out << "face,Area,angleA,angleB,angleC,inRadius,circumRadius,HeightAH,HeightBH,HeightCH,minAngle,radiusRatio\n";
+    for (std::size_t face = 0; face < metrics.Area.size(); face++) {
+        out << face << ',' << metrics.Area[face] << ',' << metrics.angleA[face] << ',' << metrics.angleB[face] << ','
+            << metrics.angleC[face] << ',' << metrics.inRadius[face] << ',' << metrics.circumRadius[face] << ','
+            << metrics.HeightAH[face] << ',' << metrics.HeightBH[face] << ',' << metrics.HeightCH[face] << ','
+            << metrics.minAngle[face] << ',' << metrics.radiusRatio[face] << '\n';
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef MESHANALYSIS_H
+#define MESHANALYSIS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Mesh quality checking on top of the SSS branch: every face is a triangle
+// with three known sides, so area, angles, radii and heights come straight
+// from solveSssBatch.
+
+struct Mesh {
+    std::vector<double> vertices;  // x, y, z per vertex
+    std::vector<uint32_t> faces;   // three vertex indices per face
+
+    std::size_t vertexCount() const { return vertices.size() / 3; }
+    std::size_t faceCount() const { return faces.size() / 3; }
+};
+
+// Loaders return false and set error on failure. Polygons in OBJ files are
+// fan-triangulated. Vertices with identical coordinates are merged.
+bool loadObjMesh(const std::string& path, Mesh& mesh, std::string& error);
+bool loadStlMesh(const std::string& path, Mesh& mesh, std::string& error); // binary STL
+bool loadMesh(const std::string& path, Mesh& mesh, std::string& error);    // by extension
+
+// Merges vertices with identical coordinates and rewrites face indices.
+void deduplicateVertices(Mesh& mesh);
+
+struct Histogram {
+    double minValue = 0;
+    double maxValue = 0;
+    std::vector<std::size_t> counts; // values outside [minValue, maxValue) go to the end bins
+
+    void add(double value);
+    Histogram& operator+=(const Histogram& other);
+};
+
+// Optional per-face output, one entry per face (float to keep 100M-face meshes in memory).
+struct MeshFaceMetrics {
+    std::vector<float> Area;
+    std::vector<float> angleA;
+    std::vector<float> angleB;
+    std::vector<float> angleC;
+    std::vector<float> inRadius;
+    std::vector<float> circumRadius;
+    std::vector<float> HeightAH;
+    std::vector<float> HeightBH;
+    std::vector<float> HeightCH;
+    std::vector<float> minAngle;
+    std::vector<float> radiusRatio; // circumRadius / (2 * inRadius); 1 for an equilateral face
+};
+
+struct MeshAnalysisOptions {
+    unsigned threads = 0;    // 0 = one per hardware thread
+    int histogramBins = 60;
+    double maxRadiusRatio = 10; // upper edge of the radius-ratio histogram
+};
+
+struct MeshReport {
+    std::size_t faces = 0;
+    std::size_t degenerateFaces = 0; // zero area or non-finite metrics
+    double totalArea = 0;
+    double worstMinAngle = 180;
+    double worstRadiusRatio = 1;
+    Histogram minAngle;    // degrees, [0, 60]
+    Histogram radiusRatio; // [1, maxRadiusRatio]
+    double seconds = 0;
+};
+
+MeshReport analyzeMesh(const Mesh& mesh, const MeshAnalysisOptions& options = MeshAnalysisOptions(),
+                       MeshFaceMetrics* perFace = nullptr);
+
+void writeMeshReport(std::ostream& out, const MeshReport& report);
+void writeFaceMetricsCsv(std::ostream& out, const MeshFaceMetrics& metrics);
+
+#endif // MESHANALYSIS_H
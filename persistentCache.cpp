@@ -0,0 +1,632 @@
+#include "persistentCache.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <unordered_set>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+struct PersistentSolveCache::Header {
+    char magic[4];
+    uint32_t version;
+    uint64_t slotCount;      // power of two
+    uint64_t recordCapacity;
+    uint64_t fileBytes;
+    std::atomic<uint64_t> records; // appended so far; may overshoot recordCapacity
+};
+
+struct PersistentSolveCache::Record {
+    uint32_t mask;
+    uint32_t checksum;
+    double inputs[InputFieldCount];
+    double outputs[FieldCount];
+};
+
+namespace {
+
+const std::size_t HeaderBytes = 4096;
+const std::size_t ProbeLimit = 32;
+const uint32_t CacheVersion = 1;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "the mapped index needs address-free 64-bit atomics");
+
+uint64_t mix(uint64_t h, uint64_t v)
+{
+    h ^= v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+    return h;
+}
+
+// Lookups run once per batch row, so these read the inputs as a plain array
+// (the layout the batch code relies on) rather than through fieldValue.
+uint32_t inputMask(const double* inputs)
+{
+    uint32_t mask = 0;
+    for (int field = 0; field < InputFieldCount; field++) {
+        mask |= uint32_t(inputs[field] > 0) << field;
+    }
+    return mask;
+}
+
+uint64_t hashInputs(const double* inputs, uint32_t mask)
+{
+    // Unknown fields are all zero bits and the mask already says which they
+    // are, so only the known ones go into the chain.
+    uint64_t hash = mask;
+    for (int field = 0; field < InputFieldCount; field++) {
+        uint64_t bits;
+        std::memcpy(&bits, &inputs[field], sizeof bits);
+        if (bits != 0) {
+            hash = mix(hash, bits);
+        }
+    }
+    // Final avalanche so both the slot index (low bits) and the tag (high bits) depend on every input bit.
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+// Checked on every hit, so the words go round four independent FNV chains
+// rather than one long dependent one.
+uint32_t recordChecksum(const void* data, std::size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t lanes[4] = {0xcbf29ce484222325ull, 0xcbf29ce484222325ull ^ 1, 0xcbf29ce484222325ull ^ 2,
+                         0xcbf29ce484222325ull ^ 3};
+    for (std::size_t i = 0; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, 8);
+        lanes[(i / 8) % 4] = (lanes[(i / 8) % 4] ^ word) * 0x100000001b3ull;
+    }
+    uint64_t hash = lanes[0];
+    for (int lane = 1; lane < 4; lane++) {
+        hash = (hash ^ lanes[lane]) * 0x100000001b3ull;
+    }
+    return uint32_t(hash ^ (hash >> 32));
+}
+
+// Index slot: high 32 bits are a hash tag, low 32 bits the record index + 1 (0 = empty).
+uint64_t slotValue(uint64_t hash, uint64_t recordIndex)
+{
+    return (hash & 0xffffffff00000000ull) | (recordIndex + 1);
+}
+
+// Largest layout that fits in maxBytes, with the index at most half full.
+void layoutFor(std::size_t maxBytes, uint64_t& slotCount, uint64_t& recordCapacity, uint64_t& fileBytes, std::size_t recordBytes)
+{
+    slotCount = 64;
+    while (HeaderBytes + 2 * slotCount * 8 + slotCount * recordBytes <= maxBytes) {
+        slotCount *= 2;
+    }
+    recordCapacity = slotCount / 2;
+    fileBytes = HeaderBytes + slotCount * 8 + recordCapacity * recordBytes;
+}
+
+#ifndef _WIN32
+// Locks whatever file path names, retrying if a compaction renamed another
+// file over it while we waited. The handle is -1 on failure.
+intptr_t lockPath(const std::string& path, bool exclusive)
+{
+    for (;;) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return -1;
+        }
+        if (flock(fd, exclusive ? LOCK_EX | LOCK_NB : LOCK_SH) != 0) {
+            ::close(fd);
+            return -1;
+        }
+        struct stat locked, current;
+        if (fstat(fd, &locked) == 0 && stat(path.c_str(), &current) == 0 && locked.st_dev == current.st_dev
+            && locked.st_ino == current.st_ino) {
+            return fd;
+        }
+        ::close(fd);
+    }
+}
+
+void unlockPath(intptr_t handle)
+{
+    if (handle >= 0) {
+        ::close(int(handle));
+    }
+}
+
+bool createFile(const std::string& path, std::size_t maxBytes, std::size_t recordBytes, std::string& error)
+{
+    // Built under a private name and linked into place, so no process can
+    // map a half-initialized header; if someone else won the race, use theirs.
+    std::string temporary = path + ".tmp." + std::to_string(getpid());
+    int fd = ::open(temporary.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        error = "cannot create " + temporary;
+        return false;
+    }
+    uint64_t slotCount, recordCapacity, fileBytes;
+    layoutFor(maxBytes, slotCount, recordCapacity, fileBytes, recordBytes);
+    char header[HeaderBytes] = {};
+    std::memcpy(header, "TPSC", 4);
+    std::memcpy(header + 4, &CacheVersion, 4);
+    std::memcpy(header + 8, &slotCount, 8);
+    std::memcpy(header + 16, &recordCapacity, 8);
+    std::memcpy(header + 24, &fileBytes, 8);
+    bool ok = ftruncate(fd, off_t(fileBytes)) == 0 && pwrite(fd, header, sizeof header, 0) == ssize_t(sizeof header)
+        && fsync(fd) == 0;
+    ::close(fd);
+    if (ok && link(temporary.c_str(), path.c_str()) != 0 && errno != EEXIST) {
+        ok = false;
+    }
+    unlink(temporary.c_str());
+    if (!ok) {
+        error = "cannot create " + path;
+    }
+    return ok;
+}
+#else
+intptr_t lockPath(const std::string& path, bool exclusive)
+{
+    for (;;) {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                  nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return -1;
+        }
+        // One byte far past the end, so the lock never blocks any I/O.
+        OVERLAPPED at = {};
+        at.OffsetHigh = 0x7fffffff;
+        if (!LockFileEx(file, exclusive ? LOCKFILE_EXCLUSIVE_LOCK | LOCKFILE_FAIL_IMMEDIATELY : 0, 0, 1, 0, &at)) {
+            CloseHandle(file);
+            return -1;
+        }
+        HANDLE current = CreateFileA(path.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                                     OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        BY_HANDLE_FILE_INFORMATION locked, named;
+        bool same = current != INVALID_HANDLE_VALUE && GetFileInformationByHandle(file, &locked)
+            && GetFileInformationByHandle(current, &named) && locked.dwVolumeSerialNumber == named.dwVolumeSerialNumber
+            && locked.nFileIndexHigh == named.nFileIndexHigh && locked.nFileIndexLow == named.nFileIndexLow;
+        if (current != INVALID_HANDLE_VALUE) {
+            CloseHandle(current);
+        }
+        if (same) {
+            return intptr_t(file);
+        }
+        CloseHandle(file);
+    }
+}
+
+void unlockPath(intptr_t handle)
+{
+    if (handle != -1) {
+        CloseHandle(HANDLE(handle));
+    }
+}
+
+bool createFile(const std::string& path, std::size_t maxBytes, std::size_t recordBytes, std::string& error)
+{
+    std::string temporary = path + ".tmp." + std::to_string(GetCurrentProcessId());
+    HANDLE file = CreateFileA(temporary.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        error = "cannot create " + temporary;
+        return false;
+    }
+    uint64_t slotCount, recordCapacity, fileBytes;
+    layoutFor(maxBytes, slotCount, recordCapacity, fileBytes, recordBytes);
+    char header[HeaderBytes] = {};
+    std::memcpy(header, "TPSC", 4);
+    std::memcpy(header + 4, &CacheVersion, 4);
+    std::memcpy(header + 8, &slotCount, 8);
+    std::memcpy(header + 16, &recordCapacity, 8);
+    std::memcpy(header + 24, &fileBytes, 8);
+    LARGE_INTEGER size;
+    size.QuadPart = LONGLONG(fileBytes);
+    DWORD written = 0;
+    bool ok = SetFilePointerEx(file, size, nullptr, FILE_BEGIN) && SetEndOfFile(file);
+    size.QuadPart = 0;
+    ok = ok && SetFilePointerEx(file, size, nullptr, FILE_BEGIN) && WriteFile(file, header, sizeof header, &written, nullptr)
+        && FlushFileBuffers(file);
+    CloseHandle(file);
+    if (ok && !MoveFileExA(temporary.c_str(), path.c_str(), MOVEFILE_WRITE_THROUGH) && GetLastError() != ERROR_ALREADY_EXISTS) {
+        ok = false;
+    }
+    DeleteFileA(temporary.c_str());
+    if (!ok) {
+        error = "cannot create " + path;
+    }
+    return ok;
+}
+#endif
+
+}
+
+PersistentSolveCache::~PersistentSolveCache()
+{
+    close();
+}
+
+bool PersistentSolveCache::open(const std::string& path, std::size_t maxBytes, std::string& error)
+{
+    close();
+    if (!map(path, true, error)) {
+        close();
+        if (!createFile(path, maxBytes, sizeof(Record), error)) {
+            return false;
+        }
+        return map(path, true, error);
+    }
+    return true;
+}
+
+bool PersistentSolveCache::openReadOnly(const std::string& path, std::string& error)
+{
+    close();
+    return map(path, false, error);
+}
+
+bool PersistentSolveCache::map(const std::string& path, bool forWriting, std::string& error)
+{
+    // Taken before opening, so the file mapped is the one locked.
+    if (forWriting) {
+        lockHandle = lockPath(path, false);
+        if (lockHandle == -1) {
+            error = "cannot open " + path;
+            return false;
+        }
+    }
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), forWriting ? O_RDWR : O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open " + path;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || std::size_t(info.st_size) < HeaderBytes) {
+        ::close(fd);
+        error = path + " is not a solve cache";
+        return false;
+    }
+    void* address = mmap(nullptr, std::size_t(info.st_size), forWriting ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+        ::close(fd);
+        error = "cannot map " + path;
+        return false;
+    }
+    fileHandle = fd;
+    mappedBytes = std::size_t(info.st_size);
+#else
+    HANDLE file = CreateFileA(path.c_str(), forWriting ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER size;
+    if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &size) || std::size_t(size.QuadPart) < HeaderBytes) {
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+        }
+        error = "cannot open " + path;
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, forWriting ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+    void* address = mapping ? MapViewOfFile(mapping, forWriting ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!address) {
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        error = "cannot map " + path;
+        return false;
+    }
+    fileHandle = intptr_t(file);
+    mappingHandle = intptr_t(mapping);
+    mappedBytes = std::size_t(size.QuadPart);
+#endif
+    base = static_cast<char*>(address);
+    writable = forWriting;
+    header = reinterpret_cast<Header*>(base);
+    uint64_t slotCount = header->slotCount;
+    if (std::memcmp(header->magic, "TPSC", 4) != 0 || header->version != CacheVersion || header->fileBytes != mappedBytes
+        || slotCount == 0 || (slotCount & (slotCount - 1)) != 0
+        || HeaderBytes + slotCount * 8 + header->recordCapacity * sizeof(Record) > mappedBytes) {
+        close();
+        error = path + " is not a solve cache";
+        return false;
+    }
+    slots = reinterpret_cast<std::atomic<uint64_t>*>(base + HeaderBytes);
+    records = reinterpret_cast<Record*>(base + HeaderBytes + slotCount * 8);
+    return true;
+}
+
+void PersistentSolveCache::close()
+{
+    // Also reached when map failed part-way, with the lock taken but nothing mapped.
+    unlockPath(lockHandle);
+    lockHandle = -1;
+    if (!base) {
+        return;
+    }
+#ifndef _WIN32
+    munmap(base, mappedBytes);
+    ::close(int(fileHandle));
+#else
+    UnmapViewOfFile(base);
+    CloseHandle(HANDLE(mappingHandle));
+    CloseHandle(HANDLE(fileHandle));
+#endif
+    base = nullptr;
+    header = nullptr;
+    slots = nullptr;
+    records = nullptr;
+    fileHandle = -1;
+    mappingHandle = 0;
+    mappedBytes = 0;
+}
+
+const PersistentSolveCache::Record* PersistentSolveCache::record(uint64_t index) const
+{
+    uint64_t appended = std::min(header->records.load(std::memory_order_acquire), header->recordCapacity);
+    return index < appended ? &records[index] : nullptr;
+}
+
+bool PersistentSolveCache::recordValid(const Record& candidate) const
+{
+    return candidate.mask != 0
+        && recordChecksum(candidate.inputs, sizeof candidate.inputs + sizeof candidate.outputs) == candidate.checksum;
+}
+
+void PersistentSolveCache::fillInputs(const Record& source, TriangleValues& inputs)
+{
+    inputs = TriangleValues();
+    for (int field = 0; field < InputFieldCount; field++) {
+        fieldValue(inputs, field) = source.inputs[field];
+    }
+}
+
+const PersistentSolveCache::Record* PersistentSolveCache::find(const double* inputs, uint32_t mask, uint64_t hash) const
+{
+    uint64_t slotMask = header->slotCount - 1;
+    for (std::size_t probe = 0; probe < ProbeLimit; probe++) {
+        uint64_t value = slots[(hash + probe) & slotMask].load(std::memory_order_acquire);
+        if (value == 0) {
+            return nullptr;
+        }
+        if ((value >> 32) != (hash >> 32)) {
+            continue;
+        }
+        const Record* candidate = record((value & 0xffffffffull) - 1);
+        if (candidate && candidate->mask == mask
+            && std::memcmp(candidate->inputs, inputs, sizeof candidate->inputs) == 0 && recordValid(*candidate)) {
+            return candidate;
+        }
+    }
+    return nullptr;
+}
+
+bool PersistentSolveCache::lookup(const TriangleValues& inputs, TriangleValues& result) const
+{
+    if (!base) {
+        return false;
+    }
+    lookups.fetch_add(1, std::memory_order_relaxed);
+    uint32_t mask = inputMask(&inputs.AB);
+    const Record* found = find(&inputs.AB, mask, hashInputs(&inputs.AB, mask));
+    if (!found) {
+        return false;
+    }
+    hits.fetch_add(1, std::memory_order_relaxed);
+    std::memcpy(&result.AB, found->outputs, sizeof found->outputs);
+    return true;
+}
+
+bool PersistentSolveCache::insert(const TriangleValues& inputs, const TriangleValues& result)
+{
+    uint32_t mask = inputMask(&inputs.AB);
+    return insert(&inputs.AB, mask, hashInputs(&inputs.AB, mask), result);
+}
+
+bool PersistentSolveCache::insert(const double* inputs, uint32_t mask, uint64_t hash, const TriangleValues& result)
+{
+    if (!base || !writable || mask == 0) {
+        return false;
+    }
+    if (header->records.load(std::memory_order_relaxed) >= header->recordCapacity) {
+        insertFailures.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    uint64_t index = header->records.fetch_add(1, std::memory_order_acq_rel);
+    if (index >= header->recordCapacity) {
+        insertFailures.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    Record& target = records[index];
+    std::memcpy(target.inputs, inputs, sizeof target.inputs);
+    std::memcpy(target.outputs, &result.AB, sizeof target.outputs);
+    target.checksum = recordChecksum(target.inputs, sizeof target.inputs + sizeof target.outputs);
+    target.mask = mask;
+
+    // Publishing is the commit point: the record is complete before any reader can reach it.
+    uint64_t slotMask = header->slotCount - 1;
+    uint64_t published = slotValue(hash, index);
+    for (std::size_t probe = 0; probe < ProbeLimit; probe++) {
+        std::atomic<uint64_t>& slot = slots[(hash + probe) & slotMask];
+        uint64_t expected = 0;
+        if (slot.compare_exchange_strong(expected, published, std::memory_order_release, std::memory_order_acquire)) {
+            inserts.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        if ((expected >> 32) == (hash >> 32)) {
+            const Record* other = record((expected & 0xffffffffull) - 1);
+            if (other && other->mask == mask && std::memcmp(other->inputs, target.inputs, sizeof target.inputs) == 0) {
+                return true; // another thread or process got there first
+            }
+        }
+    }
+    insertFailures.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void PersistentSolveCache::solve(TriangleValues& values)
+{
+    TriangleValues inputs = values;
+    if (lookup(inputs, values)) {
+        return;
+    }
+    solveTriangle(values);
+    insert(inputs, values);
+}
+
+void PersistentSolveCache::solve(const TriangleValues* inputs, TriangleValues* outputs, std::size_t count)
+{
+    // A lookup is one index slot and one record, both far apart in a large
+    // file. Reading the first slot of every row in a group before resolving
+    // any of them lets those cache misses overlap instead of costing a full
+    // memory round trip per row.
+    const std::size_t group = 16;
+    uint32_t masks[group];
+    uint64_t hashes[group];
+    const Record* candidates[group] = {};
+    uint32_t candidateMasks[group] = {};
+    std::size_t found = 0;
+    for (std::size_t begin = 0; begin < count; begin += group) {
+        std::size_t rows = std::min(group, count - begin);
+        for (std::size_t i = 0; i < rows; i++) {
+            const double* row = &inputs[begin + i].AB;
+            masks[i] = inputMask(row);
+            hashes[i] = hashInputs(row, masks[i]);
+        }
+        if (base) {
+            uint64_t slotMask = header->slotCount - 1;
+            uint64_t firstSlots[group];
+            for (std::size_t i = 0; i < rows; i++) {
+                firstSlots[i] = slots[hashes[i] & slotMask].load(std::memory_order_acquire);
+            }
+            // Then the records those slots name, again all before any is compared.
+            for (std::size_t i = 0; i < rows; i++) {
+                bool tagged = firstSlots[i] != 0 && (firstSlots[i] >> 32) == (hashes[i] >> 32);
+                candidates[i] = tagged ? record((firstSlots[i] & 0xffffffffull) - 1) : nullptr;
+                candidateMasks[i] = candidates[i] ? candidates[i]->mask : 0;
+            }
+        }
+        for (std::size_t i = 0; i < rows; i++) {
+            const double* row = &inputs[begin + i].AB;
+            const Record* hit = nullptr;
+            if (candidateMasks[i] == masks[i] && std::memcmp(candidates[i]->inputs, row, sizeof candidates[i]->inputs) == 0
+                && recordValid(*candidates[i])) {
+                hit = candidates[i];
+            } else if (base) {
+                hit = find(row, masks[i], hashes[i]);
+            }
+            if (hit) {
+                std::memcpy(&outputs[begin + i].AB, hit->outputs, sizeof hit->outputs);
+                found++;
+                continue;
+            }
+            outputs[begin + i] = inputs[begin + i];
+            solveTriangle(outputs[begin + i]);
+            insert(row, masks[i], hashes[i], outputs[begin + i]);
+        }
+    }
+    if (base) {
+        lookups.fetch_add(count, std::memory_order_relaxed);
+        hits.fetch_add(found, std::memory_order_relaxed);
+    }
+}
+
+PersistentCacheStats PersistentSolveCache::stats() const
+{
+    PersistentCacheStats result;
+    result.lookups = lookups.load(std::memory_order_relaxed);
+    result.hits = hits.load(std::memory_order_relaxed);
+    result.inserts = inserts.load(std::memory_order_relaxed);
+    result.insertFailures = insertFailures.load(std::memory_order_relaxed);
+    if (header) {
+        result.recordCapacity = std::size_t(header->recordCapacity);
+        result.records = std::size_t(std::min(header->records.load(std::memory_order_relaxed), header->recordCapacity));
+    }
+    return result;
+}
+
+void PersistentSolveCache::forEachRecord(const std::function<void(const TriangleValues&, const TriangleValues&)>& visit) const
+{
+    if (!base) {
+        return;
+    }
+    uint64_t appended = std::min(header->records.load(std::memory_order_acquire), header->recordCapacity);
+    TriangleValues inputs;
+    TriangleValues result;
+    for (uint64_t index = 0; index < appended; index++) {
+        const Record& candidate = records[index];
+        if (!recordValid(candidate)) {
+            continue;
+        }
+        fillInputs(candidate, inputs);
+        for (int field = 0; field < FieldCount; field++) {
+            fieldValue(result, field) = candidate.outputs[field];
+        }
+        visit(inputs, result);
+    }
+}
+
+bool compactSolveCache(const std::string& path, std::size_t maxBytes, std::string& error)
+{
+    // Held until the rename, so no writer can insert into the file being copied.
+    struct Lock {
+        intptr_t handle;
+        ~Lock() { unlockPath(handle); }
+    } lock{lockPath(path, true)};
+    if (lock.handle == -1) {
+        error = "cannot compact " + path + ": missing, or open for writing by another process";
+        return false;
+    }
+    PersistentSolveCache source;
+    if (!source.openReadOnly(path, error)) {
+        return false;
+    }
+    std::vector<std::pair<TriangleValues, TriangleValues>> kept;
+    source.forEachRecord([&](const TriangleValues& inputs, const TriangleValues& result) {
+        kept.emplace_back(inputs, result);
+    });
+    source.close();
+
+    std::string compacted = path + ".compact";
+    std::remove(compacted.c_str());
+    PersistentSolveCache target;
+    if (!target.open(compacted, maxBytes, error)) {
+        return false;
+    }
+    // Walk newest first to pick what survives (the newest copy of each key,
+    // as many as fit), then insert oldest first so the file stays in age order.
+    std::size_t capacity = target.stats().recordCapacity;
+    std::unordered_set<std::string> seen;
+    std::vector<std::size_t> survivors;
+    for (std::size_t i = kept.size(); i-- > 0 && survivors.size() < capacity;) {
+        const TriangleValues& inputs = kept[i].first;
+        if (seen.insert(std::string(reinterpret_cast<const char*>(&inputs.AB), InputFieldCount * sizeof(double))).second) {
+            survivors.push_back(i);
+        }
+    }
+    for (std::size_t j = survivors.size(); j-- > 0;) {
+        target.insert(kept[survivors[j]].first, kept[survivors[j]].second);
+    }
+    target.close();
+
+#ifdef _WIN32
+    if (!MoveFileExA(compacted.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+#else
+    if (std::rename(compacted.c_str(), path.c_str()) != 0) {
+#endif
+        error = "cannot replace " + path;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,105 @@
+#ifndef PERSISTENTCACHE_H
+#define PERSISTENTCACHE_H
+
+#include "triangleCore.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// On-disk solve cache that batch workers map at startup and share across
+// processes: (known mask, exact input bits) -> all 18 outputs. There is no
+// loading step; lookups read the mapped file directly.
+//
+// File layout ("TPSC"): a 4 KB header, an open-addressing index of 64-bit
+// slots, then fixed-size records appended in order. An insert appends its
+// record first and only then publishes it into the index with one CAS, so
+// a writer that dies part-way leaves at most an unreachable record. Every
+// record carries a checksum and readers skip any that do not match. The
+// file never grows past the size it was created with; once the records are
+// used up inserts fail until compactSolveCache rewrites the file.
+//
+// Several processes may read and insert at once. Writers hold a shared lock
+// on the file while it is open and compaction needs it exclusively, so a
+// compaction fails rather than drop inserts while any writer is attached.
+// It replaces the file by rename: read-only processes that already have it
+// open keep using the old copy until they reopen.
+//
+// A warm hit still costs about twice a solveTriangle solve (bench persistent:
+// about 130 ns against 70 ns a row, cold about 350 ns), so nothing attaches
+// the cache by default; it pays only for results that are dearer to compute
+// than that.
+
+struct PersistentCacheStats {
+    std::size_t lookups = 0;
+    std::size_t hits = 0;
+    std::size_t inserts = 0;
+    std::size_t insertFailures = 0; // file full, or no free slot within the probe window
+    std::size_t records = 0;        // in the file, from every process
+    std::size_t recordCapacity = 0;
+
+    double hitRate() const { return lookups ? double(hits) / lookups : 0.0; }
+};
+
+class PersistentSolveCache
+{
+public:
+    PersistentSolveCache() = default;
+    PersistentSolveCache(const PersistentSolveCache&) = delete;
+    PersistentSolveCache& operator=(const PersistentSolveCache&) = delete;
+    ~PersistentSolveCache();
+
+    // Maps path, creating it with room for maxBytes if it does not exist
+    // (maxBytes is ignored for an existing file). Returns false and sets error on failure.
+    bool open(const std::string& path, std::size_t maxBytes, std::string& error);
+    bool openReadOnly(const std::string& path, std::string& error);
+    void close();
+    bool isOpen() const { return base != nullptr; }
+
+    // Thread safe, lock-free.
+    bool lookup(const TriangleValues& inputs, TriangleValues& result) const;
+    bool insert(const TriangleValues& inputs, const TriangleValues& result);
+    // lookup, or solveTriangle and insert.
+    void solve(TriangleValues& values);
+    // The same for count rows, with the lookups of neighbouring rows overlapped.
+    void solve(const TriangleValues* inputs, TriangleValues* outputs, std::size_t count);
+
+    PersistentCacheStats stats() const;
+
+    // Calls visit(inputs, result) for every valid record, oldest first.
+    void forEachRecord(const std::function<void(const TriangleValues&, const TriangleValues&)>& visit) const;
+
+private:
+    struct Header;
+    struct Record;
+
+    bool map(const std::string& path, bool writable, std::string& error);
+    const Record* find(const double* inputs, uint32_t mask, uint64_t hash) const;
+    bool insert(const double* inputs, uint32_t mask, uint64_t hash, const TriangleValues& result);
+    const Record* record(uint64_t index) const;
+    bool recordValid(const Record& record) const;
+    static void fillInputs(const Record& record, TriangleValues& inputs);
+
+    char* base = nullptr;
+    std::size_t mappedBytes = 0;
+    bool writable = false;
+    Header* header = nullptr;
+    std::atomic<uint64_t>* slots = nullptr;
+    Record* records = nullptr;
+    intptr_t fileHandle = -1;
+    intptr_t mappingHandle = 0; // Windows only
+    intptr_t lockHandle = -1;   // writers only
+
+    mutable std::atomic<std::size_t> lookups{0};
+    mutable std::atomic<std::size_t> hits{0};
+    std::atomic<std::size_t> inserts{0};
+    std::atomic<std::size_t> insertFailures{0};
+};
+
+// Rewrites path with room for maxBytes, keeping the newest valid records
+// that fit and dropping unreachable or corrupt ones. Fails if another
+// process has path open for writing or is compacting it.
+bool compactSolveCache(const std::string& path, std::size_t maxBytes, std::string& error);
+
+#endif // PERSISTENTCACHE_H
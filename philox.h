@@ -0,0 +1,43 @@
+#ifndef PHILOX_H
+#define PHILOX_H
+
+#include <cstdint>
+
+// Philox4x32-10 counter-based generator (Salmon et al., "Parallel random
+// numbers: as easy as 1, 2, 3"). The output is a pure function of
+// (counter, key), so any thread can draw sample i without sharing state
+// and results do not depend on the thread count.
+struct Philox4x32 {
+    uint32_t key[2];
+
+    explicit Philox4x32(uint64_t seed) : key{uint32_t(seed), uint32_t(seed >> 32)} {}
+
+    void operator()(const uint32_t (&counter)[4], uint32_t (&out)[4]) const {
+        uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+        uint32_t k0 = key[0], k1 = key[1];
+        for (int round = 0; round < 10; round++) {
+            uint64_t p0 = uint64_t(0xD2511F53u) * c0;
+            uint64_t p1 = uint64_t(0xCD9E8D57u) * c2;
+            uint32_t n0 = uint32_t(p1 >> 32) ^ c1 ^ k0;
+            uint32_t n2 = uint32_t(p0 >> 32) ^ c3 ^ k1;
+            c0 = n0;
+            c1 = uint32_t(p1);
+            c2 = n2;
+            c3 = uint32_t(p0);
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        out[0] = c0;
+        out[1] = c1;
+        out[2] = c2;
+        out[3] = c3;
+    }
+};
+
+// Maps a 32-bit draw to (0, 1), never hitting either end.
+inline double philoxUniform(uint32_t bits)
+{
+    return (bits + 0.5) * (1.0 / 4294967296.0);
+}
+
+#endif // PHILOX_H
@@ -0,0 +1,281 @@
+#include "reconcile.h"
+#include "sensitivity.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int SideFields[3] = {Field_AB, Field_AC, Field_BC};
+
+// The knowns of one row with their weights.
+struct Problem {
+    int count = 0;
+    int fields[InputFieldCount];
+    double measured[InputFieldCount];
+    double weight[InputFieldCount];
+    bool hasLength = false; // angles alone fix the shape but not the size
+};
+
+// Weighted residuals at one set of sides, and their Jacobian against the log-sides.
+struct Evaluation {
+    TriangleValues values;
+    double r[InputFieldCount];
+    double J[InputFieldCount][3];
+    double cost = std::numeric_limits<double>::infinity(); // sum of r^2
+};
+
+void setUp(const TriangleValues& measured, const double* weights, Problem& problem)
+{
+    for (int field = 0; field < InputFieldCount; field++) {
+        double value = fieldValue(measured, field);
+        if (!(value > 0)) {
+            continue;
+        }
+        int k = problem.count++;
+        problem.fields[k] = field;
+        problem.measured[k] = value;
+        problem.weight[k] = weights && weights[field] > 0 ? weights[field] : 1 / value;
+        problem.hasLength = problem.hasLength || (field != Field_angleA && field != Field_angleB && field != Field_angleC);
+    }
+}
+
+bool closes(const double (&sides)[3])
+{
+    double longest = std::max(sides[0], std::max(sides[1], sides[2]));
+    return std::min(sides[0], std::min(sides[1], sides[2])) > 0 && 2 * longest < sides[0] + sides[1] + sides[2];
+}
+
+// Returns false (cost infinite) when the sides make no triangle.
+bool evaluate(const Problem& problem, const double (&sides)[3], Evaluation& e)
+{
+    e.cost = std::numeric_limits<double>::infinity();
+    if (!closes(sides)) {
+        return false;
+    }
+    TriangleValues values;
+    values.AB = sides[0];
+    values.AC = sides[1];
+    values.BC = sides[2];
+    TriangleJacobian jacobian;
+    solveWithJacobian(values, jacobian);
+
+    double cost = 0;
+    for (int k = 0; k < problem.count; k++) {
+        int field = problem.fields[k];
+        double w = problem.weight[k];
+        e.r[k] = w * (fieldValue(values, field) - problem.measured[k]);
+        cost += e.r[k] * e.r[k];
+        for (int s = 0; s < 3; s++) {
+            // d/d(log side) = side * d/d(side)
+            e.J[k][s] = w * jacobian(field, SideFields[s]) * sides[s];
+        }
+    }
+    if (!std::isfinite(cost)) {
+        return false;
+    }
+    e.values = values;
+    e.cost = cost;
+    return true;
+}
+
+// Solves the 3x3 system m x = b by Cramer's rule.
+bool solve3(const double (&m)[3][3], const double (&b)[3], double (&x)[3])
+{
+    double c0 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    double c1 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+    double c2 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+    double det = m[0][0] * c0 + m[0][1] * c1 + m[0][2] * c2;
+    if (!(std::fabs(det) > 0) || !std::isfinite(det)) {
+        return false;
+    }
+    double inverse = 1 / det;
+    x[0] = (b[0] * c0 + m[0][1] * (m[1][2] * b[2] - b[1] * m[2][2]) + m[0][2] * (b[1] * m[2][1] - m[1][1] * b[2])) * inverse;
+    x[1] = (m[0][0] * (b[1] * m[2][2] - m[1][2] * b[2]) + b[0] * c1 + m[0][2] * (m[1][0] * b[2] - b[1] * m[2][0])) * inverse;
+    x[2] = (m[0][0] * (m[1][1] * b[2] - b[1] * m[2][1]) + m[0][1] * (b[1] * m[2][0] - m[1][0] * b[2]) + b[0] * c2) * inverse;
+    return std::isfinite(x[0]) && std::isfinite(x[1]) && std::isfinite(x[2]);
+}
+
+// Start from the closed-form solve of the knowns (the first matching
+// branch), or failing that an equilateral triangle of the knowns' size.
+bool closedFormStart(const TriangleValues& measured, const Problem& problem, double (&sides)[3])
+{
+    TriangleValues solved = measured;
+    solveTriangle(solved);
+    sides[0] = solved.AB;
+    sides[1] = solved.AC;
+    sides[2] = solved.BC;
+    if (closes(sides)) {
+        return true;
+    }
+    double size = 0;
+    int lengths = 0;
+    for (int k = 0; k < problem.count; k++) {
+        int field = problem.fields[k];
+        if (field == Field_angleA || field == Field_angleB || field == Field_angleC) {
+            continue;
+        }
+        // Side of the equilateral triangle with this area, otherwise the length itself.
+        size += field == Field_Area ? std::sqrt(problem.measured[k] * 4 / std::sqrt(3.0)) : problem.measured[k];
+        lengths++;
+    }
+    if (!lengths) {
+        return false;
+    }
+    sides[0] = sides[1] = sides[2] = size / lengths;
+    return true;
+}
+
+void fit(const Problem& problem, double (&sides)[3], Evaluation& current, ReconcileResult& result,
+         const ReconcileOptions& options)
+{
+    Evaluation trial;
+    double lambda = 1e-3;
+    result.converged = false;
+    result.iterations = 0;
+    while (result.iterations < options.maxIterations) {
+        result.iterations++;
+        double a[3][3] = {};
+        double g[3] = {};
+        for (int k = 0; k < problem.count; k++) {
+            for (int i = 0; i < 3; i++) {
+                g[i] -= current.J[k][i] * current.r[k];
+                for (int j = 0; j < 3; j++) {
+                    a[i][j] += current.J[k][i] * current.J[k][j];
+                }
+            }
+        }
+
+        bool stepped = false;
+        double step = 0;
+        while (lambda < 1e12) {
+            double m[3][3];
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 3; j++) {
+                    m[i][j] = a[i][j];
+                }
+                m[i][i] += lambda * (a[i][i] + 1e-12);
+            }
+            double delta[3];
+            double next[3];
+            if (solve3(m, g, delta)) {
+                for (int s = 0; s < 3; s++) {
+                    next[s] = sides[s] * std::exp(delta[s]);
+                }
+                if (evaluate(problem, next, trial) && trial.cost <= current.cost) {
+                    step = std::max(std::fabs(delta[0]), std::max(std::fabs(delta[1]), std::fabs(delta[2])));
+                    std::copy(next, next + 3, sides);
+                    std::swap(current, trial);
+                    lambda = std::max(lambda / 3, 1e-12);
+                    stepped = true;
+                    break;
+                }
+            }
+            lambda *= 4;
+        }
+        // No downhill step at any damping: the fit is at its minimum to rounding.
+        if (!stepped || step < options.tolerance) {
+            result.converged = true;
+            break;
+        }
+    }
+}
+
+void finish(const Problem& problem, const Evaluation& current, ReconcileResult& result)
+{
+    result.values = current.values;
+    std::fill_n(result.residuals, InputFieldCount, 0.0);
+    for (int k = 0; k < problem.count; k++) {
+        result.residuals[problem.fields[k]] = fieldValue(current.values, problem.fields[k]) - problem.measured[k];
+    }
+    result.rms = std::sqrt(current.cost / problem.count);
+}
+
+}
+
+bool reconcileTriangle(const TriangleValues& measured, const double* weights, ReconcileResult& result,
+                       const ReconcileOptions& options, const double* start)
+{
+    result = ReconcileResult();
+    result.values = measured;
+    Problem problem;
+    setUp(measured, weights, problem);
+    result.knowns = problem.count;
+    if (problem.count < 3 || !problem.hasLength) {
+        return false;
+    }
+
+    double sides[3];
+    Evaluation current;
+    if (start) {
+        std::copy(start, start + 3, sides);
+        evaluate(problem, sides, current);
+    }
+    if (!std::isfinite(current.cost) && !(closedFormStart(measured, problem, sides) && evaluate(problem, sides, current))) {
+        return false;
+    }
+    fit(problem, sides, current, result, options);
+    finish(problem, current, result);
+    return true;
+}
+
+std::size_t reconcileBatch(const TriangleValues* measured, std::size_t count, const double* weights,
+                           ReconcileResult* results, const ReconcileOptions& options)
+{
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = unsigned(std::min<std::size_t>(threads, std::max<std::size_t>(count / 64, 1)));
+    std::vector<std::size_t> converged(threads);
+
+    auto work = [&](unsigned t) {
+        std::size_t begin = count * t / threads;
+        std::size_t end = count * (t + 1) / threads;
+        std::size_t rowsConverged = 0;
+        double previous[3] = {0, 0, 0};
+        Evaluation current;
+        Evaluation warm;
+        for (std::size_t row = begin; row < end; row++) {
+            ReconcileResult& result = results[row];
+            result = ReconcileResult();
+            result.values = measured[row];
+            Problem problem;
+            setUp(measured[row], weights, problem);
+            result.knowns = problem.count;
+            if (problem.count < 3 || !problem.hasLength) {
+                continue;
+            }
+
+            // Take whichever start fits this row's inputs better.
+            double sides[3];
+            bool haveStart = closedFormStart(measured[row], problem, sides) && evaluate(problem, sides, current);
+            if (evaluate(problem, previous, warm) && warm.cost < current.cost) {
+                std::copy(previous, previous + 3, sides);
+                std::swap(current, warm);
+                haveStart = true;
+            }
+            if (!haveStart) {
+                continue;
+            }
+            fit(problem, sides, current, result, options);
+            finish(problem, current, result);
+            rowsConverged += result.converged;
+            std::copy(sides, sides + 3, previous);
+        }
+        converged[t] = rowsConverged;
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++) {
+        workers.emplace_back(work, t);
+    }
+    work(0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    std::size_t total = 0;
+    for (std::size_t rows : converged) {
+        total += rows;
+    }
+    return total;
+}
@@ -0,0 +1,44 @@
+#ifndef RECONCILE_H
+#define RECONCILE_H
+
+#include "triangleCore.h"
+#include <cstddef>
+
+// Least-squares fit of a triangle to more knowns than it needs, for
+// measurement sets where solveTriangle would use the first three and ignore
+// the rest. The parameters are the logarithms of the three sides, so they
+// stay positive; every known input adds one weighted residual and the
+// Levenberg-Marquardt steps use the Jacobian from solveWithJacobian.
+
+struct ReconcileOptions {
+    int maxIterations = 50;
+    double tolerance = 1e-10; // converged once a step moves no side by more than this, relatively
+    unsigned threads = 0;     // reconcileBatch only; 0 = one per hardware thread
+};
+
+struct ReconcileResult {
+    TriangleValues values;                  // every quantity of the fitted triangle
+    double residuals[InputFieldCount] = {}; // fitted - measured for known inputs, 0 elsewhere
+    double rms = 0;                         // root mean square of the weighted residuals
+    int knowns = 0;
+    int iterations = 0;
+    bool converged = false;
+};
+
+// weights[field] is 1 / standard deviation for that input; a null array or
+// a 0 entry means 1 / value, i.e. the same relative error for every input.
+// start, if given, holds AB, AC and BC to start from (a warm start);
+// otherwise the fit starts from the closed-form solve of the knowns.
+// Returns false, with result.values = measured, when there are fewer than
+// three knowns, no length among them, or no usable start.
+bool reconcileTriangle(const TriangleValues& measured, const double* weights, ReconcileResult& result,
+                       const ReconcileOptions& options = ReconcileOptions(), const double* start = nullptr);
+
+// Fits count rows across threads. Each row starts from its closed-form
+// solve or from the previous row's fit, whichever matches its inputs
+// better, so runs of similar rows need only a few iterations.
+// Returns the number of rows that converged.
+std::size_t reconcileBatch(const TriangleValues* measured, std::size_t count, const double* weights,
+                           ReconcileResult* results, const ReconcileOptions& options = ReconcileOptions());
+
+#endif // RECONCILE_H
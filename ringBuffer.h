@@ -0,0 +1,220 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Bounded lock-free queues used to connect the batch pipeline stages.
+// Capacities are rounded up to a power of two and never grow, which is what
+// gives the pipeline its backpressure: a full queue stalls the producer.
+
+namespace ringDetail {
+const std::size_t CacheLine = 64;
+
+inline std::size_t roundUpPow2(std::size_t n) {
+    std::size_t size = 2;
+    while (size < n) {
+        size <<= 1;
+    }
+    return size;
+}
+
+// Spin a little, then give the core away; used while a queue is full or empty.
+inline void backoff(unsigned& spins) {
+    if (++spins < 64) {
+        return;
+    }
+    std::this_thread::yield();
+}
+
+// backoff calls the blocking helpers make before they park: 64 spins, then
+// yields until the budget is spent.
+const unsigned SpinBudget = 256;
+
+// Where the blocking helpers sleep once spinning has not helped. The other
+// side only takes the mutex when someone is parked, so a busy pipeline never
+// does; the fences pair the waiter count with the ring positions.
+class Parking
+{
+public:
+    template <typename Ready>
+    void wait(Ready ready) {
+        std::unique_lock<std::mutex> lock(mutex);
+        waiters.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        condition.wait(lock, ready);
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // Call after changing anything a parked ready() looks at.
+    void notify() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+        { std::lock_guard<std::mutex> lock(mutex); }
+        condition.notify_all();
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::atomic<unsigned> waiters{0};
+};
+}
+
+// Single producer, single consumer.
+template <typename T>
+class SpscRing
+{
+public:
+    explicit SpscRing(std::size_t capacity)
+        : mask(ringDetail::roundUpPow2(capacity) - 1)
+        , slots(new T[mask + 1])
+    {
+    }
+
+    bool tryPush(const T& value) {
+        std::size_t tail = tailPos.load(std::memory_order_relaxed);
+        if (tail - headPos.load(std::memory_order_acquire) > mask) {
+            return false;
+        }
+        slots[tail & mask] = value;
+        tailPos.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& value) {
+        std::size_t head = headPos.load(std::memory_order_relaxed);
+        if (head == tailPos.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = slots[head & mask];
+        headPos.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Used by pushWait and popWait; tryPush and tryPop never touch it.
+    ringDetail::Parking parking;
+
+private:
+    const std::size_t mask;
+    std::unique_ptr<T[]> slots;
+    alignas(ringDetail::CacheLine) std::atomic<std::size_t> headPos{0};
+    alignas(ringDetail::CacheLine) std::atomic<std::size_t> tailPos{0};
+};
+
+// Multi producer, multi consumer (Vyukov's bounded queue: one sequence number per cell).
+template <typename T>
+class MpmcRing
+{
+public:
+    explicit MpmcRing(std::size_t capacity)
+        : mask(ringDetail::roundUpPow2(capacity) - 1)
+        , cells(new Cell[mask + 1])
+    {
+        for (std::size_t i = 0; i <= mask; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool tryPush(const T& value) {
+        std::size_t pos = tailPos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = std::ptrdiff_t(seq) - std::ptrdiff_t(pos);
+            if (diff == 0) {
+                if (tailPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = tailPos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& value) {
+        std::size_t pos = headPos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = std::ptrdiff_t(seq) - std::ptrdiff_t(pos + 1);
+            if (diff == 0) {
+                if (headPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = cell.value;
+                    cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = headPos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Used by pushWait and popWait; tryPush and tryPop never touch it.
+    ringDetail::Parking parking;
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    const std::size_t mask;
+    std::unique_ptr<Cell[]> cells;
+    alignas(ringDetail::CacheLine) std::atomic<std::size_t> headPos{0};
+    alignas(ringDetail::CacheLine) std::atomic<std::size_t> tailPos{0};
+};
+
+// Blocking helpers for stage loops: spin, then park until the other side
+// pushes or pops. Every ring operation a parked stage could be waiting on
+// has to go through these, so that it wakes the ring's waiters.
+template <typename Ring, typename T>
+void pushWait(Ring& ring, const T& value) {
+    unsigned spins = 0;
+    while (!ring.tryPush(value)) {
+        if (spins >= ringDetail::SpinBudget) {
+            ring.parking.wait([&] { return ring.tryPush(value); });
+            break;
+        }
+        ringDetail::backoff(spins);
+    }
+    ring.parking.notify();
+}
+
+// Also gives up, returning false, once stop() holds; whoever makes it hold
+// calls ring.parking.notify().
+template <typename Ring, typename T, typename Stop>
+bool popWaitUnless(Ring& ring, T& value, Stop stop) {
+    unsigned spins = 0;
+    bool popped;
+    while (!(popped = ring.tryPop(value)) && !stop()) {
+        if (spins >= ringDetail::SpinBudget) {
+            ring.parking.wait([&] { return (popped = ring.tryPop(value)) || stop(); });
+            break;
+        }
+        ringDetail::backoff(spins);
+    }
+    if (popped) {
+        ring.parking.notify();
+    }
+    return popped;
+}
+
+template <typename Ring, typename T>
+void popWait(Ring& ring, T& value) {
+    popWaitUnless(ring, value, [] { return false; });
+}
+
+#endif // RINGBUFFER_H
@@ -0,0 +1,739 @@
+#include "ruleSet.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <tuple>
+
+namespace {
+
+enum Op : uint8_t {
+    Op_Load,  // DAG only: an input field
+    Op_Const, // DAG only: becomes a constant register
+    Op_Add,
+    Op_Sub,
+    Op_Mul,
+    Op_Div,
+    Op_Neg,
+    Op_Sqrt,
+    Op_Abs,
+    Op_Min,
+    Op_Max,
+    Op_Pow,
+    Op_Sin,
+    Op_Cos,
+    Op_Tan,
+    Op_Asin,
+    Op_Acos,
+    Op_Atan,
+    Op_Atan2,
+};
+
+bool isUnary(Op op)
+{
+    return op == Op_Neg || op == Op_Sqrt || op == Op_Abs || (op >= Op_Sin && op <= Op_Atan);
+}
+
+bool isCommutative(Op op)
+{
+    return op == Op_Add || op == Op_Mul || op == Op_Min || op == Op_Max;
+}
+
+struct Function {
+    const char* name;
+    Op op;
+    int arguments;
+};
+
+// square(x) is x * x, the same multiplication solveTriangle does.
+const Function kFunctions[] = {
+    {"sqrt", Op_Sqrt, 1}, {"abs", Op_Abs, 1}, {"min", Op_Min, 2}, {"max", Op_Max, 2},
+    {"pow", Op_Pow, 2}, {"square", Op_Mul, 1}, {"sin", Op_Sin, 1}, {"cos", Op_Cos, 1},
+    {"tan", Op_Tan, 1}, {"asin", Op_Asin, 1}, {"acos", Op_Acos, 1}, {"atan", Op_Atan, 1},
+    {"atan2", Op_Atan2, 2},
+};
+
+const Function* findFunction(const std::string& name)
+{
+    for (const Function& function : kFunctions) {
+        if (name == function.name) {
+            return &function;
+        }
+    }
+    return nullptr;
+}
+
+int findField(const std::string& name)
+{
+    for (int field = 0; field < FieldCount; field++) {
+        if (name == kTriangleFieldNames[field]) {
+            return field;
+        }
+    }
+    return -1;
+}
+
+// The trig goes through the same helpers as solveTriangle, angle tables included.
+inline double apply(Op op, double x, double y)
+{
+    switch (op) {
+    case Op_Add: return x + y;
+    case Op_Sub: return x - y;
+    case Op_Mul: return x * y;
+    case Op_Div: return x / y;
+    case Op_Neg: return -x;
+    case Op_Sqrt: return std::sqrt(x);
+    case Op_Abs: return std::fabs(x);
+    case Op_Min: return std::min(x, y);
+    case Op_Max: return std::max(x, y);
+    case Op_Pow: return std::pow(x, y);
+    case Op_Sin: return sinDegrees(x);
+    case Op_Cos: return cosDegrees(x);
+    case Op_Tan: return tanDegrees(x);
+    case Op_Asin: return toDegrees(std::asin(x));
+    case Op_Acos: return toDegrees(std::acos(x));
+    case Op_Atan: return toDegrees(std::atan(x));
+    case Op_Atan2: return toDegrees(std::atan2(x, y));
+    default: return 0;
+    }
+}
+
+struct Node {
+    Op op;
+    int a = -1; // operand node, or the field for Op_Load
+    int b = -1;
+    double value = 0;
+};
+
+// Hash-consed expression DAG of one rule: asking twice for the same
+// operation on the same operands gives the same node.
+class Dag
+{
+public:
+    int load(int field) { return intern({Op_Load, field, -1, 0}); }
+    int constant(double value) { return intern({Op_Const, -1, -1, value}); }
+
+    int operation(Op op, int a, int b) {
+        writtenOperations++;
+        if (op == Op_Pow && nodes[b].op == Op_Const && nodes[b].value == 2) {
+            op = Op_Mul; // x^2 as x * x, exact where pow need not be
+            b = a;
+        }
+        if (isUnary(op)) {
+            b = -1;
+        }
+        bool constantOperands = nodes[a].op == Op_Const && (b < 0 || nodes[b].op == Op_Const);
+        if (constantOperands) {
+            return constant(apply(op, nodes[a].value, b < 0 ? 0 : nodes[b].value));
+        }
+        if (isCommutative(op) && b < a) {
+            std::swap(a, b);
+        }
+        return intern({op, a, b, 0});
+    }
+
+    const std::vector<Node>& all() const { return nodes; }
+    int written() const { return writtenOperations; }
+
+private:
+    int intern(const Node& node) {
+        uint64_t bits;
+        std::memcpy(&bits, &node.value, sizeof bits);
+        auto key = std::make_tuple(int(node.op), node.a, node.b, bits);
+        auto found = index.find(key);
+        if (found != index.end()) {
+            return found->second;
+        }
+        nodes.push_back(node);
+        index.emplace(key, int(nodes.size() - 1));
+        return int(nodes.size() - 1);
+    }
+
+    std::vector<Node> nodes;
+    std::map<std::tuple<int, int, int, uint64_t>, int> index;
+    int writtenOperations = 0;
+};
+
+struct Token {
+    enum Kind { Name, Number, Symbol, End } kind;
+    std::string text;
+    double number = 0;
+};
+
+bool tokenize(const std::string& text, std::vector<Token>& tokens, std::string& error)
+{
+    tokens.clear();
+    std::size_t i = 0;
+    while (i < text.size()) {
+        char c = text[i];
+        if (c == ' ' || c == '\t' || c == '\r') {
+            i++;
+        } else if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            std::size_t begin = i;
+            while (i < text.size() && (std::isalnum(static_cast<unsigned char>(text[i])) || text[i] == '_')) {
+                i++;
+            }
+            tokens.push_back({Token::Name, text.substr(begin, i - begin)});
+        } else if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+            Token token{Token::Number, {}};
+            auto [end, ec] = std::from_chars(text.data() + i, text.data() + text.size(), token.number);
+            if (ec != std::errc()) {
+                error = "bad number";
+                return false;
+            }
+            token.text.assign(text.data() + i, end);
+            i = end - text.data();
+            tokens.push_back(token);
+        } else if (std::strchr("+-*/^(),=", c)) {
+            tokens.push_back({Token::Symbol, std::string(1, c)});
+            i++;
+        } else {
+            error = std::string("unexpected character '") + c + "'";
+            return false;
+        }
+    }
+    tokens.push_back({Token::End, {}});
+    return true;
+}
+
+// Recursive descent over one statement's tokens, building DAG nodes directly.
+class ExpressionParser
+{
+public:
+    ExpressionParser(const std::vector<Token>& tokens, std::size_t position, Dag& dag,
+                     const std::map<std::string, int>& symbols)
+        : tokens(tokens), position(position), dag(dag), symbols(symbols) {}
+
+    // Parses the rest of the statement; false with error set on a syntax or name error.
+    bool parse(int& node, std::string& message) {
+        node = expression();
+        if (error.empty() && tokens[position].kind != Token::End) {
+            error = "unexpected '" + tokens[position].text + "'";
+        }
+        message = error;
+        return error.empty();
+    }
+
+private:
+    bool accept(const char* symbol) {
+        if (tokens[position].kind == Token::Symbol && tokens[position].text == symbol) {
+            position++;
+            return true;
+        }
+        return false;
+    }
+
+    int fail(const std::string& message) {
+        if (error.empty()) {
+            error = message;
+        }
+        return dag.constant(0);
+    }
+
+    int expression() {
+        int node = term();
+        while (error.empty()) {
+            if (accept("+")) {
+                node = dag.operation(Op_Add, node, term());
+            } else if (accept("-")) {
+                node = dag.operation(Op_Sub, node, term());
+            } else {
+                break;
+            }
+        }
+        return node;
+    }
+
+    int term() {
+        int node = unary();
+        while (error.empty()) {
+            if (accept("*")) {
+                node = dag.operation(Op_Mul, node, unary());
+            } else if (accept("/")) {
+                node = dag.operation(Op_Div, node, unary());
+            } else {
+                break;
+            }
+        }
+        return node;
+    }
+
+    int unary() {
+        if (accept("-")) {
+            return dag.operation(Op_Neg, unary(), -1);
+        }
+        int node = primary();
+        if (error.empty() && accept("^")) {
+            node = dag.operation(Op_Pow, node, unary()); // right associative
+        }
+        return node;
+    }
+
+    int primary() {
+        const Token& token = tokens[position];
+        if (token.kind == Token::Number) {
+            position++;
+            return dag.constant(token.number);
+        }
+        if (accept("(")) {
+            int node = expression();
+            if (!accept(")")) {
+                return fail("missing ')'");
+            }
+            return node;
+        }
+        if (token.kind != Token::Name) {
+            return fail(token.kind == Token::End ? "expression ends too early" : "unexpected '" + token.text + "'");
+        }
+        position++;
+        if (const Function* function = findFunction(token.text)) {
+            if (!accept("(")) {
+                return fail(token.text + " needs '('");
+            }
+            int a = expression();
+            int b = -1;
+            if (function->arguments == 2) {
+                if (!accept(",")) {
+                    return fail(token.text + " takes two arguments");
+                }
+                b = expression();
+            } else if (function->op == Op_Mul) {
+                b = a;
+            }
+            if (!accept(")")) {
+                return fail(token.text + (function->arguments == 2 ? " takes two arguments" : " takes one argument"));
+            }
+            return error.empty() ? dag.operation(function->op, a, b) : a;
+        }
+        if (token.text == "pi") {
+            return dag.constant(PI);
+        }
+        auto symbol = symbols.find(token.text);
+        if (symbol == symbols.end()) {
+            return fail(findField(token.text) >= 0 ? token.text + " is neither a known of this rule nor assigned above"
+                                                   : "unknown name " + token.text);
+        }
+        return symbol->second;
+    }
+
+    const std::vector<Token>& tokens;
+    std::size_t position;
+    Dag& dag;
+    const std::map<std::string, int>& symbols;
+    std::string error;
+};
+
+struct Statement {
+    int line;
+    std::string text;
+};
+
+struct Section {
+    bool isRule = false;
+    std::string name;
+    uint32_t knownMask = 0;
+    int line = 0;
+    std::vector<Statement> statements;
+};
+
+std::string trim(const std::string& text)
+{
+    std::size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) {
+        return {};
+    }
+    std::size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+// Statements of section with every "use BLOCK" replaced by the block's statements.
+bool expand(const Section& section, const std::map<std::string, const Section*>& blocks, int depth,
+            std::vector<Statement>& out, const std::string& name, std::string& error)
+{
+    for (const Statement& statement : section.statements) {
+        std::istringstream words(statement.text);
+        std::string first, blockName, extra;
+        words >> first >> blockName >> extra;
+        if (first != "use" || statement.text.find('=') != std::string::npos) {
+            out.push_back(statement);
+            continue;
+        }
+        auto block = blocks.find(blockName);
+        if (blockName.empty() || !extra.empty() || block == blocks.end()) {
+            error = name + ":" + std::to_string(statement.line) + ": no block named '" + blockName + "'";
+            return false;
+        }
+        if (depth >= 16) {
+            error = name + ":" + std::to_string(statement.line) + ": blocks use each other in a cycle";
+            return false;
+        }
+        if (!expand(*block->second, blocks, depth + 1, out, name, error)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool compile(const Section& rule, const std::map<std::string, const Section*>& blocks, const std::string& name,
+             RuleProgram& program, std::string& error)
+{
+    std::vector<Statement> statements;
+    if (!expand(rule, blocks, 0, statements, name, error)) {
+        return false;
+    }
+
+    Dag dag;
+    std::map<std::string, int> symbols;
+    for (int field = 0; field < InputFieldCount; field++) {
+        if (rule.knownMask & (1u << field)) {
+            symbols[kTriangleFieldNames[field]] = dag.load(field);
+        }
+    }
+    std::vector<Token> tokens;
+    for (const Statement& statement : statements) {
+        std::string message;
+        int node = -1;
+        if (!tokenize(statement.text, tokens, message)) {
+        } else if (tokens[0].kind != Token::Name || tokens[1].kind != Token::Symbol || tokens[1].text != "=") {
+            message = "expected NAME = EXPRESSION or use BLOCK";
+        } else if (findFunction(tokens[0].text) || tokens[0].text == "pi" || tokens[0].text == "use") {
+            message = "cannot assign to " + tokens[0].text;
+        } else {
+            int field = findField(tokens[0].text);
+            if (field >= 0 && field < InputFieldCount && (rule.knownMask & (1u << field))) {
+                continue; // the rule's own known stays as given
+            }
+            if (ExpressionParser(tokens, 2, dag, symbols).parse(node, message)) {
+                symbols[tokens[0].text] = node;
+            }
+        }
+        if (!message.empty()) {
+            error = name + ":" + std::to_string(statement.line) + ": " + message;
+            return false;
+        }
+    }
+
+    // Only the nodes some assigned field depends on are kept.
+    const std::vector<Node>& nodes = dag.all();
+    std::vector<std::pair<int, int>> stored; // (field, node)
+    for (int field = 0; field < FieldCount; field++) {
+        auto symbol = symbols.find(kTriangleFieldNames[field]);
+        if (symbol != symbols.end() && !(rule.knownMask & (1u << field))) {
+            stored.emplace_back(field, symbol->second);
+        }
+    }
+    std::vector<char> live(nodes.size(), 0);
+    for (auto [field, node] : stored) {
+        live[node] = 1;
+    }
+    for (std::size_t i = nodes.size(); i-- > 0;) {
+        if (live[i] && nodes[i].op != Op_Load && nodes[i].op != Op_Const) {
+            live[nodes[i].a] = 1;
+            if (nodes[i].b >= 0) {
+                live[nodes[i].b] = 1;
+            }
+        }
+    }
+
+    // Nodes are created after their operands, so creation order is a valid
+    // schedule. A temporary's register is reused once its last reader has run.
+    const int Forever = int(nodes.size());
+    std::vector<int> lastUse(nodes.size(), -1);
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        if (live[i] && nodes[i].op != Op_Load && nodes[i].op != Op_Const) {
+            lastUse[nodes[i].a] = int(i);
+            if (nodes[i].b >= 0) {
+                lastUse[nodes[i].b] = int(i);
+            }
+        }
+    }
+    for (auto [field, node] : stored) {
+        lastUse[node] = Forever;
+    }
+
+    program = RuleProgram();
+    std::vector<int> reg(nodes.size(), -1);
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        if (!live[i]) {
+            continue;
+        }
+        if (nodes[i].op == Op_Load) {
+            reg[i] = nodes[i].a;
+            program.loads.push_back(uint8_t(nodes[i].a));
+        } else if (nodes[i].op == Op_Const) {
+            reg[i] = FieldCount + int(program.constants.size());
+            program.constants.push_back(nodes[i].value);
+        }
+    }
+    const int firstTemporary = FieldCount + int(program.constants.size());
+    int registers = firstTemporary;
+    std::vector<int> freeRegisters;
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        const Node& node = nodes[i];
+        if (!live[i] || node.op == Op_Load || node.op == Op_Const) {
+            continue;
+        }
+        for (int operand : {node.a, node.b}) {
+            if (operand >= 0 && reg[operand] >= firstTemporary && lastUse[operand] == int(i)) {
+                freeRegisters.push_back(reg[operand]);
+                lastUse[operand] = -1; // x * x frees its register once
+            }
+        }
+        if (!freeRegisters.empty()) {
+            auto lowest = std::min_element(freeRegisters.begin(), freeRegisters.end());
+            reg[i] = *lowest;
+            freeRegisters.erase(lowest);
+        } else {
+            reg[i] = registers++;
+        }
+        if (registers > 256) {
+            error = name + ":" + std::to_string(rule.line) + ": rule " + rule.name + " needs more than 256 registers";
+            return false;
+        }
+        program.code.push_back({uint8_t(node.op), uint8_t(reg[i]), uint8_t(reg[node.a]),
+                                uint8_t(reg[node.b >= 0 ? node.b : node.a])});
+    }
+    for (auto [field, node] : stored) {
+        program.stores.emplace_back(uint8_t(field), uint8_t(reg[node]));
+    }
+
+    program.info.name = rule.name;
+    program.info.knownMask = rule.knownMask;
+    program.info.line = rule.line;
+    program.info.writtenOperations = dag.written();
+    program.info.instructions = int(program.code.size());
+    program.info.registers = registers;
+    return true;
+}
+
+// Rows per block: every register is a column of this many rows.
+const std::size_t Block = 64;
+
+template <typename F>
+inline void unaryLoop(double* d, const double* x, std::size_t n, F f)
+{
+    for (std::size_t i = 0; i < n; i++) {
+        d[i] = f(x[i]);
+    }
+}
+
+template <typename F>
+inline void binaryLoop(double* d, const double* x, const double* y, std::size_t n, F f)
+{
+    for (std::size_t i = 0; i < n; i++) {
+        d[i] = f(x[i], y[i]);
+    }
+}
+
+// One pass over the code for n rows. The arithmetic loops vectorize; the
+// trig ones call the same helpers as solveTriangle row by row.
+void run(const RuleProgram& program, double* regs, std::size_t n)
+{
+    for (const RuleInstruction& instruction : program.code) {
+        double* d = regs + instruction.dst * Block;
+        const double* x = regs + instruction.a * Block;
+        const double* y = regs + instruction.b * Block;
+        switch (instruction.op) {
+        case Op_Add: binaryLoop(d, x, y, n, [](double a, double b) { return a + b; }); break;
+        case Op_Sub: binaryLoop(d, x, y, n, [](double a, double b) { return a - b; }); break;
+        case Op_Mul: binaryLoop(d, x, y, n, [](double a, double b) { return a * b; }); break;
+        case Op_Div: binaryLoop(d, x, y, n, [](double a, double b) { return a / b; }); break;
+        case Op_Neg: unaryLoop(d, x, n, [](double a) { return -a; }); break;
+        case Op_Sqrt: unaryLoop(d, x, n, [](double a) { return std::sqrt(a); }); break;
+        case Op_Abs: unaryLoop(d, x, n, [](double a) { return std::fabs(a); }); break;
+        case Op_Min: binaryLoop(d, x, y, n, [](double a, double b) { return std::min(a, b); }); break;
+        case Op_Max: binaryLoop(d, x, y, n, [](double a, double b) { return std::max(a, b); }); break;
+        case Op_Pow: binaryLoop(d, x, y, n, [](double a, double b) { return std::pow(a, b); }); break;
+        case Op_Atan2: binaryLoop(d, x, y, n, [](double a, double b) { return apply(Op_Atan2, a, b); }); break;
+        default: {
+            Op op = Op(instruction.op);
+            unaryLoop(d, x, n, [op](double a) { return apply(op, a, 0); });
+            break;
+        }
+        }
+    }
+}
+
+}
+
+bool RuleSet::parse(std::string_view text, const std::string& name, std::string& error)
+{
+    std::vector<Section> sections;
+    std::istringstream lines{std::string(text)};
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(lines, line)) {
+        lineNumber++;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            continue;
+        }
+        std::string where = name + ":" + std::to_string(lineNumber) + ": ";
+        bool isRule = line.compare(0, 5, "rule ") == 0;
+        if (!isRule && line.compare(0, 6, "block ") != 0) {
+            if (sections.empty()) {
+                error = where + "statement outside a rule or block";
+                return false;
+            }
+            sections.back().statements.push_back({lineNumber, line});
+            continue;
+        }
+        std::size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            error = where + "expected ':' after the " + (isRule ? "rule" : "block") + " name";
+            return false;
+        }
+        Section section;
+        section.isRule = isRule;
+        section.line = lineNumber;
+        section.name = trim(line.substr(isRule ? 5 : 6, colon - (isRule ? 5 : 6)));
+        if (section.name.empty() || section.name.find_first_of(" \t") != std::string::npos) {
+            error = where + "bad name '" + section.name + "'";
+            return false;
+        }
+        for (const Section& other : sections) {
+            if (other.isRule == isRule && other.name == section.name) {
+                error = where + (isRule ? "rule " : "block ") + section.name + " is defined twice";
+                return false;
+            }
+        }
+        std::istringstream knowns(line.substr(colon + 1));
+        std::string known;
+        while (knowns >> known) {
+            int field = findField(known);
+            if (!isRule || field < 0 || field >= InputFieldCount) {
+                error = where + (isRule ? "'" + known + "' is not an input field" : "a block has no knowns");
+                return false;
+            }
+            section.knownMask |= 1u << field;
+        }
+        if (isRule && !section.knownMask) {
+            error = where + "rule " + section.name + " lists no knowns";
+            return false;
+        }
+        sections.push_back(section);
+    }
+
+    std::map<std::string, const Section*> blocks;
+    for (const Section& section : sections) {
+        if (!section.isRule) {
+            blocks[section.name] = &section;
+        }
+    }
+    std::vector<RuleProgram> compiled;
+    for (const Section& section : sections) {
+        if (section.isRule) {
+            compiled.emplace_back();
+            if (!compile(section, blocks, name, compiled.back(), error)) {
+                return false;
+            }
+        }
+    }
+    if (compiled.empty()) {
+        error = name + ": no rules";
+        return false;
+    }
+    programs = std::move(compiled);
+    return true;
+}
+
+bool RuleSet::load(const std::string& path, std::string& error)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::ostringstream text;
+    text << in.rdbuf();
+    return parse(text.str(), path, error);
+}
+
+int RuleSet::match(uint32_t knownMask) const
+{
+    for (std::size_t rule = 0; rule < programs.size(); rule++) {
+        uint32_t needed = programs[rule].info.knownMask;
+        if ((knownMask & needed) == needed) {
+            return int(rule);
+        }
+    }
+    return -1;
+}
+
+int RuleSet::solve(TriangleValues& values) const
+{
+    int rule = -1;
+    solveBatch(&values, &values, 1, &rule);
+    return rule;
+}
+
+std::size_t RuleSet::solveBatch(const TriangleValues* inputs, TriangleValues* outputs, std::size_t count,
+                                int* rules) const
+{
+    // Rows are grouped by rule (bucket 0 holds the rows no rule matches) so
+    // each block runs a single program.
+    std::size_t buckets = programs.size() + 1;
+    std::vector<int> ruleOf(count);
+    std::vector<std::size_t> start(buckets + 1, 0);
+    for (std::size_t i = 0; i < count; i++) {
+        ruleOf[i] = match(knownMask(inputs[i]));
+        start[ruleOf[i] + 2]++;
+    }
+    for (std::size_t b = 1; b <= buckets; b++) {
+        start[b] += start[b - 1];
+    }
+    std::vector<uint32_t> order(count);
+    std::vector<std::size_t> next(start.begin(), start.end() - 1);
+    for (std::size_t i = 0; i < count; i++) {
+        order[next[ruleOf[i] + 1]++] = uint32_t(i);
+    }
+
+    int registers = 0;
+    for (const RuleProgram& program : programs) {
+        registers = std::max(registers, program.info.registers);
+    }
+    std::vector<double> regs(std::size_t(registers) * Block);
+
+    for (std::size_t b = 0; b < buckets; b++) {
+        const RuleProgram* program = b ? &programs[b - 1] : nullptr;
+        if (program) {
+            for (std::size_t c = 0; c < program->constants.size(); c++) {
+                std::fill_n(regs.data() + (FieldCount + c) * Block, Block, program->constants[c]);
+            }
+        }
+        for (std::size_t first = start[b]; first < start[b + 1]; first += Block) {
+            std::size_t n = std::min(Block, start[b + 1] - first);
+            const uint32_t* rows = order.data() + first;
+            if (program) {
+                for (uint8_t field : program->loads) {
+                    double* column = regs.data() + field * Block;
+                    for (std::size_t i = 0; i < n; i++) {
+                        column[i] = (&inputs[rows[i]].AB)[field];
+                    }
+                }
+                run(*program, regs.data(), n);
+            }
+            for (std::size_t i = 0; i < n; i++) {
+                TriangleValues& out = outputs[rows[i]];
+                out = inputs[rows[i]];
+                out.inRadius = 0;
+                out.circumRadius = 0;
+            }
+            if (program) {
+                for (auto [field, reg] : program->stores) {
+                    const double* column = regs.data() + reg * Block;
+                    for (std::size_t i = 0; i < n; i++) {
+                        (&outputs[rows[i]].AB)[field] = column[i];
+                    }
+                }
+            }
+        }
+    }
+    if (rules) {
+        std::copy(ruleOf.begin(), ruleOf.end(), rules);
+    }
+    return count - (start[1] - start[0]);
+}
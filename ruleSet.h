@@ -0,0 +1,86 @@
+#ifndef RULESET_H
+#define RULESET_H
+
+#include "triangleCore.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Solver rules read at run time instead of compiled in. Each rule names the
+// knowns it needs and assigns the other quantities from expressions over
+// them. RuleSet::parse turns every rule into an expression DAG with common
+// subexpressions merged and constants folded, then into register bytecode;
+// solveBatch runs the bytecode a block of rows at a time, so instruction
+// dispatch is paid once per block and each instruction is a plain loop.
+//
+// File format (rules/default.rules holds the built-in branches):
+//
+//   # comment
+//   block NAME:             statements shared by several rules
+//       STATEMENT
+//   rule NAME: FIELD ...    applies when every listed input field is > 0
+//       STATEMENT
+//
+// A statement is "TARGET = EXPRESSION" or "use BLOCK". TARGET is a field
+// name or a temporary. Expressions use numbers, pi, the rule's knowns and
+// anything assigned above, + - * / ^ and the functions sqrt abs min max pow
+// square sin cos tan asin acos atan atan2, with angles in degrees as
+// everywhere else. Assignments to the rule's own knowns are skipped, so one
+// block can fill in every field. Rules are tried in file order; fields the
+// matching rule does not assign keep their input, except inRadius and
+// circumRadius, which start at 0 as in solveTriangle.
+
+struct RuleInfo {
+    std::string name;
+    uint32_t knownMask = 0;
+    int line = 0;
+    int writtenOperations = 0; // operations as written, with blocks expanded
+    int instructions = 0;      // after merging, folding and dropping unused results
+    int registers = 0;
+};
+
+struct RuleInstruction {
+    uint8_t op;
+    uint8_t dst;
+    uint8_t a;
+    uint8_t b;
+};
+
+// One compiled rule. Registers 0..FieldCount-1 hold the fields, constants
+// follow, then the temporaries.
+struct RuleProgram {
+    RuleInfo info;
+    std::vector<uint8_t> loads;                   // input fields the code reads
+    std::vector<double> constants;                // values of registers FieldCount, FieldCount + 1, ...
+    std::vector<RuleInstruction> code;
+    std::vector<std::pair<uint8_t, uint8_t>> stores; // (field, register) for every assigned field
+};
+
+class RuleSet
+{
+public:
+    // Replaces the current rules only on success. name prefixes the error
+    // messages ("name:line: message").
+    bool parse(std::string_view text, const std::string& name, std::string& error);
+    bool load(const std::string& path, std::string& error);
+
+    std::size_t size() const { return programs.size(); }
+    const RuleInfo& info(std::size_t rule) const { return programs[rule].info; }
+    // The first rule whose knowns are all in knownMask, or -1.
+    int match(uint32_t knownMask) const;
+
+    // Solves values in place and returns the rule used, or -1 when none
+    // applies (then only inRadius and circumRadius change, to 0).
+    int solve(TriangleValues& values) const;
+    // The same for count rows; inputs and outputs may be the same array.
+    // rules, if given, receives each row's rule. Returns the rows solved.
+    std::size_t solveBatch(const TriangleValues* inputs, TriangleValues* outputs, std::size_t count,
+                           int* rules = nullptr) const;
+
+private:
+    std::vector<RuleProgram> programs;
+};
+
+#endif // RULESET_H
@@ -0,0 +1,100 @@
+#include "sensitivity.h"
+#include "dualNumber.h"
+#include "triangleCoreT.h"
+#include <limits>
+
+namespace {
+
+// A dual needs both sin and cos of every angle, and a branch takes the sin
+// and cos of the same angle up to three times, so the last pair is kept:
+// off the grid tables each one is a libm call.
+void sinCosDegrees(double degree, double& sine, double& cosine)
+{
+    thread_local double lastDegree = std::numeric_limits<double>::quiet_NaN();
+    thread_local double lastSine, lastCosine;
+    if (degree != lastDegree) {
+        lastDegree = degree;
+        lastSine = sinDegrees(degree);
+        lastCosine = cosDegrees(degree);
+    }
+    sine = lastSine;
+    cosine = lastCosine;
+}
+
+}
+
+// Found by argument-dependent lookup from solveTriangleT: degree trig on a
+// dual takes its value from the same grid tables the plain solve uses.
+template <int N>
+Dual<N> sinDegreesT(const Dual<N>& degree)
+{
+    double sine, cosine;
+    sinCosDegrees(degree.value, sine, cosine);
+    Dual<N> r(sine);
+    double slope = cosine * (PI / 180);
+    for (int i = 0; i < N; i++) r.d[i] = degree.d[i] * slope;
+    return r;
+}
+
+template <int N>
+Dual<N> cosDegreesT(const Dual<N>& degree)
+{
+    double sine, cosine;
+    sinCosDegrees(degree.value, sine, cosine);
+    Dual<N> r(cosine);
+    double slope = -sine * (PI / 180);
+    for (int i = 0; i < N; i++) r.d[i] = degree.d[i] * slope;
+    return r;
+}
+
+namespace {
+
+// Most rows know exactly three inputs, so a narrow dual carries only their
+// derivatives; anything with more knowns uses one slot per input field.
+const int NarrowSeeds = 3;
+
+template <int N>
+void solveDual(TriangleValues& values, TriangleJacobian& jacobian, const int (&inputs)[InputFieldCount], int seeds)
+{
+    // The fields are indexed as arrays, like RuleSet does, rather than
+    // through fieldValue's member pointers; the derivatives start at zero.
+    TriangleValuesT<Dual<N>> dual;
+    Dual<N>* fields = &dual.AB;
+    double* plain = &values.AB;
+    for (int field = 0; field < InputFieldCount; field++) {
+        fields[field].value = plain[field];
+    }
+    for (int seed = 0; seed < seeds; seed++) {
+        fields[inputs[seed]].d[seed] = 1;
+    }
+
+    solveTriangleT(dual);
+
+    for (int field = 0; field < FieldCount; field++) {
+        plain[field] = fields[field].value;
+        for (int seed = 0; seed < seeds; seed++) {
+            jacobian.d[seed][field] = fields[field].d[seed];
+        }
+    }
+}
+
+}
+
+void solveWithJacobian(TriangleValues& values, TriangleJacobian& jacobian)
+{
+    jacobian.knownMask = knownMask(values);
+
+    int inputs[InputFieldCount];
+    int seeds = 0;
+    for (int field = 0; field < InputFieldCount; field++) {
+        if (jacobian.knownMask & (1u << field)) {
+            inputs[seeds++] = field;
+        }
+    }
+
+    if (seeds <= NarrowSeeds) {
+        solveDual<NarrowSeeds>(values, jacobian, inputs, seeds);
+    } else {
+        solveDual<InputFieldCount>(values, jacobian, inputs, seeds);
+    }
+}
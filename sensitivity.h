@@ -0,0 +1,30 @@
+#ifndef SENSITIVITY_H
+#define SENSITIVITY_H
+
+#include "triangleCore.h"
+#include <bitset>
+#include <cstdint>
+
+// Derivative of every output with respect to every known input, from one
+// pass of the solver over dual numbers (dualNumber.h). Angles are in
+// degrees on both sides, so d(Area)/d(angleB) is per degree.
+//
+// Only the known inputs have a column, stored in field order and
+// contiguous, so a three-input row writes 3 x 18 values and nothing else.
+struct TriangleJacobian {
+    uint32_t knownMask = 0;
+    double d[InputFieldCount][FieldCount]; // d[column][output]; only the first popcount(knownMask) are set
+
+    // Column of a known input.
+    int column(int input) const { return int(std::bitset<32>(knownMask & ((1u << input) - 1)).count()); }
+    // 0 for an input that is not known.
+    double operator()(int output, int input) const {
+        return (knownMask & (1u << input)) ? d[column(input)][output] : 0.0;
+    }
+};
+
+// Solves values in place like solveTriangle and fills jacobian. Values agree
+// with solveTriangle to rounding.
+void solveWithJacobian(TriangleValues& values, TriangleJacobian& jacobian);
+
+#endif // SENSITIVITY_H
@@ -0,0 +1,151 @@
+#include "shapeCache.h"
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+const std::size_t ProbeLimit = 8;
+
+bool isAngleField(int field)
+{
+    return field == Field_angleA || field == Field_angleB || field == Field_angleC;
+}
+
+// Every output except the angles and the area is a length.
+double scalePower(int field, double scale)
+{
+    if (isAngleField(field)) {
+        return 1.0;
+    }
+    return field == Field_Area ? scale * scale : scale;
+}
+
+uint64_t mix(uint64_t h, uint64_t v)
+{
+    h ^= v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+    return h;
+}
+
+}
+
+ShapeCacheStats& ShapeCacheStats::operator+=(const ShapeCacheStats& other)
+{
+    lookups += other.lookups;
+    hits += other.hits;
+    bypassed += other.bypassed;
+    evictions += other.evictions;
+    return *this;
+}
+
+bool makeShapeKey(const TriangleValues& values, int keyBits, ShapeKey& key)
+{
+    double scale = 0;
+    for (int field = 0; field < InputFieldCount; field++) {
+        double value = fieldValue(values, field);
+        if (value < 0 || std::isnan(value)) {
+            return false;
+        }
+        if (scale == 0 && value > 0 && !isAngleField(field) && field != Field_Area) {
+            scale = value;
+        }
+    }
+    if (scale == 0 && values.Area > 0) {
+        scale = std::sqrt(values.Area);
+    }
+    if (!(scale > 0) || !std::isfinite(scale)) {
+        return false;
+    }
+    uint32_t mask = knownMask(values);
+    const TriangleBranch* branch = triangleBranch(mask);
+    if (branch && !branch->scaleFree) {
+        return false;
+    }
+
+    int dropped = 52 - keyBits;
+    uint64_t roundingBit = dropped > 0 ? uint64_t(1) << (dropped - 1) : 0;
+    uint64_t keepMask = dropped > 0 ? ~((uint64_t(1) << dropped) - 1) : ~uint64_t(0);
+
+    key.mask = mask;
+    key.scale = scale;
+    key.hash = key.mask;
+    for (int field = 0; field < InputFieldCount; field++) {
+        double value = fieldValue(values, field) / scalePower(field, scale);
+        fieldValue(key.normalized, field) = value;
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof bits);
+        key.key[field] = (bits + roundingBit) & keepMask;
+        key.hash = mix(key.hash, key.key[field]);
+    }
+    return true;
+}
+
+void applyShape(const TriangleValues& unit, const ShapeKey& key, TriangleValues& values)
+{
+    TriangleValues known = values;
+    for (int field = 0; field < FieldCount; field++) {
+        fieldValue(values, field) = fieldValue(unit, field) * scalePower(field, key.scale);
+    }
+    // Some branches overwrite an input (with 0 or NaN when it cannot hold);
+    // only the inputs the solver left alone come back as given.
+    for (int field = 0; field < InputFieldCount; field++) {
+        if ((key.mask & (1u << field)) && fieldValue(unit, field) == fieldValue(key.normalized, field)) {
+            fieldValue(values, field) = fieldValue(known, field);
+        }
+    }
+}
+
+ShapeCache::ShapeCache(std::size_t capacity, int keyBits)
+    : keyBits(keyBits)
+{
+    std::size_t size = 16;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    entries.resize(size);
+    slotMask = size - 1;
+}
+
+void ShapeCache::clear()
+{
+    for (Entry& entry : entries) {
+        entry.used = false;
+    }
+    counters = ShapeCacheStats();
+}
+
+void ShapeCache::solve(TriangleValues& values)
+{
+    ShapeKey shape;
+    if (!makeShapeKey(values, keyBits, shape)) {
+        counters.bypassed++;
+        solveTriangle(values);
+        return;
+    }
+
+    counters.lookups++;
+    Entry* target = nullptr;
+    for (std::size_t probe = 0; probe < ProbeLimit; probe++) {
+        Entry& entry = entries[(shape.hash + probe) & slotMask];
+        if (!entry.used) {
+            target = &entry;
+            break;
+        }
+        if (entry.mask == shape.mask && std::memcmp(entry.key, shape.key, sizeof shape.key) == 0) {
+            target = &entry;
+            counters.hits++;
+            break;
+        }
+    }
+    if (!target) {
+        target = &entries[shape.hash & slotMask];
+        counters.evictions++;
+    }
+    if (!target->used || target->mask != shape.mask || std::memcmp(target->key, shape.key, sizeof shape.key) != 0) {
+        target->used = true;
+        target->mask = shape.mask;
+        std::memcpy(target->key, shape.key, sizeof shape.key);
+        target->unit = shape.normalized;
+        solveTriangle(target->unit);
+    }
+    applyShape(target->unit, shape, values);
+}
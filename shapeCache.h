@@ -0,0 +1,81 @@
+#ifndef SHAPECACHE_H
+#define SHAPECACHE_H
+
+#include "triangleCore.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Cache of solved unit triangles keyed by the normalized shape of the inputs.
+// Known lengths are divided by a reference length (the first known length
+// field, or sqrt(Area) when only the area is given) and the area by its
+// square, so every scaled copy of a shape maps to the same key. A hit
+// rescales the stored unit result instead of running any trig.
+//
+// That only holds when every output of the branch solveTriangle takes scales
+// the same way; rows whose inputs select a branch that does not (five bisector
+// branches whose formula for the missing side is not scale-free) are never
+// normalized.
+//
+// Normalized values are rounded to keyBits significant bits before hashing,
+// so inputs closer than that share an entry. Not thread safe: use one cache
+// per thread.
+//
+// The batch pipeline does not use it: on SSS rows a hit (the key, the probe
+// and the rescale, about 150 ns) costs more than the solve it saves (about
+// 100 ns), so it only pays where a row is dearer to solve than that.
+
+struct ShapeCacheStats {
+    std::size_t lookups = 0;
+    std::size_t hits = 0;
+    std::size_t bypassed = 0; // rows that cannot be normalized (no length, negative input, non-scaling branch)
+    std::size_t evictions = 0;
+
+    double hitRate() const { return lookups ? double(hits) / lookups : 0.0; }
+    ShapeCacheStats& operator+=(const ShapeCacheStats& other);
+};
+
+// A row's inputs reduced to its scale-free cache key.
+struct ShapeKey {
+    uint32_t mask = 0;
+    uint64_t hash = 0;
+    double scale = 0;
+    uint64_t key[InputFieldCount];
+    TriangleValues normalized;
+};
+
+// False when the row cannot be normalized, or its solver branch does not
+// scale linearly; solve it directly instead.
+bool makeShapeKey(const TriangleValues& values, int keyBits, ShapeKey& key);
+// Scales unit (the solved normalized row) back up into values. Known inputs
+// the solver did not overwrite come back exactly as given rather than as a
+// rescaled copy.
+void applyShape(const TriangleValues& unit, const ShapeKey& key, TriangleValues& values);
+
+class ShapeCache
+{
+public:
+    explicit ShapeCache(std::size_t capacity = 16384, int keyBits = 40);
+
+    // Same result as solveTriangle(values), up to rounding of the rescale and
+    // of the key: rows within keyBits of a cached shape share its solve.
+    void solve(TriangleValues& values);
+
+    const ShapeCacheStats& stats() const { return counters; }
+    void clear();
+
+private:
+    struct Entry {
+        bool used = false;
+        uint32_t mask = 0;
+        uint64_t key[InputFieldCount];
+        TriangleValues unit;
+    };
+
+    std::vector<Entry> entries;
+    std::size_t slotMask;
+    int keyBits;
+    ShapeCacheStats counters;
+};
+
+#endif // SHAPECACHE_H
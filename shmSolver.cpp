@@ -0,0 +1,431 @@
+#include "shmSolver.h"
+#include "ringBuffer.h"
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <thread>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+struct alignas(64) ShmHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t channelCount;
+    uint32_t ringRecords;
+    uint64_t segmentBytes;
+    std::atomic<uint32_t> serverPid;
+    std::atomic<uint32_t> ready; // stored last, once everything above is written
+    alignas(64) std::atomic<uint32_t> serverWaiting;
+    std::atomic<uint32_t> doorbell;
+};
+
+struct ShmChannel {
+    alignas(64) std::atomic<uint32_t> owner; // client pid, 0 = free
+    alignas(64) std::atomic<uint64_t> submitted;
+    alignas(64) std::atomic<uint64_t> solved;
+    std::atomic<uint32_t> clientWaiting;
+    std::atomic<uint32_t> responseBell;
+    alignas(64) std::atomic<uint64_t> received;
+};
+
+namespace {
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+              "the shared segment needs address-free atomics");
+
+const std::size_t ChannelsOffset = 256;
+const long SleepSliceNs = 100 * 1000 * 1000; // a sleeper rechecks for a dead peer or stop this often
+
+std::size_t recordsOffset(uint32_t channelCount)
+{
+    return ChannelsOffset + channelCount * sizeof(ShmChannel);
+}
+
+bool processAlive(uint32_t pid)
+{
+#ifndef _WIN32
+    return pid != 0 && (kill(pid_t(pid), 0) == 0 || errno != ESRCH);
+#else
+    return pid != 0;
+#endif
+}
+
+uint32_t currentPid()
+{
+#ifndef _WIN32
+    return uint32_t(getpid());
+#else
+    return 1;
+#endif
+}
+
+// Shared (not process-private) futex ops, since the word lives in the segment.
+void futexWait(std::atomic<uint32_t>& word, uint32_t expected)
+{
+#ifdef __linux__
+    timespec timeout{0, SleepSliceNs};
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+#else
+    if (word.load(std::memory_order_relaxed) == expected) {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+#endif
+}
+
+void futexWake(std::atomic<uint32_t>& word)
+{
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#else
+    (void)word;
+#endif
+}
+
+// Called after publishing a cursor: wakes the other side only if it is asleep.
+// The fences pair with the ones in waitFor, so either the waker sees the
+// flag or the sleeper sees the new cursor before it sleeps.
+void notify(std::atomic<uint32_t>& waiting, std::atomic<uint32_t>& bell)
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_relaxed)) {
+        bell.fetch_add(1, std::memory_order_relaxed);
+        futexWake(bell);
+    }
+}
+
+// Spins, then sleeps on bell, until ready(); false once giveUp() does.
+template <typename Ready, typename GiveUp>
+bool waitFor(Ready ready, GiveUp giveUp, std::atomic<uint32_t>& waiting, std::atomic<uint32_t>& bell,
+             const ShmWaitOptions& options)
+{
+    unsigned spins = 0;
+    for (unsigned polls = 0; !options.sleep || polls < options.spinIterations; polls++) {
+        if (ready()) {
+            return true;
+        }
+        if ((polls & 0xffff) == 0xffff && giveUp()) {
+            return false;
+        }
+        ringDetail::backoff(spins);
+    }
+    for (;;) {
+        waiting.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint32_t ticket = bell.load(std::memory_order_relaxed);
+        if (ready()) {
+            waiting.store(0, std::memory_order_relaxed);
+            return true;
+        }
+        futexWait(bell, ticket);
+        waiting.store(0, std::memory_order_relaxed);
+        if (ready()) {
+            return true;
+        }
+        if (giveUp()) {
+            return false;
+        }
+    }
+}
+
+#ifndef _WIN32
+char* mapSegment(const std::string& name, std::size_t bytes, bool create, std::size_t& mappedBytes, std::string& error)
+{
+    int fd;
+    if (create) {
+        shm_unlink(name.c_str()); // a segment left by a server that died
+        fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd >= 0 && ftruncate(fd, off_t(bytes)) != 0) {
+            ::close(fd);
+            shm_unlink(name.c_str());
+            fd = -1;
+        }
+    } else {
+        fd = shm_open(name.c_str(), O_RDWR, 0);
+        struct stat info;
+        if (fd >= 0 && fstat(fd, &info) == 0) {
+            bytes = std::size_t(info.st_size);
+        }
+    }
+    if (fd < 0) {
+        error = std::string(create ? "cannot create shared memory " : "cannot open shared memory ") + name + ": "
+            + std::strerror(errno);
+        return nullptr;
+    }
+    void* address = bytes >= ChannelsOffset ? mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        error = "cannot map shared memory " + name;
+        if (create) {
+            shm_unlink(name.c_str());
+        }
+        return nullptr;
+    }
+    mappedBytes = bytes;
+    return static_cast<char*>(address);
+}
+
+void unmapSegment(char* base, std::size_t bytes)
+{
+    munmap(base, bytes);
+}
+
+void unlinkSegment(const std::string& name)
+{
+    shm_unlink(name.c_str());
+}
+#else
+char* mapSegment(const std::string& name, std::size_t, bool, std::size_t&, std::string& error)
+{
+    error = "shared memory solving needs POSIX shm (" + name + ")";
+    return nullptr;
+}
+
+void unmapSegment(char*, std::size_t)
+{
+}
+
+void unlinkSegment(const std::string&)
+{
+}
+#endif
+
+}
+
+ShmSolverServer::~ShmSolverServer()
+{
+    close();
+}
+
+bool ShmSolverServer::create(const std::string& segmentName, unsigned channelCount, unsigned ringRecords,
+                             std::string& error)
+{
+    close();
+    if (channelCount == 0 || ringRecords == 0 || ringRecords > (1u << 24)) {
+        error = "a shared memory segment needs at least one channel of 1 to 2^24 records";
+        return false;
+    }
+    uint32_t slots = uint32_t(ringDetail::roundUpPow2(ringRecords));
+    std::size_t bytes = recordsOffset(channelCount) + std::size_t(channelCount) * slots * sizeof(ShmRecord);
+    base = mapSegment(segmentName, bytes, true, mappedBytes, error);
+    if (!base) {
+        return false;
+    }
+    name = segmentName;
+    // ftruncate zero-fills, which is every cursor, flag and owner at rest.
+    header = reinterpret_cast<ShmHeader*>(base);
+    channels = reinterpret_cast<ShmChannel*>(base + ChannelsOffset);
+    records = reinterpret_cast<ShmRecord*>(base + recordsOffset(channelCount));
+    std::memcpy(header->magic, "TSHM", 4);
+    header->version = ShmSolverVersion;
+    header->channelCount = channelCount;
+    header->ringRecords = slots;
+    header->segmentBytes = bytes;
+    header->serverPid.store(currentPid(), std::memory_order_relaxed);
+    header->ready.store(1, std::memory_order_release);
+    return true;
+}
+
+void ShmSolverServer::close()
+{
+    if (!base) {
+        return;
+    }
+    header->serverPid.store(0, std::memory_order_relaxed);
+    // Wake every sleeping client so it notices the server is gone.
+    for (uint32_t c = 0; c < header->channelCount; c++) {
+        channels[c].responseBell.fetch_add(1, std::memory_order_relaxed);
+        futexWake(channels[c].responseBell);
+    }
+    unmapSegment(base, mappedBytes);
+    unlinkSegment(name);
+    base = nullptr;
+    header = nullptr;
+    channels = nullptr;
+    records = nullptr;
+}
+
+bool ShmSolverServer::pending() const
+{
+    for (uint32_t c = 0; c < header->channelCount; c++) {
+        if (channels[c].submitted.load(std::memory_order_acquire) != channels[c].solved.load(std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::size_t ShmSolverServer::poll()
+{
+    if (!base) {
+        return 0;
+    }
+    const uint64_t mask = header->ringRecords - 1;
+    std::size_t total = 0;
+    for (uint32_t c = 0; c < header->channelCount; c++) {
+        ShmChannel& channel = channels[c];
+        uint64_t solved = channel.solved.load(std::memory_order_relaxed);
+        uint64_t submitted = channel.submitted.load(std::memory_order_acquire);
+        if (solved == submitted) {
+            continue;
+        }
+        ShmRecord* ring = records + std::size_t(c) * header->ringRecords;
+        for (uint64_t slot = solved; slot != submitted; slot++) {
+            solveTriangle(ring[slot & mask].values);
+        }
+        channel.solved.store(submitted, std::memory_order_release);
+        notify(channel.clientWaiting, channel.responseBell);
+        total += std::size_t(submitted - solved);
+    }
+    return total;
+}
+
+std::size_t ShmSolverServer::serve(const std::atomic<bool>& stop, const ShmWaitOptions& options)
+{
+    std::size_t total = 0;
+    while (base && !stop.load(std::memory_order_relaxed)) {
+        std::size_t solved = poll();
+        total += solved;
+        if (!solved) {
+            waitFor([this] { return pending(); }, [&stop] { return stop.load(std::memory_order_relaxed); },
+                    header->serverWaiting, header->doorbell, options);
+        }
+    }
+    return total;
+}
+
+ShmSolverClient::~ShmSolverClient()
+{
+    detach();
+}
+
+bool ShmSolverClient::attach(const std::string& name, std::string& error)
+{
+    detach();
+    base = mapSegment(name, 0, false, mappedBytes, error);
+    if (!base) {
+        return false;
+    }
+    header = reinterpret_cast<ShmHeader*>(base);
+    if (std::memcmp(header->magic, "TSHM", 4) != 0 || !header->ready.load(std::memory_order_acquire)
+        || header->version != ShmSolverVersion || header->segmentBytes != mappedBytes) {
+        error = name + " is not a trianglesolver segment of version " + std::to_string(ShmSolverVersion);
+        detach();
+        return false;
+    }
+    if (!processAlive(header->serverPid.load(std::memory_order_relaxed))) {
+        error = "the server of " + name + " is not running";
+        detach();
+        return false;
+    }
+    ShmChannel* channels = reinterpret_cast<ShmChannel*>(base + ChannelsOffset);
+    const uint32_t self = currentPid();
+    for (uint32_t c = 0; c < header->channelCount && !channel; c++) {
+        uint32_t owner = channels[c].owner.load(std::memory_order_relaxed);
+        if ((owner == 0 || !processAlive(owner))
+            && channels[c].owner.compare_exchange_strong(owner, self, std::memory_order_acquire)) {
+            channel = &channels[c];
+            ring = reinterpret_cast<ShmRecord*>(base + recordsOffset(header->channelCount))
+                + std::size_t(c) * header->ringRecords;
+        }
+    }
+    if (!channel) {
+        error = "every channel of " + name + " is taken";
+        detach();
+        return false;
+    }
+    // A previous owner may have left records behind: let the server finish
+    // them and start past them.
+    mask = header->ringRecords - 1;
+    submitted = channel->submitted.load(std::memory_order_relaxed);
+    while (channel->solved.load(std::memory_order_acquire) != submitted) {
+        if (!processAlive(header->serverPid.load(std::memory_order_relaxed))) {
+            error = "the server of " + name + " is not running";
+            detach();
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    received = submitted;
+    channel->received.store(received, std::memory_order_release);
+    return true;
+}
+
+void ShmSolverClient::detach()
+{
+    if (channel) {
+        channel->owner.store(0, std::memory_order_release);
+    }
+    if (base) {
+        unmapSegment(base, mappedBytes);
+    }
+    base = nullptr;
+    header = nullptr;
+    channel = nullptr;
+    ring = nullptr;
+}
+
+ShmRecord* ShmSolverClient::request()
+{
+    if (!channel || submitted - received > mask) {
+        return nullptr;
+    }
+    return &ring[submitted & mask];
+}
+
+void ShmSolverClient::submit()
+{
+    channel->submitted.store(++submitted, std::memory_order_release);
+    notify(header->serverWaiting, header->doorbell);
+}
+
+const ShmRecord* ShmSolverClient::tryResponse()
+{
+    if (!channel || received == submitted || channel->solved.load(std::memory_order_acquire) == received) {
+        return nullptr;
+    }
+    return &ring[received & mask];
+}
+
+const ShmRecord* ShmSolverClient::response(const ShmWaitOptions& options)
+{
+    if (!channel || received == submitted) {
+        return nullptr;
+    }
+    bool solved = waitFor([this] { return channel->solved.load(std::memory_order_acquire) != received; },
+                          [this] { return !processAlive(header->serverPid.load(std::memory_order_relaxed)); },
+                          channel->clientWaiting, channel->responseBell, options);
+    return solved ? &ring[received & mask] : nullptr;
+}
+
+void ShmSolverClient::release()
+{
+    channel->received.store(++received, std::memory_order_release);
+}
+
+bool ShmSolverClient::solve(TriangleValues& values, const ShmWaitOptions& options)
+{
+    ShmRecord* record = request();
+    if (!record || outstanding()) {
+        return false;
+    }
+    record->tag = 0;
+    record->values = values;
+    submit();
+    const ShmRecord* result = response(options);
+    if (!result) {
+        return false;
+    }
+    values = result->values;
+    release();
+    return true;
+}
@@ -0,0 +1,120 @@
+#ifndef SHMSOLVER_H
+#define SHMSOLVER_H
+
+#include "triangleCore.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Solving for processes on the same host without sockets or serialization:
+// a POSIX shared-memory segment ("/name", see shm_open) that a server
+// process creates and clients map.
+//
+// The segment holds one channel per client. A channel is a ring of
+// fixed-width records (a tag and the 18 values in calculateMissingValues
+// order) with three cursors: the client writes the inputs into the slot at
+// submitted, the server solves slots in place up to solved, and the client
+// reads the results and frees slots up to received. The request ring
+// [solved, submitted) and the response ring [received, solved) share the
+// slots, so a record is never copied between them. Each cursor is written
+// by one side only and sits on its own cache line.
+//
+// Waiting spins first and then sleeps on a futex (Linux; elsewhere it naps
+// briefly instead). Each side raises a flag before sleeping, and the other
+// side issues the wake syscall only while the flag is up, so a busy pair
+// makes no syscalls at all.
+
+const uint32_t ShmSolverVersion = 1;
+
+// One ring slot. values holds the inputs on submit and all 18 fields once solved.
+struct ShmRecord {
+    uint64_t tag; // the client's, returned untouched
+    TriangleValues values;
+};
+
+struct ShmWaitOptions {
+    unsigned spinIterations = 2000; // polls before sleeping
+    bool sleep = true;              // false: busy-poll and never sleep (keeps a core busy while waiting)
+};
+
+struct ShmHeader;
+struct ShmChannel;
+
+class ShmSolverServer
+{
+public:
+    ShmSolverServer() = default;
+    ShmSolverServer(const ShmSolverServer&) = delete;
+    ShmSolverServer& operator=(const ShmSolverServer&) = delete;
+    ~ShmSolverServer();
+
+    // Creates the segment name (replacing a stale one) with channels clients
+    // of ringRecords slots each (rounded up to a power of two). Returns false
+    // and sets error on failure.
+    bool create(const std::string& name, unsigned channels, unsigned ringRecords, std::string& error);
+    // Unmaps and unlinks the segment.
+    void close();
+    bool isOpen() const { return base != nullptr; }
+
+    // Solves every submitted record once; returns how many.
+    std::size_t poll();
+    // Polls until stop is set, waiting as options says while there is no work.
+    // Returns the records solved.
+    std::size_t serve(const std::atomic<bool>& stop, const ShmWaitOptions& options = ShmWaitOptions());
+
+private:
+    bool pending() const;
+
+    char* base = nullptr;
+    std::size_t mappedBytes = 0;
+    std::string name;
+    ShmHeader* header = nullptr;
+    ShmChannel* channels = nullptr;
+    ShmRecord* records = nullptr;
+};
+
+// One client: owns one channel of a server's segment. Not thread safe; use
+// one client per thread.
+class ShmSolverClient
+{
+public:
+    ShmSolverClient() = default;
+    ShmSolverClient(const ShmSolverClient&) = delete;
+    ShmSolverClient& operator=(const ShmSolverClient&) = delete;
+    ~ShmSolverClient();
+
+    // Maps name and claims a free channel (or one whose client process has
+    // exited). Returns false and sets error on failure.
+    bool attach(const std::string& name, std::string& error);
+    void detach();
+    bool isAttached() const { return channel != nullptr; }
+
+    // Zero-copy use: fill the slot request() returns, then submit() it.
+    // request() returns nullptr while the ring is full of unreceived records.
+    ShmRecord* request();
+    void submit();
+    // The oldest submitted record once the server has solved it, or nullptr
+    // if nothing is outstanding (or the server exited). The slot stays
+    // valid until release().
+    const ShmRecord* response(const ShmWaitOptions& options = ShmWaitOptions());
+    const ShmRecord* tryResponse();
+    void release();
+    std::size_t outstanding() const { return std::size_t(submitted - received); }
+
+    // One round trip: solves values in place. False if not attached, the
+    // ring is full, or the server went away.
+    bool solve(TriangleValues& values, const ShmWaitOptions& options = ShmWaitOptions());
+
+private:
+    char* base = nullptr;
+    std::size_t mappedBytes = 0;
+    ShmHeader* header = nullptr;
+    ShmChannel* channel = nullptr;
+    ShmRecord* ring = nullptr;
+    uint64_t mask = 0;
+    uint64_t submitted = 0; // local copies of the cursors this side writes
+    uint64_t received = 0;
+};
+
+#endif // SHMSOLVER_H
@@ -0,0 +1,32 @@
+#include "solveArena.h"
+#include <cstdint>
+#include <new>
+
+namespace {
+const std::size_t ThreadArenaSize = 4 * 1024 * 1024;
+}
+
+SolveArena::SolveArena(std::size_t capacity)
+    : block(new unsigned char[capacity])
+    , size(capacity)
+{
+}
+
+void* SolveArena::allocate(std::size_t bytes, std::size_t alignment)
+{
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.get());
+    std::uintptr_t start = (base + used + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+    std::size_t end = start - base + bytes;
+    if (end > size) {
+        // Callers size their requests from the arena capacity, so running out is a bug.
+        throw std::bad_alloc();
+    }
+    used = end;
+    return reinterpret_cast<void*>(start);
+}
+
+SolveArena& SolveArena::forThread()
+{
+    thread_local SolveArena arena(ThreadArenaSize);
+    return arena;
+}
@@ -0,0 +1,36 @@
+#ifndef SOLVEARENA_H
+#define SOLVEARENA_H
+
+#include <cstddef>
+#include <memory>
+
+// Bump allocator over one block that is reserved up front and reused.
+// Each worker thread owns one (see forThread), so batch code can get scratch
+// memory for parsing and formatting without touching the heap per triangle.
+class SolveArena
+{
+public:
+    explicit SolveArena(std::size_t capacity);
+
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+    template <typename T>
+    T* allocateArray(std::size_t count) {
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Everything handed out since the last reset becomes invalid.
+    void reset() { used = 0; }
+
+    std::size_t bytesUsed() const { return used; }
+    std::size_t capacity() const { return size; }
+
+    // Arena of the calling thread, created on first use.
+    static SolveArena& forThread();
+
+private:
+    std::unique_ptr<unsigned char[]> block;
+    std::size_t size;
+    std::size_t used = 0;
+};
+
+#endif // SOLVEARENA_H
@@ -0,0 +1,192 @@
+#include "solveHistoryModel.h"
+#include <algorithm>
+
+namespace {
+
+// Past this many separate insertion points a merged chunk is shown with one
+// model reset: every beginInsertRows moves the tail of the visible index.
+const std::size_t MaxInsertRuns = 64;
+
+// Sort order over stored rows. NaN results (unsolvable rows) sort to the end
+// in both directions.
+struct SortedBefore {
+    const std::vector<float> *key;
+    bool ascending;
+
+    bool operator()(uint32_t a, uint32_t b) const {
+        float x = (*key)[a], y = (*key)[b];
+        return (ascending ? x < y : x > y) || (x == x && y != y);
+    }
+};
+
+}
+
+SolveHistoryModel::SolveHistoryModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+int SolveHistoryModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : int(visible.size());
+}
+
+int SolveHistoryModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : FieldCount;
+}
+
+QVariant SolveHistoryModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || (role != Qt::DisplayRole && role != Qt::ToolTipRole)) {
+        return QVariant();
+    }
+    float value = columns[index.column()][visible[index.row()]];
+    return QString::number(value);
+}
+
+QVariant SolveHistoryModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    if (orientation == Qt::Horizontal) {
+        return QString::fromLatin1(kTriangleFieldNames[section]);
+    }
+    return QString::number(visible[section] + 1);
+}
+
+void SolveHistoryModel::reserve(std::size_t rows)
+{
+    for (std::vector<float> &column : columns) {
+        column.reserve(rows);
+    }
+    visible.reserve(rows);
+}
+
+void SolveHistoryModel::append(const TriangleValues &values)
+{
+    append(&values, 1);
+}
+
+void SolveHistoryModel::append(const TriangleValues *rows, std::size_t count)
+{
+    if (count == 0) {
+        return;
+    }
+    std::size_t first = stored;
+    for (int field = 0; field < FieldCount; field++) {
+        std::vector<float> &column = columns[field];
+        for (std::size_t i = 0; i < count; i++) {
+            column.push_back(float(fieldValue(rows[i], field)));
+        }
+    }
+    stored += count;
+
+    std::vector<uint32_t> added;
+    for (std::size_t row = first; row < stored; row++) {
+        if (passesFilter(uint32_t(row))) {
+            added.push_back(uint32_t(row));
+        }
+    }
+    if (added.empty()) {
+        return;
+    }
+    if (sortColumn < 0 || sortColumn >= FieldCount) {
+        beginInsertRows(QModelIndex(), int(visible.size()), int(visible.size() + added.size() - 1));
+        visible.insert(visible.end(), added.begin(), added.end());
+        endInsertRows();
+        return;
+    }
+
+    // Sort just the new rows and merge them into the sorted view. Equal keys
+    // keep stored order, so they go after the rows already shown.
+    SortedBefore before{&columns[sortColumn], sortOrder == Qt::AscendingOrder};
+    std::stable_sort(added.begin(), added.end(), before);
+    std::vector<std::size_t> positions(added.size());
+    std::size_t runs = 0;
+    auto from = visible.begin();
+    for (std::size_t i = 0; i < added.size(); i++) {
+        from = std::upper_bound(from, visible.end(), added[i], before);
+        positions[i] = std::size_t(from - visible.begin());
+        runs += i == 0 || positions[i] != positions[i - 1];
+    }
+    if (runs > MaxInsertRuns) {
+        std::vector<uint32_t> merged(visible.size() + added.size());
+        std::merge(visible.begin(), visible.end(), added.begin(), added.end(), merged.begin(), before);
+        beginResetModel();
+        visible.swap(merged);
+        endResetModel();
+        return;
+    }
+    // Last run first, so the positions of the earlier runs stay valid.
+    for (std::size_t end = added.size(); end > 0;) {
+        std::size_t begin = end - 1;
+        while (begin > 0 && positions[begin - 1] == positions[end - 1]) {
+            begin--;
+        }
+        int row = int(positions[begin]);
+        beginInsertRows(QModelIndex(), row, row + int(end - begin) - 1);
+        visible.insert(visible.begin() + positions[begin], added.begin() + begin, added.begin() + end);
+        endInsertRows();
+        end = begin;
+    }
+}
+
+void SolveHistoryModel::clear()
+{
+    beginResetModel();
+    for (std::vector<float> &column : columns) {
+        column.clear();
+    }
+    stored = 0;
+    visible.clear();
+    endResetModel();
+}
+
+void SolveHistoryModel::sort(int column, Qt::SortOrder order)
+{
+    sortColumn = column;
+    sortOrder = order;
+    beginResetModel();
+    rebuildOrder();
+    endResetModel();
+}
+
+void SolveHistoryModel::setFilter(int column, double minValue, double maxValue)
+{
+    filterColumn = column;
+    filterMin = minValue;
+    filterMax = maxValue;
+    beginResetModel();
+    rebuildOrder();
+    endResetModel();
+}
+
+void SolveHistoryModel::clearFilter()
+{
+    setFilter(-1, 0, 0);
+}
+
+bool SolveHistoryModel::passesFilter(uint32_t row) const
+{
+    if (filterColumn < 0) {
+        return true;
+    }
+    float value = columns[filterColumn][row];
+    return value >= filterMin && value <= filterMax;
+}
+
+void SolveHistoryModel::rebuildOrder()
+{
+    visible.clear();
+    for (std::size_t row = 0; row < stored; row++) {
+        if (passesFilter(uint32_t(row))) {
+            visible.push_back(uint32_t(row));
+        }
+    }
+    if (sortColumn < 0 || sortColumn >= FieldCount) {
+        return;
+    }
+    std::stable_sort(visible.begin(), visible.end(), SortedBefore{&columns[sortColumn], sortOrder == Qt::AscendingOrder});
+}
@@ -0,0 +1,53 @@
+#ifndef SOLVEHISTORYMODEL_H
+#define SOLVEHISTORYMODEL_H
+
+#include <QAbstractTableModel>
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "triangleCore.h"
+
+// Table of every solved triangle in the session, one column per output.
+// Values live in one float array per column (72 bytes a row) and the view
+// only asks for visible cells, so a million rows stay cheap. Sorting and
+// filtering only rebuild the visible-row -> stored-row index, never the data.
+class SolveHistoryModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    explicit SolveHistoryModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    void append(const TriangleValues &values);
+    void append(const TriangleValues *rows, std::size_t count);
+    void clear();
+    void reserve(std::size_t rows);
+
+    // Shows only rows whose column value is within [minValue, maxValue].
+    void setFilter(int column, double minValue, double maxValue);
+    void clearFilter();
+
+    std::size_t storedRows() const { return stored; }
+
+private:
+    bool passesFilter(uint32_t row) const;
+    void rebuildOrder();
+
+    std::array<std::vector<float>, FieldCount> columns;
+    std::size_t stored = 0;
+    std::vector<uint32_t> visible; // visible row -> stored row
+
+    int sortColumn = -1;
+    Qt::SortOrder sortOrder = Qt::AscendingOrder;
+    int filterColumn = -1;
+    double filterMin = 0;
+    double filterMax = 0;
+};
+
+#endif // SOLVEHISTORYMODEL_H
@@ -0,0 +1,349 @@
+#include "sphericalTriangle.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+enum SphericalCase : uint8_t {
+    Case_SSS,
+    Case_SAS, // two sides and the angle between them
+    Case_ASA, // two angles and the side between them
+    Case_AAA,
+    Case_None,
+    CaseCount
+};
+
+// A row in canonical form: the sides a, b, c opposite the vertices 1, 2, 3
+// and the angles A, B, C at them. Vertex 1 is A, B or C depending on the
+// rotation, so one kernel per case covers all three placements.
+enum Slot { Slot_a, Slot_b, Slot_c, Slot_A, Slot_B, Slot_C, SlotCount };
+
+const uint8_t CaseSlots[Case_None] = {
+    (1u << Slot_a) | (1u << Slot_b) | (1u << Slot_c),
+    (1u << Slot_b) | (1u << Slot_c) | (1u << Slot_A),
+    (1u << Slot_a) | (1u << Slot_B) | (1u << Slot_C),
+    (1u << Slot_A) | (1u << Slot_B) | (1u << Slot_C),
+};
+
+const int OppositeSide[3] = {Field_BC, Field_AC, Field_AB};
+
+int slotVertex(int slot, int rotation)
+{
+    return (slot % 3 + rotation) % 3;
+}
+
+int slotField(int slot, int rotation)
+{
+    int vertex = slotVertex(slot, rotation);
+    return slot < Slot_A ? OppositeSide[vertex] : Field_angleA + vertex;
+}
+
+struct CaseEntry {
+    uint8_t sphericalCase = Case_None;
+    uint8_t rotation = 0;
+    uint8_t used = 0; // the input fields (bits of SphericalInputMask) the case starts from
+};
+
+// Case and rotation for every combination of known sides and angles.
+struct CaseTable {
+    CaseEntry entry[SphericalInputMask + 1];
+
+    CaseTable() {
+        for (uint32_t mask = 0; mask <= SphericalInputMask; mask++) {
+            for (int c = 0; c < Case_None && entry[mask].sphericalCase == Case_None; c++) {
+                for (int rotation = 0; rotation < 3; rotation++) {
+                    uint32_t needed = 0;
+                    for (int slot = 0; slot < SlotCount; slot++) {
+                        if (CaseSlots[c] & (1u << slot)) {
+                            needed |= 1u << slotField(slot, rotation);
+                        }
+                    }
+                    if ((mask & needed) == needed) {
+                        entry[mask] = {uint8_t(c), uint8_t(rotation), uint8_t(needed)};
+                        break;
+                    }
+                }
+            }
+        }
+    }
+};
+
+const CaseTable& caseTable()
+{
+    static const CaseTable table;
+    return table;
+}
+
+const std::size_t Block = 256;
+
+// One block of rows, sorted by case, in radians on the unit sphere. The
+// kernels over it do not vectorize, even at -O3: every iteration calls
+// libm sin, atan2 or asin, which have no vector forms to call at these
+// flags. Batching saves the per-call setup, not the trig, which dominates.
+struct Lanes {
+    double x[SlotCount][Block];
+    double excess[Block];
+    double inRadius[Block];
+    double circumRadius[Block];
+    double height[3][Block];
+    bool ok[Block];
+    uint16_t row[Block];
+    uint8_t rotation[Block];
+    uint8_t used[Block];
+};
+
+// Three sides: the half-angle formulas, tan(A/2)^2 = sin(s-b) sin(s-c) / (sin s sin(s-a)).
+void solveSss(Lanes& l, std::size_t begin, std::size_t end)
+{
+    const double pi = PI;
+    for (std::size_t i = begin; i < end; i++) {
+        double a = l.x[Slot_a][i];
+        double b = l.x[Slot_b][i];
+        double c = l.x[Slot_c][i];
+        double s = (a + b + c) / 2;
+        double sa = (b + c - a) / 2;
+        double sb = (a + c - b) / 2;
+        double sc = (a + b - c) / 2;
+        double sinS = std::sin(s);
+        double sinSa = std::sin(sa);
+        double sinSb = std::sin(sb);
+        double sinSc = std::sin(sc);
+        l.x[Slot_A][i] = 2 * std::atan2(std::sqrt(sinSb * sinSc), std::sqrt(sinS * sinSa));
+        l.x[Slot_B][i] = 2 * std::atan2(std::sqrt(sinSa * sinSc), std::sqrt(sinS * sinSb));
+        l.x[Slot_C][i] = 2 * std::atan2(std::sqrt(sinSa * sinSb), std::sqrt(sinS * sinSc));
+        l.ok[i] = l.ok[i] && sa > 0 && sb > 0 && sc > 0 && s < pi;
+    }
+}
+
+// Two sides and the included angle. The third side comes from
+//   sin^2(a/2) = sin^2((b-c)/2) + sin b sin c sin^2(A/2)
+//   cos^2(a/2) = cos^2((b+c)/2) + sin b sin c cos^2(A/2),
+// both sums of non-negative terms, and the other angles from Napier's analogies.
+void solveSas(Lanes& l, std::size_t begin, std::size_t end)
+{
+    for (std::size_t i = begin; i < end; i++) {
+        double b = l.x[Slot_b][i];
+        double c = l.x[Slot_c][i];
+        double A = l.x[Slot_A][i];
+        double sinHalfA = std::sin(A / 2);
+        double cosHalfA = std::cos(A / 2);
+        double sinDiff = std::sin((b - c) / 2);
+        double cosDiff = std::cos((b - c) / 2);
+        double sinSum = std::sin((b + c) / 2);
+        double cosSum = std::cos((b + c) / 2);
+        double k = std::sin(b) * std::sin(c);
+        double sinHalfA2 = sinDiff * sinDiff + k * sinHalfA * sinHalfA;
+        double cosHalfA2 = cosSum * cosSum + k * cosHalfA * cosHalfA;
+        l.x[Slot_a][i] = 2 * std::atan2(std::sqrt(sinHalfA2), std::sqrt(cosHalfA2));
+        double half = std::atan2(cosDiff * cosHalfA, cosSum * sinHalfA);    // (B + C) / 2
+        double halfDiff = std::atan2(sinDiff * cosHalfA, sinSum * sinHalfA); // (B - C) / 2
+        l.x[Slot_B][i] = half + halfDiff;
+        l.x[Slot_C][i] = half - halfDiff;
+    }
+}
+
+// Two angles and the included side: the polar triangle of solveSas.
+void solveAsa(Lanes& l, std::size_t begin, std::size_t end)
+{
+    for (std::size_t i = begin; i < end; i++) {
+        double a = l.x[Slot_a][i];
+        double B = l.x[Slot_B][i];
+        double C = l.x[Slot_C][i];
+        double sinHalfa = std::sin(a / 2);
+        double cosHalfa = std::cos(a / 2);
+        double sinDiff = std::sin((B - C) / 2);
+        double cosDiff = std::cos((B - C) / 2);
+        double sinSum = std::sin((B + C) / 2);
+        double cosSum = std::cos((B + C) / 2);
+        double k = std::sin(B) * std::sin(C);
+        double sinHalfA2 = cosSum * cosSum + k * sinHalfa * sinHalfa;
+        double cosHalfA2 = sinDiff * sinDiff + k * cosHalfa * cosHalfa;
+        l.x[Slot_A][i] = 2 * std::atan2(std::sqrt(sinHalfA2), std::sqrt(cosHalfA2));
+        double half = std::atan2(cosDiff * sinHalfa, cosSum * cosHalfa);     // (b + c) / 2
+        double halfDiff = std::atan2(sinDiff * sinHalfa, sinSum * cosHalfa); // (b - c) / 2
+        l.x[Slot_b][i] = half + halfDiff;
+        l.x[Slot_c][i] = half - halfDiff;
+    }
+}
+
+// Three angles: tan(a/2)^2 = sin(E/2) sin(A - E/2) / (sin(B - E/2) sin(C - E/2)), E the excess.
+void solveAaa(Lanes& l, std::size_t begin, std::size_t end)
+{
+    const double pi = PI;
+    for (std::size_t i = begin; i < end; i++) {
+        double A = l.x[Slot_A][i];
+        double B = l.x[Slot_B][i];
+        double C = l.x[Slot_C][i];
+        double halfExcess = (A + B + C - pi) / 2;
+        double ea = (pi + A - B - C) / 2;
+        double eb = (pi + B - A - C) / 2;
+        double ec = (pi + C - A - B) / 2;
+        double sinE = std::sin(halfExcess);
+        double sinEa = std::sin(ea);
+        double sinEb = std::sin(eb);
+        double sinEc = std::sin(ec);
+        l.x[Slot_a][i] = 2 * std::atan2(std::sqrt(sinE * sinEa), std::sqrt(sinEb * sinEc));
+        l.x[Slot_b][i] = 2 * std::atan2(std::sqrt(sinE * sinEb), std::sqrt(sinEa * sinEc));
+        l.x[Slot_c][i] = 2 * std::atan2(std::sqrt(sinE * sinEc), std::sqrt(sinEa * sinEb));
+        l.ok[i] = l.ok[i] && halfExcess > 0 && ea > 0 && eb > 0 && ec > 0;
+    }
+}
+
+// The quantities every case shares, from the six sides and angles:
+//   tan(E/2) = sin(b/2) sin(c/2) sin A / (cos(b/2) cos(c/2) + sin(b/2) sin(c/2) cos A)
+//   tan r = tan(A/2) sin(s - a),  tan R = tan(a/2) / cos((B + C - A)/2),  sin h_a = sin b sin C
+void finish(Lanes& l, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; i++) {
+        double a = l.x[Slot_a][i];
+        double b = l.x[Slot_b][i];
+        double c = l.x[Slot_c][i];
+        double A = l.x[Slot_A][i];
+        double B = l.x[Slot_B][i];
+        double C = l.x[Slot_C][i];
+        // Whole angles from the half angles (sin x = 2 sin(x/2) cos(x/2)) to save libm calls.
+        double sinHalfa = std::sin(a / 2);
+        double cosHalfa = std::cos(a / 2);
+        double sinHalfb = std::sin(b / 2);
+        double cosHalfb = std::cos(b / 2);
+        double sinHalfc = std::sin(c / 2);
+        double cosHalfc = std::cos(c / 2);
+        double sinHalfA = std::sin(A / 2);
+        double cosHalfA = std::cos(A / 2);
+        double sinA = 2 * sinHalfA * cosHalfA;
+        double cosA = (cosHalfA - sinHalfA) * (cosHalfA + sinHalfA);
+        double product = sinHalfb * sinHalfc;
+        l.excess[i] = 2 * std::atan2(product * sinA, cosHalfb * cosHalfc + product * cosA);
+        l.inRadius[i] = std::atan2(sinHalfA * std::sin((b + c - a) / 2), cosHalfA);
+        l.circumRadius[i] = std::atan2(sinHalfa, cosHalfa * std::cos((B + C - A) / 2));
+        l.height[0][i] = std::asin(2 * sinHalfb * cosHalfb * std::sin(C));
+        l.height[1][i] = std::asin(2 * sinHalfc * cosHalfc * sinA);
+        l.height[2][i] = std::asin(2 * sinHalfa * cosHalfa * std::sin(B));
+    }
+}
+
+uint32_t writeRow(const Lanes& l, std::size_t i, double radius, TriangleValues& out)
+{
+    const double degreesPerRadian = 180.0 / PI;
+    TriangleValues row;
+    std::fill_n(&row.AB, FieldCount, std::numeric_limits<double>::quiet_NaN());
+    if (!l.ok[i]) {
+        out = row;
+        return 0;
+    }
+    int rotation = l.rotation[i];
+    for (int slot = 0; slot < SlotCount; slot++) {
+        int field = slotField(slot, rotation);
+        if (!(l.used[i] & (1u << field))) {
+            fieldValue(row, field) = l.x[slot][i] * (slot < Slot_A ? radius : degreesPerRadian);
+        } else {
+            fieldValue(row, field) = fieldValue(out, field); // the input, unchanged
+        }
+        if (slot < Slot_A) {
+            fieldValue(row, Field_HeightAH + slotVertex(slot, rotation)) = l.height[slot][i] * radius;
+        }
+    }
+    row.Area = l.excess[i] * radius * radius;
+    row.inRadius = l.inRadius[i] * radius;
+    row.circumRadius = l.circumRadius[i] * radius;
+    out = row;
+
+    uint32_t mask = 0;
+    for (int field = 0; field < FieldCount; field++) {
+        if (std::isfinite(fieldValue(row, field))) {
+            mask |= 1u << field;
+        }
+    }
+    return mask;
+}
+
+// Classifies up to Block rows by case, gathers them into canonical lanes,
+// runs each case's kernel over its range and writes the rows back.
+std::size_t solveBlock(const TriangleValues* inputs, TriangleValues* outputs, std::size_t count, double radius,
+                       uint32_t* outputMasks, Lanes& l)
+{
+    const CaseTable& table = caseTable();
+    const double pi = PI;
+    const double radiansPerDegree = PI / 180.0;
+    uint8_t cases[Block];
+    std::size_t start[CaseCount + 1] = {};
+    for (std::size_t i = 0; i < count; i++) {
+        cases[i] = table.entry[knownMask(inputs[i]) & SphericalInputMask].sphericalCase;
+        start[cases[i] + 1]++;
+    }
+    for (int c = 0; c < CaseCount; c++) {
+        start[c + 1] += start[c];
+    }
+
+    std::size_t next[CaseCount];
+    std::copy(start, start + CaseCount, next);
+    for (std::size_t i = 0; i < count; i++) {
+        const CaseEntry& entry = table.entry[knownMask(inputs[i]) & SphericalInputMask];
+        std::size_t lane = next[entry.sphericalCase]++;
+        l.row[lane] = uint16_t(i);
+        l.rotation[lane] = entry.rotation;
+        l.used[lane] = entry.used;
+        // Sides past half a great circle and angles of 180 degrees or more make no triangle.
+        bool ok = entry.sphericalCase != Case_None;
+        for (int slot = 0; slot < SlotCount; slot++) {
+            double value = fieldValue(inputs[i], slotField(slot, entry.rotation));
+            double angle = value * (slot < Slot_A ? 1 / radius : radiansPerDegree);
+            if (ok && (CaseSlots[entry.sphericalCase] & (1u << slot))) {
+                ok = angle < pi;
+            }
+            l.x[slot][lane] = angle;
+        }
+        l.ok[lane] = ok;
+    }
+
+    solveSss(l, start[Case_SSS], start[Case_SSS + 1]);
+    solveSas(l, start[Case_SAS], start[Case_SAS + 1]);
+    solveAsa(l, start[Case_ASA], start[Case_ASA + 1]);
+    solveAaa(l, start[Case_AAA], start[Case_AAA + 1]);
+    finish(l, start[Case_None]);
+
+    std::size_t solved = 0;
+    for (std::size_t lane = 0; lane < count; lane++) {
+        std::size_t i = l.row[lane];
+        TriangleValues row = inputs[i];
+        uint32_t mask = writeRow(l, lane, radius, row);
+        outputs[i] = row;
+        if (outputMasks) {
+            outputMasks[i] = mask;
+        }
+        solved += mask != 0;
+    }
+    return solved;
+}
+
+}
+
+uint32_t solveSphericalTriangle(TriangleValues& values, const SphericalOptions& options)
+{
+    uint32_t mask = 0;
+    solveSphericalBatch(&values, &values, 1, options, &mask);
+    return mask;
+}
+
+std::size_t solveSphericalBatch(const TriangleValues* inputs, TriangleValues* outputs, std::size_t count,
+                                const SphericalOptions& options, uint32_t* outputMasks)
+{
+    if (!(options.radius > 0) || !std::isfinite(options.radius)) {
+        for (std::size_t i = 0; i < count; i++) {
+            std::fill_n(&outputs[i].AB, FieldCount, std::numeric_limits<double>::quiet_NaN());
+            if (outputMasks) {
+                outputMasks[i] = 0;
+            }
+        }
+        return 0;
+    }
+    Lanes lanes;
+    std::size_t solved = 0;
+    for (std::size_t first = 0; first < count; first += Block) {
+        std::size_t n = std::min(Block, count - first);
+        solved += solveBlock(inputs + first, outputs + first, n, options.radius,
+                             outputMasks ? outputMasks + first : nullptr, lanes);
+    }
+    return solved;
+}
@@ -0,0 +1,51 @@
+#ifndef SPHERICALTRIANGLE_H
+#define SPHERICALTRIANGLE_H
+
+#include "triangleCore.h"
+#include <cstddef>
+#include <cstdint>
+
+// Triangles on a sphere, for geodesic work: the sides are great-circle arcs
+// measured in the unit of the radius, the angles are in degrees as in the
+// planar solver. Rows are TriangleValues and the knowns are found with
+// knownMask, like solveTriangle; only the fields in SphericalFieldMask have
+// a spherical meaning; the medians and bisectors come out as NaN.
+//
+// Every formula is written in half-angle / atan2 form (no acos or asin of
+// a value near 1), so triangles of a few metres on the Earth and sides
+// close to half a great circle keep full precision.
+
+// Mean radius of the Earth (IUGG), in kilometres.
+const double EarthRadiusKm = 6371.0088;
+
+// The sides and angles: the inputs the spherical cases start from.
+const uint32_t SphericalInputMask = (1u << Field_AB) | (1u << Field_AC) | (1u << Field_BC)
+                                    | (1u << Field_angleA) | (1u << Field_angleB) | (1u << Field_angleC);
+// Everything solveSphericalTriangle fills in: Area is the spherical excess
+// times radius^2, heights and the in/circumradius are arcs like the sides.
+const uint32_t SphericalFieldMask = SphericalInputMask | (1u << Field_Area)
+                                    | (1u << Field_HeightAH) | (1u << Field_HeightBH) | (1u << Field_HeightCH)
+                                    | (1u << Field_inRadius) | (1u << Field_circumRadius);
+
+struct SphericalOptions {
+    double radius = 1;
+};
+
+// Solves values in place from the first case its knowns allow, in this
+// order: three sides, two sides and the angle between them, two angles and
+// the side between them, three angles (on a sphere they fix the size too).
+// Known fields the chosen case does not use are overwritten. Three angles
+// fix small triangles poorly (the excess is lost in the angles' rounding),
+// so for those the sides should be among the knowns.
+// Returns the output mask: bit i set when field i holds a solved value. On 0
+// (no case applies, or the knowns make no spherical triangle) every field is NaN.
+uint32_t solveSphericalTriangle(TriangleValues& values, const SphericalOptions& options = SphericalOptions());
+
+// The same for count rows; inputs and outputs may be the same array. Rows are
+// grouped by case in blocks and each case runs as a straight-line
+// structure-of-arrays kernel. outputMasks, if given, receives each row's
+// output mask. Returns the number of rows solved.
+std::size_t solveSphericalBatch(const TriangleValues* inputs, TriangleValues* outputs, std::size_t count,
+                                const SphericalOptions& options = SphericalOptions(), uint32_t* outputMasks = nullptr);
+
+#endif // SPHERICALTRIANGLE_H
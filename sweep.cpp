@@ -0,0 +1,248 @@
+#include "sweep.h"
+#include "batchKernels.h"
+#include "batchSolver.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+const uint32_t SssMask = (1u << Field_AB) | (1u << Field_AC) | (1u << Field_BC);
+
+bool parseNumber(const char* begin, const char* end, double& value)
+{
+    auto [ptr, ec] = std::from_chars(begin, end, value);
+    return ec == std::errc() && ptr == end;
+}
+
+std::string formatNumber(double value)
+{
+    char text[32];
+    return std::string(text, std::to_chars(text, text + sizeof text, value).ptr);
+}
+
+// Written into the output file's header, so that a resume only continues
+// the same grid and shard: row indices mean nothing for any other.
+std::string describeSweep(const std::vector<SweepAxis>& axes, const SweepOptions& options)
+{
+    std::string text = "sweep";
+    for (const SweepAxis& axis : axes) {
+        text += std::string(" ") + kTriangleFieldNames[axis.field] + "=" + formatNumber(axis.from) + ":"
+            + formatNumber(axis.to) + ":" + formatNumber(axis.step);
+    }
+    return text + " shard " + std::to_string(options.shardIndex) + "/" + std::to_string(options.shardCount);
+}
+
+}
+
+uint64_t SweepAxis::count() const
+{
+    if (!(step > 0) || !(to >= from)) {
+        return 0;
+    }
+    // The slack keeps "0:1:0.1" at 11 values despite 0.1 not being exact.
+    return uint64_t(std::floor((to - from) / step + 1e-9)) + 1;
+}
+
+bool parseSweepAxis(const std::string& text, SweepAxis& axis, std::string& error)
+{
+    std::size_t equals = text.find('=');
+    std::size_t colon1 = text.find(':', equals);
+    std::size_t colon2 = colon1 == std::string::npos ? colon1 : text.find(':', colon1 + 1);
+    if (equals == std::string::npos || colon2 == std::string::npos) {
+        error = "expected field=from:to:step, got " + text;
+        return false;
+    }
+    std::string name = text.substr(0, equals);
+    axis.field = -1;
+    for (int field = 0; field < InputFieldCount; field++) {
+        if (name == kTriangleFieldNames[field]) {
+            axis.field = field;
+        }
+    }
+    if (axis.field < 0) {
+        error = "unknown input field " + name;
+        return false;
+    }
+    const char* p = text.data();
+    if (!parseNumber(p + equals + 1, p + colon1, axis.from) || !parseNumber(p + colon1 + 1, p + colon2, axis.to)
+        || !parseNumber(p + colon2 + 1, p + text.size(), axis.step)) {
+        error = "bad number in " + text;
+        return false;
+    }
+    return true;
+}
+
+bool runSweep(const std::vector<SweepAxis>& axes, const std::string& path, const SweepOptions& options,
+              SweepStats& stats, std::string& error)
+{
+    auto start = std::chrono::steady_clock::now();
+    stats = SweepStats();
+
+    if (axes.empty()) {
+        error = "no sweep axes";
+        return false;
+    }
+    if (options.shardCount == 0 || options.shardIndex >= options.shardCount) {
+        error = "bad shard";
+        return false;
+    }
+    uint32_t mask = 0;
+    uint64_t gridRows = 1;
+    bool allPositive = true;
+    for (const SweepAxis& axis : axes) {
+        if (axis.field < 0 || axis.field >= InputFieldCount || (mask & (1u << axis.field))) {
+            error = "each axis needs a distinct input field";
+            return false;
+        }
+        uint64_t count = axis.count();
+        if (count == 0) {
+            error = std::string("empty range for ") + kTriangleFieldNames[axis.field];
+            return false;
+        }
+        if (gridRows > std::numeric_limits<uint64_t>::max() / count) {
+            error = "sweep grid too large";
+            return false;
+        }
+        gridRows *= count;
+        mask |= 1u << axis.field;
+        allPositive = allPositive && axis.from > 0;
+    }
+    // Three positive sides always take the SSS branch, so the vector kernel can solve them.
+    const bool sss = mask == SssMask && allPositive;
+
+    stats.gridRows = gridRows;
+    stats.firstRow = gridRows / options.shardCount * options.shardIndex
+        + std::min<uint64_t>(options.shardIndex, gridRows % options.shardCount);
+    stats.endRow = stats.firstRow + gridRows / options.shardCount + (options.shardIndex < gridRows % options.shardCount);
+
+    std::vector<std::string> names(kTriangleFieldNames, kTriangleFieldNames + FieldCount);
+    ColumnarWriter writer;
+    if (!writer.open(path, names, describeSweep(axes, options), options.resume, error)
+        || (!options.formats.empty() && !writer.setFormats(options.formats, error))) {
+        return false;
+    }
+    uint64_t first = writer.hasGroups() ? writer.endRow() : stats.firstRow;
+    if (first < stats.firstRow || first > stats.endRow) {
+        error = path + " holds rows outside this shard";
+        return false;
+    }
+    stats.resumedAt = first;
+
+    const std::size_t chunkRows = std::max<std::size_t>(1, options.chunkRows);
+    const uint64_t chunkCount = (stats.endRow - first + chunkRows - 1) / chunkRows;
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+
+    // Chunks are solved in any order but written strictly in order.
+    std::atomic<uint64_t> nextChunk{0};
+    std::mutex writeMutex;
+    std::condition_variable written;
+    uint64_t nextToWrite = 0;
+    bool writeFailed = false;
+
+    auto worker = [&] {
+        std::vector<TriangleValues> rows(chunkRows);
+        std::vector<TriangleValues> solved(chunkRows);
+        std::vector<double> block(FieldCount * chunkRows);
+        double* columns[FieldCount];
+        for (int field = 0; field < FieldCount; field++) {
+            columns[field] = block.data() + field * chunkRows;
+        }
+        SssColumns sssColumns;
+        sssColumns.Area = columns[Field_Area];
+        sssColumns.angleA = columns[Field_angleA];
+        sssColumns.angleB = columns[Field_angleB];
+        sssColumns.angleC = columns[Field_angleC];
+        sssColumns.inRadius = columns[Field_inRadius];
+        sssColumns.circumRadius = columns[Field_circumRadius];
+        sssColumns.HeightAH = columns[Field_HeightAH];
+        sssColumns.HeightBH = columns[Field_HeightBH];
+        sssColumns.HeightCH = columns[Field_HeightCH];
+        sssColumns.median_AM = columns[Field_median_AM];
+        sssColumns.median_BM = columns[Field_median_BM];
+        sssColumns.median_CM = columns[Field_median_CM];
+        sssColumns.BisectorA = columns[Field_BisectorA];
+        sssColumns.BisectorB = columns[Field_BisectorB];
+        sssColumns.BisectorC = columns[Field_BisectorC];
+        std::vector<uint64_t> digits(axes.size());
+
+        for (;;) {
+            uint64_t chunk = nextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= chunkCount) {
+                return;
+            }
+            uint64_t chunkFirst = first + chunk * chunkRows;
+            std::size_t count = std::size_t(std::min<uint64_t>(chunkRows, stats.endRow - chunkFirst));
+
+            // Decode the first row's axis indices once, then count up like an odometer.
+            uint64_t rest = chunkFirst;
+            for (std::size_t a = axes.size(); a-- > 0;) {
+                uint64_t axisCount = axes[a].count();
+                digits[a] = rest % axisCount;
+                rest /= axisCount;
+            }
+            for (std::size_t i = 0; i < count; i++) {
+                TriangleValues& row = rows[i];
+                row = TriangleValues();
+                for (std::size_t a = 0; a < axes.size(); a++) {
+                    fieldValue(row, axes[a].field) = axes[a].value(digits[a]);
+                }
+                for (std::size_t a = axes.size(); a-- > 0;) {
+                    if (++digits[a] < axes[a].count()) {
+                        break;
+                    }
+                    digits[a] = 0;
+                }
+            }
+
+            if (sss) {
+                for (std::size_t i = 0; i < count; i++) {
+                    columns[Field_AB][i] = rows[i].AB;
+                    columns[Field_AC][i] = rows[i].AC;
+                    columns[Field_BC][i] = rows[i].BC;
+                }
+                solveSssBatch(columns[Field_AB], columns[Field_AC], columns[Field_BC], count, sssColumns);
+            } else {
+                solveBatch(rows.data(), solved.data(), count);
+                for (int field = 0; field < FieldCount; field++) {
+                    for (std::size_t i = 0; i < count; i++) {
+                        columns[field][i] = fieldValue(solved[i], field);
+                    }
+                }
+            }
+
+            std::unique_lock<std::mutex> lock(writeMutex);
+            written.wait(lock, [&] { return nextToWrite == chunk; });
+            if (!writeFailed && !writer.writeGroup(chunkFirst, columns, uint32_t(count))) {
+                writeFailed = true;
+            }
+            if (!writeFailed) {
+                stats.rowsWritten += count;
+            }
+            nextToWrite++;
+            written.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+    if (!writer.close() || writeFailed) {
+        error = "cannot write " + path;
+        return false;
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
@@ -0,0 +1,56 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "columnarWriter.h"
+#include "triangleCore.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Parameter sweeps for design tables: every combination of the given known
+// quantities over their ranges, solved in parallel and streamed to a
+// columnar file (columnarWriter.h) with all 18 outputs per row.
+//
+// The grid is never materialized: row i is decoded from its index, last
+// axis fastest. Shard k of n takes the contiguous row range
+// [k * rows / n, (k + 1) * rows / n), so separate processes can split one
+// sweep, and a resumed run continues after the last complete row group. The
+// axes and shard are recorded in the file, and resuming with others fails.
+
+struct SweepAxis {
+    int field = Field_AB; // an input field
+    double from = 0;
+    double to = 0;
+    double step = 1;
+
+    uint64_t count() const; // values from, from + step, ... up to to (inclusive, with rounding slack)
+    double value(uint64_t index) const { return from + index * step; }
+};
+
+struct SweepOptions {
+    unsigned threads = 0;          // 0 = one per hardware thread
+    std::size_t chunkRows = 4096;  // rows per task and per row group
+    unsigned shardIndex = 0;
+    unsigned shardCount = 1;
+    bool resume = false;           // continue an existing output file of the same sweep instead of overwriting it
+    std::vector<ColumnarFormat> formats; // one per output field; empty keeps every column float64
+};
+
+struct SweepStats {
+    uint64_t gridRows = 0;  // whole grid, all shards
+    uint64_t firstRow = 0;  // this shard's range
+    uint64_t endRow = 0;
+    uint64_t resumedAt = 0; // first row solved by this run
+    uint64_t rowsWritten = 0;
+    double seconds = 0;
+};
+
+// Returns false and sets error for bad axes or output problems.
+bool runSweep(const std::vector<SweepAxis>& axes, const std::string& path, const SweepOptions& options,
+              SweepStats& stats, std::string& error);
+
+// Parses "field=from:to:step", e.g. "angleB=1:179:0.5".
+bool parseSweepAxis(const std::string& text, SweepAxis& axis, std::string& error);
+
+#endif // SWEEP_H
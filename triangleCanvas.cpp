@@ -0,0 +1,425 @@
+#include "triangleCanvas.h"
+#include "vertexInput.h"
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPainterPath>
+#include <QScreen>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const double VertexGrabPixels = 10;
+const double EdgeGrabPixels = 6;
+const double MarginPixels = 36;
+const qint64 ContinuousFrameNs = 100 * 1000 * 1000; // longer gaps are idle time, not frames
+
+const QColor MedianColor(79, 195, 247);
+const QColor BisectorColor(255, 183, 77);
+const QColor HeightColor(129, 199, 132);
+
+// Vertices a field's value depends on (A = 1, B = 2, C = 4): each side on
+// its two end points, everything else on all three.
+unsigned fieldVertices(int field)
+{
+    switch (field) {
+    case Field_AB:
+        return 1 | 2;
+    case Field_AC:
+        return 1 | 4;
+    case Field_BC:
+        return 2 | 4;
+    default:
+        return 7;
+    }
+}
+
+// Fields that can change when the vertices in moved all shift by the same
+// vector: a field stays put when none or all of its vertices move.
+uint32_t fieldsMovedBy(unsigned moved)
+{
+    uint32_t fields = 0;
+    for (int field = 0; field < FieldCount; field++) {
+        unsigned depends = fieldVertices(field);
+        if ((depends & moved) && (depends & ~moved)) {
+            fields |= 1u << field;
+        }
+    }
+    return fields;
+}
+
+double distanceToSegment(QPointF point, QPointF from, QPointF to)
+{
+    QPointF edge = to - from;
+    double length2 = QPointF::dotProduct(edge, edge);
+    double t = length2 > 0 ? std::clamp(QPointF::dotProduct(point - from, edge) / length2, 0.0, 1.0) : 0.0;
+    QPointF offset = point - (from + t * edge);
+    return std::sqrt(QPointF::dotProduct(offset, offset));
+}
+
+QPointF eventPosition(const QMouseEvent *event)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    return event->position();
+#else
+    return event->localPos();
+#endif
+}
+
+double cross(QPointF a, QPointF b)
+{
+    return a.x() * b.y() - a.y() * b.x();
+}
+
+// p50, p99 and max of the nonzero samples, in milliseconds.
+struct FrameStats {
+    double p50 = 0;
+    double p99 = 0;
+    double max = 0;
+    int samples = 0;
+};
+
+FrameStats frameStats(const float *nanoseconds, int count)
+{
+    float sorted[128];
+    int n = 0;
+    for (int i = 0; i < count && n < 128; i++) {
+        if (nanoseconds[i] > 0) {
+            sorted[n++] = nanoseconds[i];
+        }
+    }
+    FrameStats stats;
+    stats.samples = n;
+    if (n) {
+        std::sort(sorted, sorted + n);
+        stats.p50 = sorted[n / 2] * 1e-6;
+        stats.p99 = sorted[std::min(n - 1, n * 99 / 100)] * 1e-6;
+        stats.max = sorted[n - 1] * 1e-6;
+    }
+    return stats;
+}
+
+}
+
+TriangleCanvas::TriangleCanvas(QWidget *parent)
+    : QWidget(parent)
+{
+    setFocusPolicy(Qt::ClickFocus);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setCursor(Qt::OpenHandCursor);
+    clock.start();
+}
+
+void TriangleCanvas::setTriangle(const TriangleValues &values)
+{
+    valid = values.AB > 0 && values.AC > 0 && values.angleA > 0 && values.angleA < 180
+        && std::isfinite(values.AB) && std::isfinite(values.AC);
+    solved = values;
+    if (valid) {
+        vertices[0] = QPointF(0, 0);
+        vertices[1] = QPointF(values.AB, 0);
+        vertices[2] = QPointF(values.AC * cosDegrees(values.angleA), values.AC * sinDegrees(values.angleA));
+        fitView();
+    }
+    grabbed = GrabNone;
+    movePending = false;
+    update();
+}
+
+void TriangleCanvas::setOverlayVisible(bool visible)
+{
+    showOverlay = visible;
+    update();
+}
+
+void TriangleCanvas::fitView()
+{
+    double left = std::min({vertices[0].x(), vertices[1].x(), vertices[2].x()});
+    double right = std::max({vertices[0].x(), vertices[1].x(), vertices[2].x()});
+    double bottom = std::min({vertices[0].y(), vertices[1].y(), vertices[2].y()});
+    double top = std::max({vertices[0].y(), vertices[1].y(), vertices[2].y()});
+    double usableWidth = std::max(1.0, width() - 2 * MarginPixels);
+    double usableHeight = std::max(1.0, height() - 2 * MarginPixels);
+    scale = std::min(usableWidth / std::max(right - left, 1e-12), usableHeight / std::max(top - bottom, 1e-12));
+    origin = QPointF(width() / 2.0 - scale * (left + right) / 2, height() / 2.0 + scale * (bottom + top) / 2);
+}
+
+QPointF TriangleCanvas::toScreen(QPointF point) const
+{
+    return QPointF(origin.x() + scale * point.x(), origin.y() - scale * point.y());
+}
+
+QPointF TriangleCanvas::toModel(QPointF position) const
+{
+    return QPointF((position.x() - origin.x()) / scale, (origin.y() - position.y()) / scale);
+}
+
+unsigned TriangleCanvas::grabAt(QPointF position) const
+{
+    QPointF screen[3] = {toScreen(vertices[0]), toScreen(vertices[1]), toScreen(vertices[2])};
+    for (int v = 0; v < 3; v++) {
+        QPointF offset = position - screen[v];
+        if (QPointF::dotProduct(offset, offset) <= VertexGrabPixels * VertexGrabPixels) {
+            return 1u << v;
+        }
+    }
+    for (int v = 0; v < 3; v++) {
+        int next = (v + 1) % 3;
+        if (distanceToSegment(position, screen[v], screen[next]) <= EdgeGrabPixels) {
+            return (1u << v) | (1u << next);
+        }
+    }
+    double d0 = cross(screen[1] - screen[0], position - screen[0]);
+    double d1 = cross(screen[2] - screen[1], position - screen[1]);
+    double d2 = cross(screen[0] - screen[2], position - screen[2]);
+    bool inside = (d0 >= 0 && d1 >= 0 && d2 >= 0) || (d0 <= 0 && d1 <= 0 && d2 <= 0);
+    return inside ? GrabAll : GrabNone;
+}
+
+void TriangleCanvas::mousePressEvent(QMouseEvent *event)
+{
+    if (!valid || event->button() != Qt::LeftButton) {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+    grabbed = grabAt(eventPosition(event));
+    if (grabbed != GrabNone) {
+        grabModel = toModel(eventPosition(event));
+        setCursor(Qt::ClosedHandCursor);
+    }
+}
+
+void TriangleCanvas::mouseMoveEvent(QMouseEvent *event)
+{
+    if (grabbed == GrabNone) {
+        QWidget::mouseMoveEvent(event);
+        return;
+    }
+    if (!movePending) {
+        pendingSince = clock.nsecsElapsed();
+    }
+    pendingModel = toModel(eventPosition(event));
+    movePending = true;
+    update(); // coalesced: any number of moves before the next paint cost one solve
+}
+
+void TriangleCanvas::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (grabbed == GrabNone || event->button() != Qt::LeftButton) {
+        QWidget::mouseReleaseEvent(event);
+        return;
+    }
+    applyPendingMove();
+    grabbed = GrabNone;
+    setCursor(Qt::OpenHandCursor);
+    for (const QPointF &vertex : vertices) {
+        if (!rect().contains(toScreen(vertex).toPoint())) {
+            fitView();
+            break;
+        }
+    }
+    update();
+    emit dragFinished(solved);
+}
+
+void TriangleCanvas::keyPressEvent(QKeyEvent *event)
+{
+    if (event->key() == Qt::Key_F3) {
+        setOverlayVisible(!showOverlay);
+        return;
+    }
+    QWidget::keyPressEvent(event);
+}
+
+void TriangleCanvas::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    if (valid && grabbed == GrabNone) {
+        fitView();
+    }
+}
+
+void TriangleCanvas::applyPendingMove()
+{
+    if (!movePending) {
+        return;
+    }
+    movePending = false;
+    QPointF delta = pendingModel - grabModel;
+    grabModel = pendingModel;
+    for (int v = 0; v < 3; v++) {
+        if (grabbed & (1u << v)) {
+            vertices[v] += delta;
+        }
+    }
+    uint32_t affected = fieldsMovedBy(grabbed);
+    if (!affected || delta.isNull()) {
+        return;
+    }
+
+    qint64 start = clock.nsecsElapsed();
+    double A[2] = {vertices[0].x(), vertices[0].y()};
+    double B[2] = {vertices[1].x(), vertices[1].y()};
+    double C[2] = {vertices[2].x(), vertices[2].y()};
+    TriangleValues fresh;
+    solveFromVertices(A, B, C, 2, fresh);
+    quint32 changed = 0;
+    for (int field = 0; field < FieldCount; field++) {
+        if ((affected & (1u << field)) && fieldValue(fresh, field) != fieldValue(solved, field)) {
+            fieldValue(solved, field) = fieldValue(fresh, field);
+            changed |= 1u << field;
+        }
+    }
+    solveTimes[frameCount % FrameHistory] = float(clock.nsecsElapsed() - start);
+    if (changed) {
+        emit triangleChanged(solved, changed);
+    }
+}
+
+void TriangleCanvas::paintEvent(QPaintEvent *)
+{
+    const qint64 start = clock.nsecsElapsed();
+    const int slot = frameCount % FrameHistory;
+    const double refreshHz = screen() ? screen()->refreshRate() : 60;
+    frameIntervals[slot] = lastPaint && start - lastPaint < ContinuousFrameNs ? float(start - lastPaint) : 0;
+    inputLatencies[slot] = 0;
+    solveTimes[slot] = 0;
+    if (movePending) {
+        inputLatencies[slot] = float(start - pendingSince);
+        lateFrames += start - pendingSince > qint64(1e9 / refreshHz);
+    }
+    lastPaint = start;
+    applyPendingMove();
+
+    QPainter painter(this);
+    painter.fillRect(rect(), Qt::black);
+    painter.setRenderHint(QPainter::Antialiasing);
+    if (!valid) {
+        painter.setPen(Qt::gray);
+        painter.drawText(rect(), Qt::AlignCenter, "Solve a triangle, then drag\na vertex, an edge or the inside");
+    } else {
+        QPointF screen[3];
+        for (int v = 0; v < 3; v++) {
+            screen[v] = toScreen(vertices[v]);
+        }
+        for (int v = 0; v < 3; v++) {
+            // Cevians from v to the opposite side pq, computed in model units.
+            QPointF vertex = vertices[v];
+            QPointF p = vertices[(v + 1) % 3];
+            QPointF q = vertices[(v + 2) % 3];
+            QPointF side = q - p;
+            double toP = std::hypot(vertex.x() - p.x(), vertex.y() - p.y());
+            double toQ = std::hypot(vertex.x() - q.x(), vertex.y() - q.y());
+            double sideLength2 = QPointF::dotProduct(side, side);
+
+            painter.setPen(QPen(MedianColor, 1));
+            painter.drawLine(screen[v], toScreen((p + q) / 2));
+            if (toP + toQ > 0) {
+                painter.setPen(QPen(BisectorColor, 1));
+                painter.drawLine(screen[v], toScreen(p + side * (toP / (toP + toQ))));
+            }
+            if (sideLength2 > 0) {
+                double t = QPointF::dotProduct(vertex - p, side) / sideLength2;
+                QPointF foot = p + side * t;
+                painter.setPen(QPen(HeightColor, 1));
+                painter.drawLine(screen[v], toScreen(foot));
+                if (t < 0 || t > 1) {
+                    // Obtuse triangle: the foot lies on the extension of the side.
+                    painter.setPen(QPen(HeightColor, 1, Qt::DotLine));
+                    painter.drawLine(toScreen(t < 0 ? p : q), toScreen(foot));
+                }
+            }
+        }
+
+        QPainterPath outline;
+        outline.moveTo(screen[0]);
+        outline.lineTo(screen[1]);
+        outline.lineTo(screen[2]);
+        outline.closeSubpath();
+        painter.setPen(QPen(Qt::white, 2));
+        painter.drawPath(outline);
+
+        QPointF centroid = (screen[0] + screen[1] + screen[2]) / 3;
+        const char *names[3] = {"A", "B", "C"};
+        for (int v = 0; v < 3; v++) {
+            bool held = grabbed & (1u << v);
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(held ? QColor(255, 82, 82) : QColor(Qt::white));
+            painter.drawEllipse(screen[v], held ? 6.0 : 4.5, held ? 6.0 : 4.5);
+            QPointF outward = screen[v] - centroid;
+            double length = std::hypot(outward.x(), outward.y());
+            QPointF label = screen[v] + (length > 0 ? outward * (14 / length) : QPointF(0, -14));
+            painter.setPen(Qt::white);
+            painter.drawText(QRectF(label - QPointF(8, 8), QSizeF(16, 16)), Qt::AlignCenter, names[v]);
+        }
+
+        int y = height() - 8;
+        painter.setPen(MedianColor);
+        painter.drawText(8, y, "median");
+        painter.setPen(BisectorColor);
+        painter.drawText(64, y, "bisector");
+        painter.setPen(HeightColor);
+        painter.drawText(130, y, "height");
+    }
+
+    // Drawn here rather than by a style sheet, which an opaque custom paintEvent skips.
+    painter.setRenderHint(QPainter::Antialiasing, false);
+    painter.setPen(Qt::white);
+    painter.setBrush(Qt::NoBrush);
+    painter.drawRect(rect().adjusted(0, 0, -1, -1));
+    if (showOverlay) {
+        drawOverlay(painter);
+    }
+    paintTimes[slot] = float(clock.nsecsElapsed() - start);
+    frameCount++;
+}
+
+void TriangleCanvas::drawOverlay(QPainter &painter)
+{
+    const double refreshHz = screen() ? screen()->refreshRate() : 60;
+    const double budgetMs = 1e3 / refreshHz;
+    const int count = std::min(frameCount, int(FrameHistory));
+    FrameStats interval = frameStats(frameIntervals.data(), count);
+    FrameStats latency = frameStats(inputLatencies.data(), count);
+    FrameStats paint = frameStats(paintTimes.data(), count);
+    FrameStats solve = frameStats(solveTimes.data(), count);
+
+    const QString lines[] = {
+        QString("display %1 Hz, budget %2 ms").arg(refreshHz, 0, 'f', 0).arg(budgetMs, 0, 'f', 2),
+        QString("frame interval p50 %1  p99 %2  max %3 ms")
+            .arg(interval.p50, 0, 'f', 2).arg(interval.p99, 0, 'f', 2).arg(interval.max, 0, 'f', 2),
+        QString("input to paint p50 %1  p99 %2 ms, %3 late of %4")
+            .arg(latency.p50, 0, 'f', 2).arg(latency.p99, 0, 'f', 2).arg(lateFrames).arg(frameCount),
+        QString("paint p50 %1  p99 %2 ms, solve p50 %3 us")
+            .arg(paint.p50, 0, 'f', 3).arg(paint.p99, 0, 'f', 3).arg(solve.p50 * 1e3, 0, 'f', 1),
+    };
+    const int lineHeight = 14;
+    const int graphHeight = 40;
+    QRectF box(6, 6, 300, 4 * lineHeight + graphHeight + 16);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(0, 0, 0, 190));
+    painter.drawRect(box);
+    painter.setPen(Qt::white);
+    for (int i = 0; i < 4; i++) {
+        painter.drawText(QPointF(box.left() + 6, box.top() + 14 + i * lineHeight), lines[i]);
+    }
+
+    // Last FrameHistory frame intervals, oldest first, against the budget line at half height.
+    const double graphBottom = box.bottom() - 6;
+    const double barWidth = (box.width() - 12) / FrameHistory;
+    for (int i = 0; i < count; i++) {
+        int slot = (frameCount - count + i) % FrameHistory;
+        double ms = frameIntervals[slot] * 1e-6;
+        if (ms <= 0) {
+            continue;
+        }
+        double barHeight = std::min(1.0, ms / (2 * budgetMs)) * graphHeight;
+        painter.fillRect(QRectF(box.left() + 6 + i * barWidth, graphBottom - barHeight, std::max(1.0, barWidth - 0.5),
+                                barHeight),
+                         ms > 1.5 * budgetMs ? QColor(255, 82, 82) : QColor(129, 199, 132));
+    }
+    painter.setPen(QPen(Qt::white, 1, Qt::DashLine));
+    painter.drawLine(QPointF(box.left() + 6, graphBottom - graphHeight / 2.0),
+                     QPointF(box.right() - 6, graphBottom - graphHeight / 2.0));
+}
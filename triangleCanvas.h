@@ -0,0 +1,89 @@
+#ifndef TRIANGLECANVAS_H
+#define TRIANGLECANVAS_H
+
+#include <QElapsedTimer>
+#include <QPointF>
+#include <QWidget>
+#include <array>
+#include <cstdint>
+#include "triangleCore.h"
+
+// Draws the solved triangle with its medians, angle bisectors and heights,
+// and lets the user drag a vertex, an edge or the whole triangle. Any drag
+// that changes the shape runs a full solveFromVertices on the new
+// coordinates; only a translation skips it. Of the fresh values, only the
+// fields whose vertices did not all move together are compared, copied and
+// reported: an edge drag keeps that edge, a vertex drag keeps the opposite
+// side. Mouse moves only record the latest position; the move is applied
+// in paintEvent, so there is one solve per frame however fast the events
+// come. F3 toggles an overlay with frame, paint and solve times.
+class TriangleCanvas : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit TriangleCanvas(QWidget *parent = nullptr);
+
+    // Lays out a solved triangle, A at the left and AB horizontal, scaled to
+    // fit. Values without three positive sides and an angle clear the canvas.
+    void setTriangle(const TriangleValues &values);
+    const TriangleValues &triangle() const { return solved; }
+
+    void setOverlayVisible(bool visible);
+    bool overlayVisible() const { return showOverlay; }
+
+signals:
+    // During a drag, at most once per frame; changedFields has bit f set
+    // for every TriangleField f whose value changed.
+    void triangleChanged(const TriangleValues &values, quint32 changedFields);
+    // The drag ended on values.
+    void dragFinished(const TriangleValues &values);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void keyPressEvent(QKeyEvent *event) override;
+
+private:
+    // Bit v stands for vertex v: A = 1, B = 2, C = 4.
+    enum Grab : unsigned { GrabNone = 0, GrabA = 1, GrabB = 2, GrabC = 4, GrabAll = 7 };
+
+    unsigned grabAt(QPointF position) const;
+    void applyPendingMove();
+    void fitView();
+    QPointF toScreen(QPointF point) const;
+    QPointF toModel(QPointF position) const;
+    void drawOverlay(QPainter &painter);
+
+    bool valid = false;
+    TriangleValues solved;
+    std::array<QPointF, 3> vertices; // model units, y up
+
+    // View: screen = origin + scale * (x, -y); frozen while dragging so the
+    // grabbed point stays under the cursor.
+    double scale = 1;
+    QPointF origin;
+
+    unsigned grabbed = GrabNone;
+    QPointF grabModel;     // model position of the last applied move
+    QPointF pendingModel;  // latest mouse position, applied at the next paint
+    bool movePending = false;
+    qint64 pendingSince = 0; // clock time of the first unapplied move
+
+    // Frame instrumentation, in nanoseconds, over the last FrameHistory frames.
+    static const int FrameHistory = 120;
+    bool showOverlay = false;
+    QElapsedTimer clock;
+    qint64 lastPaint = 0;
+    int frameCount = 0;
+    int lateFrames = 0; // input waited longer than one refresh interval for its paint
+    std::array<float, FrameHistory> frameIntervals{};
+    std::array<float, FrameHistory> inputLatencies{};
+    std::array<float, FrameHistory> paintTimes{};
+    std::array<float, FrameHistory> solveTimes{};
+};
+
+#endif // TRIANGLECANVAS_H
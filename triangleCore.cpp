@@ -0,0 +1,154 @@
+#include "triangleCore.h"
+#include "triangleCoreT.h"
+#include "angleTables.h"
+#include <cmath>
+#include <vector>
+
+const char* const kTriangleFieldNames[FieldCount] = {
+    "AB", "AC", "BC",
+    "angleA", "angleB", "angleC",
+    "median_AM", "median_BM", "median_CM",
+    "Area",
+    "BisectorA", "BisectorB", "BisectorC",
+    "HeightAH", "HeightBH", "HeightCH",
+    "inRadius", "circumRadius"
+};
+
+namespace {
+
+constexpr uint32_t bit(TriangleField field) {
+    return 1u << field;
+}
+
+constexpr uint32_t AllFields = (1u << FieldCount) - 1;
+
+// Everything the branch does not need, less the fields it leaves unset.
+constexpr uint32_t rest(uint32_t needs, uint32_t unset = 0) {
+    return AllFields & ~needs & ~unset;
+}
+
+constexpr uint32_t AB = bit(Field_AB), AC = bit(Field_AC), BC = bit(Field_BC);
+constexpr uint32_t angleA = bit(Field_angleA), angleB = bit(Field_angleB), angleC = bit(Field_angleC);
+constexpr uint32_t medianA = bit(Field_median_AM), medianB = bit(Field_median_BM), medianC = bit(Field_median_CM);
+constexpr uint32_t Area = bit(Field_Area);
+constexpr uint32_t BisectorA = bit(Field_BisectorA), BisectorB = bit(Field_BisectorB), BisectorC = bit(Field_BisectorC);
+constexpr uint32_t HeightA = bit(Field_HeightAH), HeightB = bit(Field_HeightBH), HeightC = bit(Field_HeightCH);
+constexpr uint32_t Angles = angleA | angleB | angleC;
+
+// In the order solveTriangleT tries them. The two-angle branches are split
+// by the side they scale from; with no side they only find the third angle.
+// The BisectorA/B/C + two sides branches that divide a product of three
+// lengths by 4 * Bisector^2 / (x + y)^2 - 1 are not scale-free.
+const TriangleBranch kBranches[] = {
+    {AB | BC | angleB, rest(AB | BC | angleB), true},
+    {AC | BC | angleC, rest(AC | BC | angleC), true},
+    {AB | AC | angleA, rest(AB | AC | angleA), true},
+    {AB | AC | Area, rest(AB | AC | Area), true},
+    // These two never compute their third side, so only what does not depend on it is solved.
+    {AC | BC | Area, Angles | HeightA | HeightB, true},
+    {AB | BC | Area, Angles | HeightA | HeightC, true},
+    {angleA | angleB | AC, rest(angleA | angleB | AC), true},
+    {angleA | angleB | BC, rest(angleA | angleB | BC), true},
+    {angleA | angleB, angleC, true},
+    {angleA | angleC | AB, rest(angleA | angleC | AB), true},
+    {angleA | angleC | BC, rest(angleA | angleC | BC), true},
+    {angleA | angleC, angleB, true},
+    {angleB | angleC | AB, rest(angleB | angleC | AB), true},
+    {angleB | angleC | AC, rest(angleB | angleC | AC), true},
+    {angleB | angleC, angleA, true},
+    {AB | AC | BC, rest(AB | AC | BC), true},
+    {medianA | AB | AC, rest(medianA | AB | AC), true},
+    {medianA | AB | BC, rest(medianA | AB | BC), true},
+    {medianA | AC | BC, rest(medianA | AC | BC), true},
+    {medianB | AB | BC, rest(medianB | AB | BC), true},
+    {medianB | AC | BC, rest(medianB | AC | BC), true},
+    {medianB | AB | AC, rest(medianB | AB | AC), true},
+    {medianC | AC | BC, rest(medianC | AC | BC), true},
+    {medianC | AB | BC, rest(medianC | AB | BC), true},
+    {medianC | AB | AC, rest(medianC | AB | AC), true},
+    {BisectorA | AC | AB, rest(BisectorA | AC | AB), true},
+    {BisectorA | AB | BC, rest(BisectorA | AB | BC), true},
+    {BisectorA | AC | BC, rest(BisectorA | AC | BC), false},
+    {BisectorB | AB | BC, rest(BisectorB | AB | BC), true},
+    {BisectorB | AC | BC, rest(BisectorB | AC | BC), false},
+    {BisectorB | AB | AC, rest(BisectorB | AB | AC), false},
+    {BisectorC | BC | AC, rest(BisectorC | BC | AC, BisectorA), true},
+    {BisectorC | AB | BC, rest(BisectorC | AB | BC, BisectorA), false},
+    {BisectorC | AC | AB, rest(BisectorC | AC | AB, BisectorA), false},
+    {angleA | AC | BisectorA, rest(angleA | AC | BisectorA), true},
+    {angleA | AB | BisectorA, rest(angleA | AB | BisectorA), true},
+    {angleB | BC | BisectorB, rest(angleB | BC | BisectorB), true},
+    {angleB | AB | BisectorB, rest(angleB | AB | BisectorB), true},
+    {angleC | AC | BisectorC, rest(angleC | AC | BisectorC, BisectorA), true},
+    {angleC | BC | BisectorC, rest(angleC | BC | BisectorC, BisectorA), true},
+};
+
+const int NoBranch = 0xff;
+
+}
+
+const TriangleBranch* triangleBranch(uint32_t knownMask) {
+    // First matching branch of every input mask, built once.
+    static const std::vector<unsigned char> branchOf = [] {
+        std::vector<unsigned char> table(std::size_t(1) << InputFieldCount, NoBranch);
+        for (uint32_t mask = 0; mask < table.size(); mask++) {
+            for (std::size_t i = 0; i < sizeof kBranches / sizeof kBranches[0]; i++) {
+                if ((mask & kBranches[i].needs) == kBranches[i].needs) {
+                    table[mask] = (unsigned char)i;
+                    break;
+                }
+            }
+        }
+        return table;
+    }();
+    int index = branchOf[knownMask & ((1u << InputFieldCount) - 1)];
+    return index == NoBranch ? nullptr : &kBranches[index];
+}
+
+const double PI = 3.14159265358979323846;
+double toRadians(double degree) {
+    return degree * (PI / 180.0);
+}
+
+double toDegrees(double radian) {
+    return radian * (180.0 / PI);
+}
+
+double sinDegrees(double degree) {
+    int step;
+    if (angleGridIndex(degree, step)) {
+        return kAngleTables.sin[step];
+    }
+    return sin(toRadians(degree));
+}
+
+double cosDegrees(double degree) {
+    int step;
+    if (angleGridIndex(degree, step)) {
+        return kAngleTables.cos[step];
+    }
+    return cos(toRadians(degree));
+}
+
+double tanDegrees(double degree) {
+    int step;
+    if (angleGridIndex(degree, step)) {
+        return kAngleTables.tan[step];
+    }
+    return tan(toRadians(degree));
+}
+
+std::tuple<double, double, double> calculate_3Angles(double AB, double AC, double BC) {
+    return triangleMath::calculate_3AnglesT(AB, AC, BC);
+}
+
+void solveTriangle(TriangleValues& values) {
+    solveTriangleT(values);
+}
+
+template void solveTriangleT(TriangleValuesT<float>&);
+template void solveTriangleT(TriangleValuesT<double>&);
+template void solveTriangleT(TriangleValuesT<long double>&);
+#ifdef TRIANGLE_HAVE_FLOAT128
+template void solveTriangleT(TriangleValuesT<__float128>&);
+#endif
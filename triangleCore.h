@@ -0,0 +1,134 @@
+#ifndef TRIANGLECORE_H
+#define TRIANGLECORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+
+// Qt-free solver core shared by the window and the batch code.
+// Nothing in here allocates, so it can run inside the batch hot loop.
+
+enum TriangleField {
+    Field_AB,
+    Field_AC,
+    Field_BC,
+    Field_angleA,
+    Field_angleB,
+    Field_angleC,
+    Field_median_AM,
+    Field_median_BM,
+    Field_median_CM,
+    Field_Area,
+    Field_BisectorA,
+    Field_BisectorB,
+    Field_BisectorC,
+    Field_HeightAH,
+    Field_HeightBH,
+    Field_HeightCH,
+    Field_inRadius,
+    Field_circumRadius,
+    FieldCount
+};
+
+// The 16 inputs come first, in calculateMissingValues order.
+const int InputFieldCount = Field_inRadius;
+
+template <typename T>
+struct TriangleValuesT {
+    T AB = 0;
+    T AC = 0;
+    T BC = 0;
+    T angleA = 0;
+    T angleB = 0;
+    T angleC = 0;
+    T median_AM = 0;
+    T median_BM = 0;
+    T median_CM = 0;
+    T Area = 0;
+    T BisectorA = 0;
+    T BisectorB = 0;
+    T BisectorC = 0;
+    T HeightAH = 0;
+    T HeightBH = 0;
+    T HeightCH = 0;
+    T inRadius = 0;
+    T circumRadius = 0;
+};
+
+using TriangleValues = TriangleValuesT<double>;
+
+extern const char* const kTriangleFieldNames[FieldCount];
+
+template <typename T>
+inline T TriangleValuesT<T>::* const kTriangleFields[FieldCount] = {
+    &TriangleValuesT<T>::AB, &TriangleValuesT<T>::AC, &TriangleValuesT<T>::BC,
+    &TriangleValuesT<T>::angleA, &TriangleValuesT<T>::angleB, &TriangleValuesT<T>::angleC,
+    &TriangleValuesT<T>::median_AM, &TriangleValuesT<T>::median_BM, &TriangleValuesT<T>::median_CM,
+    &TriangleValuesT<T>::Area,
+    &TriangleValuesT<T>::BisectorA, &TriangleValuesT<T>::BisectorB, &TriangleValuesT<T>::BisectorC,
+    &TriangleValuesT<T>::HeightAH, &TriangleValuesT<T>::HeightBH, &TriangleValuesT<T>::HeightCH,
+    &TriangleValuesT<T>::inRadius, &TriangleValuesT<T>::circumRadius
+};
+
+template <typename T>
+inline T& fieldValue(TriangleValuesT<T>& values, int field) {
+    return values.*kTriangleFields<T>[field];
+}
+template <typename T>
+inline const T& fieldValue(const TriangleValuesT<T>& values, int field) {
+    return values.*kTriangleFields<T>[field];
+}
+
+// Bit i is set when input field i is known (> 0), the same test the solver branches use.
+template <typename T>
+uint32_t knownMask(const TriangleValuesT<T>& values) {
+    uint32_t mask = 0;
+    for (int field = 0; field < InputFieldCount; field++) {
+        if (fieldValue(values, field) > 0) {
+            mask |= 1u << field;
+        }
+    }
+    return mask;
+}
+
+// One branch of solveTriangle: the inputs it needs, the fields it solves
+// (not those it fills in from a side it leaves unset), and whether its
+// outputs scale linearly with the input lengths (angles and the area
+// aside), which holds for all but five bisector branches.
+struct TriangleBranch {
+    uint32_t needs;
+    uint32_t derives;
+    bool scaleFree;
+};
+
+// The branch solveTriangle takes for knownMask, or nullptr when none applies
+// and it solves nothing.
+const TriangleBranch* triangleBranch(uint32_t knownMask);
+
+extern const double PI;
+double toRadians(double degree);
+double toDegrees(double radian);
+// sin/cos/tan of an angle in degrees. Angles on the 1/20 degree grid are
+// read from compile-time tables (angleTables.h), everything else goes to libm.
+double sinDegrees(double degree);
+double cosDegrees(double degree);
+double tanDegrees(double degree);
+std::tuple<double, double, double> calculate_3Angles(double AB, double AC, double BC);
+
+// Fills in every missing quantity of values from the known ones, in place.
+void solveTriangle(TriangleValues& values);
+
+// The same solver for other scalar types: float for throughput, long double
+// or __float128 (built with TRIANGLE_HAVE_FLOAT128) for reference runs. Only
+// double uses the angle tables.
+template <typename T>
+void solveTriangleT(TriangleValuesT<T>& values);
+
+extern template void solveTriangleT(TriangleValuesT<float>&);
+extern template void solveTriangleT(TriangleValuesT<double>&);
+extern template void solveTriangleT(TriangleValuesT<long double>&);
+#ifdef TRIANGLE_HAVE_FLOAT128
+extern template void solveTriangleT(TriangleValuesT<__float128>&);
+#endif
+
+#endif // TRIANGLECORE_H
@@ -0,0 +1,1052 @@
+#ifndef TRIANGLECORET_H
+#define TRIANGLECORET_H
+
+#include "triangleCore.h"
+#include <cmath>
+#include <tuple>
+#include <type_traits>
+#ifdef TRIANGLE_HAVE_FLOAT128
+#include <quadmath.h>
+#endif
+
+// Scalar-generic body of the solver. triangleCore.cpp instantiates it for
+// the scalar types listed in triangleCore.h; include this header directly
+// only to instantiate it for some other arithmetic type.
+
+namespace triangleMath {
+
+using std::acos;
+using std::asin;
+using std::cos;
+using std::sin;
+using std::sqrt;
+using std::tan;
+
+#ifdef TRIANGLE_HAVE_FLOAT128
+inline __float128 acos(__float128 x) { return acosq(x); }
+inline __float128 asin(__float128 x) { return asinq(x); }
+inline __float128 cos(__float128 x) { return cosq(x); }
+inline __float128 sin(__float128 x) { return sinq(x); }
+inline __float128 sqrt(__float128 x) { return sqrtq(x); }
+inline __float128 tan(__float128 x) { return tanq(x); }
+#endif
+
+template <typename T>
+struct ScalarTraits {
+    static T pi() { return T(3.14159265358979323846264338327950288L); }
+};
+template <>
+struct ScalarTraits<double> {
+    static double pi() { return PI; }
+};
+#ifdef TRIANGLE_HAVE_FLOAT128
+template <>
+struct ScalarTraits<__float128> {
+    // M_PIq needs -fext-numeric-literals, so sum a triple-double expansion instead.
+    static __float128 pi() {
+        return (__float128)0x1.921fb54442d18p+1 + (__float128)0x1.1a62633145c07p-53 + (__float128)-0x1.f1976b7ed8fbcp-109;
+    }
+};
+#endif
+
+template <typename T>
+inline T square(const T& x) {
+    return x * x;
+}
+
+template <typename T>
+T toRadiansT(const T& degree) {
+    return degree * (ScalarTraits<T>::pi() / 180);
+}
+
+template <typename T>
+T toDegreesT(const T& radian) {
+    return radian * (180 / ScalarTraits<T>::pi());
+}
+
+// Only double has the grid tables; other types always evaluate the trig.
+template <typename T>
+T sinDegreesT(const T& degree) {
+    if constexpr (std::is_same_v<T, double>) {
+        return sinDegrees(degree);
+    } else {
+        return sin(toRadiansT(degree));
+    }
+}
+
+template <typename T>
+T cosDegreesT(const T& degree) {
+    if constexpr (std::is_same_v<T, double>) {
+        return cosDegrees(degree);
+    } else {
+        return cos(toRadiansT(degree));
+    }
+}
+
+template <typename T>
+std::tuple<T, T, T> calculate_3AnglesT(const T& AB, const T& AC, const T& BC) {
+    T angleA = toDegreesT(acos((AB * AB + AC * AC - BC * BC) / (2 * AB * AC)));
+    T angleB = toDegreesT(acos((AB * AB + BC * BC - AC * AC) / (2 * AB * BC)));
+    T angleC = T(180) - angleA - angleB; // Calculate angleC as the remaining angle
+
+    return std::make_tuple(angleA, angleB, angleC);
+}
+
+}
+
+template <typename T>
+void solveTriangleT(TriangleValuesT<T>& values) {
+    using namespace triangleMath;
+
+
+    T& AB = values.AB;
+    T& AC = values.AC;
+    T& BC = values.BC;
+    T& angleA = values.angleA;
+    T& angleB = values.angleB;
+    T& angleC = values.angleC;
+    T& median_AM = values.median_AM;
+    T& median_BM = values.median_BM;
+    T& median_CM = values.median_CM;
+    T& Area = values.Area;
+    T& BisectorA = values.BisectorA;
+    T& BisectorB = values.BisectorB;
+    T& BisectorC = values.BisectorC;
+    T& HeightAH = values.HeightAH;
+    T& HeightBH = values.HeightBH;
+    T& HeightCH = values.HeightCH;
+    T& inRadius = values.inRadius;
+    T& circumRadius = values.circumRadius;
+    inRadius = 0;
+    circumRadius = 0;
+
+    if (AB > 0 && BC > 0 && angleB > 0) {
+        // Calculate AC using the Law of Cosines
+        AC = sqrt(AB * AB + BC * BC - 2 * AB * BC * cosDegreesT(angleB));
+
+        // Calculate angleA using the Law of Sines
+        angleA = toDegreesT(asin(AB * sinDegreesT(angleB) / AC));
+
+        // Calculate angleC
+        angleC = T(180) - angleA - angleB;
+
+        // Calculate Area
+        Area = T(0.5) * AB * BC * sinDegreesT(angleB);
+
+        // Calculate the circumradius
+        circumRadius = (AB * BC * AC) / (4 * Area);
+
+        // Calculate the inradius
+        T semiPerimeter = (AB + BC + AC) / 2;
+        inRadius = Area / semiPerimeter;
+        median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+        median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+        median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+        BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+        HeightAH= 2*Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+
+
+
+
+
+    } else if (AC > 0 && BC > 0 && angleC > 0) {
+        // Calculate AB using the Law of Cosines
+        AB = sqrt(AC * AC + BC * BC - 2 * AC * BC * cosDegreesT(angleC));
+
+        // Calculate angleA using the Law of Sines
+        angleA = toDegreesT(asin(BC * sinDegreesT(angleC) / AB));
+
+        // Calculate angleB
+        angleB = T(180) - angleA - angleC;
+
+        // Calculate Area
+        Area = T(0.5) * AC * BC * sinDegreesT(angleC);
+
+        // Calculate the circumradius
+        circumRadius = (AB * BC * AC) / (4 * Area);
+
+        // Calculate the inradius
+        T semiPerimeter = (AB + BC + AC) / 2;
+        inRadius = Area / semiPerimeter;
+        median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+        median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+        median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+        BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+        HeightAH= 2*Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+
+
+
+    } else if (AB > 0 && AC > 0 && angleA > 0) {
+        // Calculate BC using the Law of Cosines
+        BC = sqrt(AB * AB + AC * AC - 2 * AB * AC * cosDegreesT(angleA));
+
+        // Calculate angleB using the Law of Sines
+        angleB = toDegreesT(asin(AC * sinDegreesT(angleA) / BC));
+
+        // Calculate angleC
+        angleC = T(180) - angleA - angleB;
+
+        // Calculate Area
+        Area = T(0.5) * AB * AC * sinDegreesT(angleA);
+
+        // Calculate the circumradius
+        circumRadius = (AB * BC * AC) / (4 * Area);
+
+        // Calculate the inradius
+        T semiPerimeter = (AB + BC + AC) / 2;
+        inRadius = Area / semiPerimeter;
+        median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+        median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+        median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+        BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+        HeightAH= 2*Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+
+
+
+    } else if (AB > 0 && AC > 0 && Area > 0) {
+        T Sin = Area / (T(0.5) * AB * AC);
+        T final_sin = asin(Sin);
+        angleA = toDegreesT(final_sin);
+        BC = sqrt(AB * AB + AC * AC - 2 * AB * AC * cosDegreesT(angleA));
+
+        // Calculate angleB using the Law of Sines
+        angleB = toDegreesT(asin(AC * sinDegreesT(angleA) / BC));
+
+        // Calculate angleC
+        angleC = T(180) - angleA - angleB;
+
+        // Calculate the circumradius
+        circumRadius = (AB * BC * AC) / (4 * Area);
+
+        // Calculate the inradius
+        T semiPerimeter = (AB + BC + AC) / 2;
+        inRadius = Area / semiPerimeter;
+        median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+        median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+        median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+        BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+        HeightAH= 2*Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+
+
+    } else if (AC > 0 && BC > 0 && Area > 0) {
+        T Sin1 = Area / (T(0.5) * AC * BC);
+        T final_sin1 = asin(Sin1);
+        angleC = toDegreesT(final_sin1);
+
+        // Calculate angleA using the Law of Sines
+        angleA = toDegreesT(asin(BC * sinDegreesT(angleC) / AC));
+
+        // Calculate angleB
+        angleB = T(180) - angleA - angleC;
+
+        // Calculate the circumradius
+        circumRadius = (AB * BC * AC) / (4 * Area);
+
+        // Calculate the inradius
+        T semiPerimeter = (AB + BC + AC) / 2;
+        inRadius = Area / semiPerimeter;
+        median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+        median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+        median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+        BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+        HeightAH= 2*Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+
+
+
+    } else if (AB > 0 && BC > 0 && Area > 0) {
+        T Sin2 = Area / (T(0.5) * AB * BC);
+        T final_sin2 = asin(Sin2);
+        angleB = toDegreesT(final_sin2);
+
+        angleA = toDegreesT(asin(AB * sinDegreesT(angleB) / BC));
+
+        // Calculate angleC
+        angleC = T(180) - angleA - angleB;
+
+        // Calculate the circumradius
+        circumRadius = (AB * BC * AC) / (4 * Area);
+
+        // Calculate the inradius
+        T semiPerimeter = (AB + BC + AC) / 2;
+        inRadius = Area / semiPerimeter;
+        median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+        median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+        median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+        BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+        HeightAH= 2*Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+
+
+
+    } else if (angleA > 0 && angleB > 0) {
+        angleC = 180 - angleA - angleB;
+        if (AC > 0) {
+            BC = AC * sinDegreesT(angleA) / sinDegreesT(angleB);
+        } else if (BC > 0) {
+            AC = BC * sinDegreesT(angleB) / sinDegreesT(angleA);
+        }
+        AB = sqrt(AC * AC + BC * BC - 2 * AC * BC * cosDegreesT(angleC));
+
+        Area = T(0.5) * AB * AC * sinDegreesT(angleA);
+
+        // Calculate the circumradius
+        circumRadius = (AB * BC * AC) / (4 * Area);
+
+        // Calculate the inradius
+        T semiPerimeter = (AB + BC + AC) / 2;
+        inRadius = Area / semiPerimeter;
+        median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+        median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+        median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+        BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+        HeightAH= 2*Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+
+
+
+    } else if (angleA > 0 && angleC > 0) {
+        angleB = 180 - angleA - angleC;
+        if (AB > 0) {
+            BC = AB * sinDegreesT(angleA) / sinDegreesT(angleC);
+        } else if (BC > 0) {
+            AB = BC * sinDegreesT(angleC) / sinDegreesT(angleA);
+        }
+        AC = sqrt(AB * AB + BC * BC - 2 * AB * BC * cosDegreesT(angleB));
+        Area = T(0.5) * AB * AC * sinDegreesT(angleA);
+
+        // Calculate the circumradius
+        circumRadius = (AB * BC * AC) / (4 * Area);
+
+        // Calculate the inradius
+        T semiPerimeter = (AB + BC + AC) / 2;
+        inRadius = Area / semiPerimeter;
+        median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+        median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+        median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+        BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+        HeightAH= 2*Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+
+
+
+    } else if (angleB > 0 && angleC > 0) {
+        angleA = 180 - angleB - angleC;
+        if (AB > 0) {
+            AC = AB * sinDegreesT(angleB) / sinDegreesT(angleC);
+        } else if (AC > 0) {
+            AB = AC * sinDegreesT(angleC) / sinDegreesT(angleB);
+        }
+        BC = sqrt(AB * AB + AC * AC - 2 * AB * AC * cosDegreesT(angleA));
+        Area = T(0.5) * AB * AC * sinDegreesT(angleA);
+
+        // Calculate the circumradius
+        circumRadius = (AB * BC * AC) / (4 * Area);
+
+        // Calculate the inradius
+        T semiPerimeter = (AB + BC + AC) / 2;
+        inRadius = Area / semiPerimeter;
+        median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+        median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+        median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+        BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+        HeightAH= 2*Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+
+
+
+    } else if (AB > 0 && AC > 0 && BC > 0) {
+        T semiPerimeter = (AB + AC + BC) / 2;
+        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
+
+        // Calculate the circumradius
+        circumRadius = (AB * BC * AC) / (4 * Area);
+        auto [A, B, C] = calculate_3AnglesT(AB, AC, BC);
+        angleA=A;
+        angleB=B;
+        angleC=C;
+
+
+        // Calculate the inradius
+        inRadius = Area / semiPerimeter;
+        median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+        median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+        median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+        BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+        HeightAH=2* Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+
+
+    }
+    else if(median_AM>0 && AB>0 && AC>0){
+        BC=sqrt(2*square(AB)+2*square(AC)-4*square(median_AM));
+        T semiPerimeter = (AB + AC + BC) / 2;
+        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
+
+        // Calculate the circumradius
+        circumRadius = (AB * BC * AC) / (4 * Area);
+        angleA =  toDegreesT(acos((AB*AB + AC*AC - BC*BC) / (2*AB*AC)));
+        angleB =  toDegreesT(acos((AB*AB + BC*BC - AC*AC) / (2*AB*BC)));
+        angleC =  toDegreesT(acos((BC*BC + AC*AC - AB*AB) / (2*BC*AC)));
+
+        // Calculate the inradius
+        inRadius = Area / semiPerimeter;
+
+        median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+        median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+        BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+        HeightAH= 2*Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+
+    }
+    else if(median_AM>0 && AB>0 && BC>0){
+        AC=sqrt((4*square(median_AM)-2*square(AB)+square(BC))/2);
+        T semiPerimeter = (AB + AC + BC) / 2;
+        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
+
+        // Calculate the circumradius
+        circumRadius = (AB * BC * AC) / (4 * Area);
+        angleA =  toDegreesT(acos((AB*AB + AC*AC - BC*BC) / (2*AB*AC)));
+        angleB =  toDegreesT(acos((AB*AB + BC*BC - AC*AC) / (2*AB*BC)));
+        angleC =  toDegreesT(acos((BC*BC + AC*AC - AB*AB) / (2*BC*AC)));
+
+        median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+        median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+        inRadius = Area / semiPerimeter;
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+        BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+        HeightAH= 2*Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+
+
+
+    }
+    else if(median_AM>0 && AC>0 && BC>0){
+        AB=sqrt((4*square(median_AM)-2*square(AC)+square(BC)/2));
+        T semiPerimeter = (AB + AC + BC) / 2;
+        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
+
+        // Calculate the circumradius
+        circumRadius = (AB * BC * AC) / (4 * Area);
+        angleA =  toDegreesT(acos((AB*AB + AC*AC - BC*BC) / (2*AB*AC)));
+        angleB =  toDegreesT(acos((AB*AB + BC*BC - AC*AC) / (2*AB*BC)));
+        angleC =  toDegreesT(acos((BC*BC + AC*AC - AB*AB) / (2*BC*AC)));
+        inRadius = Area / semiPerimeter;
+        median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+        median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+        BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+        HeightAH= 2*Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+
+
+    }
+    else if (median_BM > 0 && AB > 0 && BC > 0) {
+        AC = sqrt(2*square(AB)+2*square(BC)-4*square(median_BM));
+        T semiPerimeter = (AB + AC + BC) / 2;
+        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
+        circumRadius = (AB * BC * AC) / (4 * Area);
+        angleA =  toDegreesT(acos((AB*AB + AC*AC - BC*BC) / (2*AB*AC)));
+        angleB =  toDegreesT(acos((AB*AB + BC*BC - AC*AC) / (2*AB*BC)));
+        angleC =  toDegreesT(acos((BC*BC + AC*AC - AB*AB) / (2*BC*AC)));
+        median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+        inRadius = Area / semiPerimeter;
+        median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+        BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+        HeightAH= 2*Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+
+
+    } else if (median_BM > 0 && AC > 0 && BC > 0) {
+        AB = sqrt((4 * square(median_BM) - 2 * square(BC) + square(AC)) / 2);
+        T semiPerimeter = (AB + AC + BC) / 2;
+        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
+        circumRadius = (AB * BC * AC) / (4 * Area);
+        angleA =  toDegreesT(acos((AB*AB + AC*AC - BC*BC) / (2*AB*AC)));
+        angleB =  toDegreesT(acos((AB*AB + BC*BC - AC*AC) / (2*AB*BC)));
+        angleC =  toDegreesT(acos((BC*BC + AC*AC - AB*AB) / (2*BC*AC)));
+        median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+        inRadius = Area / semiPerimeter;
+        median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+        BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+        HeightAH= 2*Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+
+    } else if (median_BM > 0 && AB > 0 && AC > 0) {
+        BC = sqrt(2 * square(AB) + 2 * square(AC) - 4 * square(median_BM));
+        T semiPerimeter = (AB + AC + BC) / 2;
+        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
+        circumRadius = (AB * BC * AC) / (4 * Area);
+        angleA =  toDegreesT(acos((AB*AB + AC*AC - BC*BC) / (2*AB*AC)));
+        angleB =  toDegreesT(acos((AB*AB + BC*BC - AC*AC) / (2*AB*BC)));
+        angleC =  toDegreesT(acos((BC*BC + AC*AC - AB*AB) / (2*BC*AC)));
+        inRadius = Area / semiPerimeter;
+        median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+        inRadius = Area / semiPerimeter;
+        median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+        BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+        HeightAH= 2*Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+
+    } else if (median_CM > 0 && AC > 0 && BC > 0) {
+        AB = sqrt((2* square(AC) + 2 * square(BC) - 4*square(median_CM)));
+        T semiPerimeter = (AB + AC + BC) / 2;
+        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
+        circumRadius = (AB * BC * AC) / (4 * Area);
+        angleA =  toDegreesT(acos((AB*AB + AC*AC - BC*BC) / (2*AB*AC)));
+        angleB =  toDegreesT(acos((AB*AB + BC*BC - AC*AC) / (2*AB*BC)));
+        angleC =  toDegreesT(acos((BC*BC + AC*AC - AB*AB) / (2*BC*AC)));
+        median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+        median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+        inRadius = Area / semiPerimeter;
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+        BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+        HeightAH= 2*Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+
+
+    } else if (median_CM > 0 && AB > 0 && BC > 0) {
+        AC = sqrt((4 * square(median_CM) - 2 * square(BC) + square(AB)) / 2);
+        T semiPerimeter = (AB + AC + BC) / 2;
+        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
+        circumRadius = (AB * BC * AC) / (4 * Area);
+        auto [A, B, C] = calculate_3AnglesT(AB, AC, BC);
+        angleA=A;
+        angleB=B;
+        angleC=C;
+
+        median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+        median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+        inRadius = Area / semiPerimeter;
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+        BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+        HeightAH= 2*Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+
+
+    } else if (median_CM > 0 && AB > 0 && AC > 0) {
+        BC = sqrt(2 * square(AB) + 2 * square(AC) - 4 * square(median_CM));
+        T semiPerimeter = (AB + AC + BC) / 2;
+        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
+        circumRadius = (AB * BC * AC) / (4 * Area);
+        auto [A, B, C] = calculate_3AnglesT(AB, AC, BC);
+        angleA=A;
+        angleB=B;
+        angleC=C;
+
+        inRadius = Area / semiPerimeter;
+        median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+        median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+        BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+        HeightAH= 2*Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+
+    }
+    //BIsector begin here
+    else if(BisectorA >0 && AC>0 &&AB>0){
+        BC = sqrt((AB*AC-square(BisectorA)) *square(AB+AC)/(AB*AC));
+
+        // Corrected formula for BisectorB
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+
+        // Corrected formula for BisectorC
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+
+        T semiPerimeter = (AB + AC + BC) / 2;
+        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
+
+// Calculate the circumradius
+        circumRadius = (AB * BC * AC) / (4 * Area);
+        auto [A, B, C] = calculate_3AnglesT(AB, AC, BC);
+        angleA=A;
+        angleB=B;
+        angleC=C;
+
+
+// Calculate the inradius
+        inRadius = Area / semiPerimeter;
+        median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+        median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+        median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+        HeightAH= 2*Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+
+    }
+    else if(BisectorA >0 && AB>0 && BC>0){
+
+        T denominator = (4 * square(BisectorA) - square(AB + BC));
+        AC = (AB * BC * (AB + BC)) / denominator;
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+
+        // Corrected formula for BisectorC
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+        T semiPerimeter = (AB + AC + BC) / 2;
+        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
+
+        // Calculate the circumradius
+        circumRadius = (AB * BC * AC) / (4 * Area);
+        auto [A, B, C] = calculate_3AnglesT(AB, AC, BC);
+        angleA=A;
+        angleB=B;
+        angleC=C;
+
+
+        // Calculate the inradius
+        inRadius = Area / semiPerimeter;
+        median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+        median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+        median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+        HeightAH= 2*Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+    }
+    else if (BisectorA > 0 && AC > 0 && BC > 0){
+        T denominator = (4 * square(BisectorA) / square(AC + BC)) - 1;
+        AB = (AC * BC * (AC + BC)) / denominator;
+        BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+
+        // Corrected formula for BisectorC
+        BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+        T semiPerimeter = (AB + AC + BC) / 2;
+        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
+
+        // Calculate the circumradius
+        circumRadius = (AB * BC * AC) / (4 * Area);
+        auto [A, B, C] = calculate_3AnglesT(AB, AC, BC);
+        angleA=A;
+        angleB=B;
+        angleC=C;
+
+
+        // Calculate the inradius
+        inRadius = Area / semiPerimeter;
+        median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+        median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+        median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+        HeightAH= 2*Area/BC;
+        HeightBH=2*Area/AC;
+        HeightCH=2*Area/AB;
+    }
+    //Bisector B given
+        else if (BisectorB > 0 && AB > 0 && BC > 0){
+            AC = sqrt((AB*BC-square(BisectorB)) *square(AB+BC)/(AB*BC));
+            BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+
+            // Corrected formula for BisectorC
+            BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+            T semiPerimeter = (AB + AC + BC) / 2;
+            Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
+
+            // Calculate the circumradius
+            circumRadius = (AB * BC * AC) / (4 * Area);
+            auto [A, B, C] = calculate_3AnglesT(AB, AC, BC);
+            angleA=A;
+            angleB=B;
+            angleC=C;
+
+
+            // Calculate the inradius
+            inRadius = Area / semiPerimeter;
+            median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+            median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+            median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+            HeightAH= 2*Area/BC;
+            HeightBH=2*Area/AC;
+            HeightCH=2*Area/AB;
+    }
+        else if (BisectorB > 0 && AC > 0 && BC > 0){
+                T denominator = (4 * square(BisectorB) / square(AC + BC)) - 1;
+                AB = (AC * BC * (AC + BC)) / denominator;
+                BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+
+                // Corrected formula for BisectorC
+                BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+                T semiPerimeter = (AB + AC + BC) / 2;
+                Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
+
+                // Calculate the circumradius
+                circumRadius = (AB * BC * AC) / (4 * Area);
+                auto [A, B, C] = calculate_3AnglesT(AB, AC, BC);
+                angleA=A;
+                angleB=B;
+                angleC=C;
+
+
+                // Calculate the inradius
+                inRadius = Area / semiPerimeter;
+                median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+                median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+                median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+                HeightAH= 2*Area/BC;
+                HeightBH=2*Area/AC;
+                HeightCH=2*Area/AB;
+        }
+        //last second
+        else if (BisectorB > 0 && AB > 0 && AC > 0){
+            T denominator = (4 * square(BisectorB) / square(AC + AB)) - 1;
+            BC = (AC * AB * (AC + AB)) / denominator;
+            BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+
+            // Corrected formula for BisectorC
+            BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+            T semiPerimeter = (AB + AC + BC) / 2;
+            Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
+
+            // Calculate the circumradius
+            circumRadius = (AB * BC * AC) / (4 * Area);
+            auto [A, B, C] = calculate_3AnglesT(AB, AC, BC);
+            angleA=A;
+            angleB=B;
+            angleC=C;
+
+
+            // Calculate the inradius
+            inRadius = Area / semiPerimeter;
+            median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+            median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+            median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+            HeightAH=2* Area/BC;
+            HeightBH=2*Area/AC;
+            HeightCH=2*Area/AB;
+        }
+    //BisectorC given
+        else if (BisectorC > 0 && BC > 0 && AC > 0){
+            AB = sqrt((BC*AC-square(BisectorC)) *square(BC+AC)/(BC*AC));
+            BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+
+            // Corrected formula for BisectorC
+            BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+            T semiPerimeter = (AB + AC + BC) / 2;
+            Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
+
+            // Calculate the circumradius
+            circumRadius = (AB * BC * AC) / (4 * Area);
+            auto [A, B, C] = calculate_3AnglesT(AB, AC, BC);
+            angleA=A;
+            angleB=B;
+            angleC=C;
+
+
+            // Calculate the inradius
+            inRadius = Area / semiPerimeter;
+            median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+            median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+            median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+            HeightAH= 2*Area/BC;
+            HeightBH=2*Area/AC;
+            HeightCH=2*Area/AB;
+        }
+    //second
+        else if (BisectorC > 0 && AB > 0 && BC > 0){
+            T denominator = (4 * square(BisectorC) / square(AB + BC)) - 1;
+            AC = (AB * BC * (AB + BC)) / denominator;
+            BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+
+            // Corrected formula for BisectorC
+            BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+            T semiPerimeter = (AB + AC + BC) / 2;
+            Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
+
+            // Calculate the circumradius
+            circumRadius = (AB * BC * AC) / (4 * Area);
+            auto [A, B, C] = calculate_3AnglesT(AB, AC, BC);
+            angleA=A;
+            angleB=B;
+            angleC=C;
+
+
+            // Calculate the inradius
+            inRadius = Area / semiPerimeter;
+            median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+            median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+            median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+            HeightAH= 2*Area/BC;
+            HeightBH=2*Area/AC;
+            HeightCH=2*Area/AB;
+        }
+    //third
+        else if (BisectorC > 0 && AC > 0 && AB > 0){
+            T denominator = (4 * square(BisectorC) / square(AC + AB)) - 1;
+            BC = (AC * AB * (AC + AB)) / denominator;
+            BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+
+            // Corrected formula for BisectorC
+            BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+            T semiPerimeter = (AB + AC + BC) / 2;
+            Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
+
+            // Calculate the circumradius
+            circumRadius = (AB * BC * AC) / (4 * Area);
+            auto [A, B, C] = calculate_3AnglesT(AB, AC, BC);
+            angleA=A;
+            angleB=B;
+            angleC=C;
+
+
+            // Calculate the inradius
+            inRadius = Area / semiPerimeter;
+            median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+            median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+            median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+            HeightAH=2* Area/BC;
+            HeightBH=2*Area/AC;
+            HeightCH=2*Area/AB;
+        }
+        //knowing 1bisector 1side 1 angle find another
+        //angleA handle
+        else if(angleA >0 && AC>0 &&BisectorA>0){
+            AB=(-BisectorA*AC)/(BisectorA-2*AC*cosDegreesT(angleA/2));
+            // Calculate BC using the Law of Cosines
+            BC = sqrt(AB * AB + AC * AC - 2 * AB * AC * cosDegreesT(angleA));
+
+            // Calculate angleB using the Law of Sines
+            angleB = toDegreesT(asin(AC * sinDegreesT(angleA) / BC));
+
+            // Calculate angleC
+            angleC = T(180) - angleA - angleB;
+
+            // Calculate Area
+            Area = T(0.5) * AB * AC * sinDegreesT(angleA);
+
+            // Calculate the circumradius
+            circumRadius = (AB * BC * AC) / (4 * Area);
+
+            // Calculate the inradius
+            T semiPerimeter = (AB + BC + AC) / 2;
+            inRadius = Area / semiPerimeter;
+            median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+            median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+            median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+            BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+
+            // Corrected formula for BisectorC
+            BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+            HeightAH= 2*Area/BC;
+            HeightBH=2*Area/AC;
+            HeightCH=2*Area/AB;
+
+        }
+        //second
+        else if (angleA>0 && AB>0 && BisectorA>0){
+            AC=(-BisectorA*AB)/(BisectorA-2*AB*cosDegreesT(angleA/2));
+            // Calculate BC using the Law of Cosines
+            BC = sqrt(AB * AB + AC * AC - 2 * AB * AC * cosDegreesT(angleA));
+
+            // Calculate angleB using the Law of Sines
+            angleB = toDegreesT(asin(AC * sinDegreesT(angleA) / BC));
+
+            // Calculate angleC
+            angleC = T(180) - angleA - angleB;
+
+            // Calculate Area
+            Area = T(0.5) * AB * AC * sinDegreesT(angleA);
+
+            // Calculate the circumradius
+            circumRadius = (AB * BC * AC) / (4 * Area);
+
+            // Calculate the inradius
+            T semiPerimeter = (AB + BC + AC) / 2;
+            inRadius = Area / semiPerimeter;
+            median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+            median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+            median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+            BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+
+            // Corrected formula for BisectorC
+            BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+            HeightAH= 2*Area/BC;
+            HeightBH=2*Area/AC;
+            HeightCH=2*Area/AB;
+
+
+        }
+        //handle angleB
+        else if(angleB>0 && BC>0 && BisectorB>0){
+            AB=(-BisectorB*BC)/(BisectorB-2*BC*cosDegreesT(angleB/2));
+            // Calculate BC using the Law of Cosines
+            AC = sqrt(AB * AB + BC * BC - 2 * AB * BC * cosDegreesT(angleB));
+
+            // Calculate angleA using the Law of Sines
+            angleA = toDegreesT(asin(AB * sinDegreesT(angleB) / AC));
+
+            // Calculate angleC
+            angleC = T(180) - angleA - angleB;
+
+            // Calculate Area
+            Area = T(0.5) * AB * BC * sinDegreesT(angleB);
+
+            // Calculate the circumradius
+            circumRadius = (AB * BC * AC) / (4 * Area);
+
+            // Calculate the inradius
+            T semiPerimeter = (AB + BC + AC) / 2;
+            inRadius = Area / semiPerimeter;
+            median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+            median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+            median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+            BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+
+            // Corrected formula for BisectorC
+            BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+            HeightAH= 2*Area/BC;
+            HeightBH=2*Area/AC;
+            HeightCH=2*Area/AB;
+
+        }
+        else if(angleB>0 && AB>0 && BisectorB>0){
+            BC=(-BisectorB*AB)/(BisectorB-2*AB*cosDegreesT(angleB/2));
+            // Calculate BC using the Law of Cosines
+            AC = sqrt(AB * AB + BC * BC - 2 * AB * BC * cosDegreesT(angleB));
+
+            // Calculate angleA using the Law of Sines
+            angleA = toDegreesT(asin(AB * sinDegreesT(angleB) / AC));
+
+            // Calculate angleC
+            angleC = T(180) - angleA - angleB;
+
+            // Calculate Area
+            Area = T(0.5) * AB * BC * sinDegreesT(angleB);
+
+            // Calculate the circumradius
+            circumRadius = (AB * BC * AC) / (4 * Area);
+
+            // Calculate the inradius
+            T semiPerimeter = (AB + BC + AC) / 2;
+            inRadius = Area / semiPerimeter;
+            median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+            median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+            median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+            BisectorA = sqrt(AB * AC * (1 - square(BC) / square(AB + AC)));
+
+            // Corrected formula for BisectorC
+            BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+            HeightAH= 2*Area/BC;
+            HeightBH=2*Area/AC;
+            HeightCH=2*Area/AB;
+
+        }
+        //handle angleC
+        else if(angleC>0 && AC>0 && BisectorC>0){
+            BC=(-BisectorC*AC)/(BisectorC-2*AC*cosDegreesT(angleC/2));
+            AB = sqrt(AC * AC + BC * BC - 2 * AC * BC * cosDegreesT(angleC));
+
+            // Calculate angleA using the Law of Sines
+            angleA = toDegreesT(asin(BC * sinDegreesT(angleC) / AB));
+
+            // Calculate angleB
+            angleB = T(180) - angleA - angleC;
+
+            // Calculate Area
+            Area = T(0.5) * AC * BC * sinDegreesT(angleC);
+
+            // Calculate the circumradius
+            circumRadius = (AB * BC * AC) / (4 * Area);
+
+            // Calculate the inradius
+            T semiPerimeter = (AB + BC + AC) / 2;
+            inRadius = Area / semiPerimeter;
+            median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+            median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+            median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+            BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+
+            // Corrected formula for BisectorC
+            BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+            HeightAH= 2*Area/BC;
+            HeightBH=2*Area/AC;
+            HeightCH=2*Area/AB;
+
+        }
+        else if(angleC>0 && BC>0 && BisectorC>0){
+            AC=(-BisectorC*BC)/(BisectorC-2*BC*cosDegreesT(angleC/2));
+            AB = sqrt(AC * AC + BC * BC - 2 * AC * BC * cosDegreesT(angleC));
+
+            // Calculate angleA using the Law of Sines
+            angleA = toDegreesT(asin(BC * sinDegreesT(angleC) / AB));
+
+            // Calculate angleB
+            angleB = T(180) - angleA - angleC;
+
+            // Calculate Area
+            Area = T(0.5) * AC * BC * sinDegreesT(angleC);
+
+            // Calculate the circumradius
+            circumRadius = (AB * BC * AC) / (4 * Area);
+
+            // Calculate the inradius
+            T semiPerimeter = (AB + BC + AC) / 2;
+            inRadius = Area / semiPerimeter;
+            median_AM=T(0.5)*sqrt(2*square(AB)+2*square(AC)-square(BC));
+            median_BM=T(0.5)*sqrt(2*square(AB)+2*square(BC)-square(AC));
+            median_CM=T(0.5)*sqrt(2*square(BC)+2*square(AC)-square(AB));
+            BisectorB = sqrt(AB * BC * (1 - square(AC) / square(AB + BC)));
+
+            // Corrected formula for BisectorC
+            BisectorC = sqrt(AC * BC * (1 - square(AB) / square(AC + BC)));
+            HeightAH=2* Area/BC;
+            HeightBH=2*Area/AC;
+            HeightCH=2*Area/AB;
+
+
+        }
+}
+
+#endif // TRIANGLECORET_H
@@ -6,7 +6,18 @@
 #include <cmath>
 #include <tuple>
 #include <QMessageBox>
+#include <QHeaderView>
+#include <QFileDialog>
+#include <QClipboard>
+#include <bitset>
+#include <limits>
 #include "triangleSolver.h"
+#include "triangleCore.h"
+#include "feasibility.h"
+#include "reconcile.h"
+#include "solveHistoryModel.h"
+#include "csvImportWorker.h"
+#include "triangleCanvas.h"
 #include "ui_mainwindow.h"
 #include <vector>
 
@@ -14,6 +25,8 @@
 MathHelper::MathHelper(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MathHelper)
+    , historyModel(new SolveHistoryModel(this))
+    , importWorker(new CsvImportWorker)
 {
     ui->setupUi(this);
     //
@@ -42,6 +55,41 @@ MathHelper::MathHelper(QWidget *parent)
         {ui->lineEdit_AC, ui->lineEdit_angleC, ui->lineEdit_CM,ui ->lineEdit_BiC},
         {ui->lineEdit_Ha,ui->lineEdit_Hb , ui->lineEdit_Hc,ui->lineEdit_Area}
     };
+    resultEdits = {
+        ui->lineEdit_AB_result, ui->lineEdit_AC_result, ui->lineEdit_BC_result,
+        ui->lineEdit_angleA_result, ui->lineEdit_angleB_result, ui->lineEdit_angleC_result,
+        ui->lineEdit_AM_result, ui->lineEdit_BM_result, ui->lineEdit_CM_result, ui->lineEdit_Area_result,
+        ui->lineEdit_BiA_result, ui->lineEdit_BiB_result, ui->lineEdit_BiC_result,
+        ui->lineEdit_Ha_result, ui->lineEdit_Hb_result, ui->lineEdit_Hc_result,
+        ui->lineEdit_inRadius_result, ui->lineEdit_circumRadius_result
+    };
+    // Dragging the canvas re-solves live; only a finished drag goes to the history
+    connect(ui->canvas_triangle, &TriangleCanvas::triangleChanged, this, &MathHelper::canvasChanged);
+    connect(ui->canvas_triangle, &TriangleCanvas::dragFinished, this, &MathHelper::canvasDragFinished);
+    // Every solve is appended to the history table
+    ui->tableView_history->setModel(historyModel);
+    ui->tableView_history->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    ui->tableView_history->verticalHeader()->setDefaultSectionSize(20);
+    ui->tableView_history->horizontalHeader()->setDefaultSectionSize(80);
+    for (int field = 0; field < FieldCount; field++) {
+        ui->comboBox_filterColumn->addItem(kTriangleFieldNames[field]);
+    }
+    connect(ui->btnFilter, &QPushButton::clicked, this, &MathHelper::applyHistoryFilter);
+    connect(ui->btnClearHistory, &QPushButton::clicked, this, &MathHelper::clearHistory);
+    // CSV imports are solved on a worker thread and stream into the history table
+    qRegisterMetaType<QVector<TriangleValues>>("QVector<TriangleValues>");
+    importWorker->moveToThread(&importThread);
+    connect(&importThread, &QThread::finished, importWorker, &QObject::deleteLater);
+    connect(importWorker, &CsvImportWorker::rowsSolved, this, &MathHelper::importRowsSolved);
+    connect(importWorker, &CsvImportWorker::progress, this, &MathHelper::importProgress);
+    connect(importWorker, &CsvImportWorker::finished, this, &MathHelper::importFinished);
+    connect(importWorker, &CsvImportWorker::failed, this, &MathHelper::importFailed);
+    importThread.start();
+    connect(ui->btnImport, &QPushButton::clicked, this, &MathHelper::importCsvFile);
+    connect(ui->btnCancelImport, &QPushButton::clicked, this, &MathHelper::cancelImport);
+    QShortcut *pasteShortcut = new QShortcut(QKeySequence("Ctrl+Shift+V"), this);
+    connect(pasteShortcut, &QShortcut::activated, this, &MathHelper::importClipboard);
+    setImporting(false);
     //
     for (auto& row : lineEdits) {
         for (auto& lineEdit : row) {
@@ -54,6 +102,9 @@ MathHelper::MathHelper(QWidget *parent)
 
 MathHelper::~MathHelper()
 {
+    importWorker->cancel();
+    importThread.quit();
+    importThread.wait();
     delete ui;
 }
 bool MathHelper::eventFilter(QObject *obj, QEvent *event)
@@ -130,15 +181,6 @@ void MathHelper::moveRight(){
         lineEdits[y][newX]->setFocus();
     }
 }
-const double PI = 3.14159265358979323846;
-double toRadians(double degree) {
-    return degree * (PI / 180.0);
-}
-
-double toDegrees(double radian) {
-    return radian * (180.0 / PI);
-}
-
 
 
 void MathHelper::on_btnSolve_clicked() {
@@ -161,15 +203,16 @@ void MathHelper::on_btnSolve_clicked() {
     };
 
     // Define the validation lambda function
-    auto validateInput = [&](QLineEdit* lineEdit, const QString& fieldName) -> bool {
+    // fieldName stays a plain C string so the message is only built when a field is invalid
+    auto validateInput = [&](QLineEdit* lineEdit, const char* fieldName) -> bool {
         QString text = lineEdit->text();
         if (text.isEmpty()) {
             lineEdit->setText("0");
             return true; // Consider empty input as valid and set to default value
         }
-        double value = lineEdit->text().toDouble(&ok);
+        text.toDouble(&ok);
         if (!ok) {
-            errorMessage = "Please enter a number for " + fieldName + ".";
+            errorMessage = "Please enter a number for " + QString::fromLatin1(fieldName) + ".";
             ui->lineEdit_Error->setText(errorMessage);
             return false; // Indicate invalid input
         }
@@ -220,1000 +263,88 @@ void MathHelper::on_btnSolve_clicked() {
 
     calculateMissingValues(AB, AC, BC, angleA, angleB, angleC, median_AM, median_BM, median_CM, Area,BisectorA,BisectorB,BisectorC,HeightAH,HeightBH,HeightCH);
 }
-std::tuple<double, double, double> calculate_3Angles(double AB, double AC, double BC) {
-    double angleA = toDegrees(acos((AB * AB + AC * AC - BC * BC) / (2 * AB * AC)));
-    double angleB = toDegrees(acos((AB * AB + BC * BC - AC * AC) / (2 * AB * BC)));
-    double angleC = 180.0 - angleA - angleB; // Calculate angleC as the remaining angle
-
-    return std::make_tuple(angleA, angleB, angleC);
-}
 void MathHelper::calculateMissingValues(double AB, double AC, double BC, double angleA, double angleB, double angleC, double median_AM, double median_BM, double median_CM, double Area,double BisectorA,double BisectorB,double BisectorC,double HeightAH,
 
 double HeightBH,double HeightCH   ){
 
-    double inRadius=0;
-    double circumRadius=0  ;
-    if (AB > 0 && BC > 0 && angleB > 0) {
-        // Calculate AC using the Law of Cosines
-        AC = sqrt(AB * AB + BC * BC - 2 * AB * BC * cos(toRadians(angleB)));
-
-        // Calculate angleA using the Law of Sines
-        angleA = toDegrees(asin(AB * sin(toRadians(angleB)) / AC));
-
-        // Calculate angleC
-        angleC = 180.0 - angleA - angleB;
-
-        // Calculate Area
-        Area = 0.5 * AB * BC * sin(toRadians(angleB));
-
-        // Calculate the circumradius
-        circumRadius = (AB * BC * AC) / (4 * Area);
-
-        // Calculate the inradius
-        double semiPerimeter = (AB + BC + AC) / 2;
-        inRadius = Area / semiPerimeter;
-        median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-        median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-        median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-        BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-        HeightAH= 2*Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
-
-
-
-
-
-    } else if (AC > 0 && BC > 0 && angleC > 0) {
-        // Calculate AB using the Law of Cosines
-        AB = sqrt(AC * AC + BC * BC - 2 * AC * BC * cos(toRadians(angleC)));
-
-        // Calculate angleA using the Law of Sines
-        angleA = toDegrees(asin(BC * sin(toRadians(angleC)) / AB));
-
-        // Calculate angleB
-        angleB = 180.0 - angleA - angleC;
-
-        // Calculate Area
-        Area = 0.5 * AC * BC * sin(toRadians(angleC));
-
-        // Calculate the circumradius
-        circumRadius = (AB * BC * AC) / (4 * Area);
-
-        // Calculate the inradius
-        double semiPerimeter = (AB + BC + AC) / 2;
-        inRadius = Area / semiPerimeter;
-        median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-        median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-        median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-        BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-        HeightAH= 2*Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
-
-
-
-    } else if (AB > 0 && AC > 0 && angleA > 0) {
-        // Calculate BC using the Law of Cosines
-        BC = sqrt(AB * AB + AC * AC - 2 * AB * AC * cos(toRadians(angleA)));
-
-        // Calculate angleB using the Law of Sines
-        angleB = toDegrees(asin(AC * sin(toRadians(angleA)) / BC));
-
-        // Calculate angleC
-        angleC = 180.0 - angleA - angleB;
-
-        // Calculate Area
-        Area = 0.5 * AB * AC * sin(toRadians(angleA));
-
-        // Calculate the circumradius
-        circumRadius = (AB * BC * AC) / (4 * Area);
-
-        // Calculate the inradius
-        double semiPerimeter = (AB + BC + AC) / 2;
-        inRadius = Area / semiPerimeter;
-        median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-        median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-        median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-        BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-        HeightAH= 2*Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
-
-
-
-    } else if (AB > 0 && AC > 0 && Area > 0) {
-        double Sin = Area / (0.5 * AB * AC);
-        double final_sin = asin(Sin);
-        angleA = toDegrees(final_sin);
-        BC = sqrt(AB * AB + AC * AC - 2 * AB * AC * cos(toRadians(angleA)));
-
-        // Calculate angleB using the Law of Sines
-        angleB = toDegrees(asin(AC * sin(toRadians(angleA)) / BC));
-
-        // Calculate angleC
-        angleC = 180.0 - angleA - angleB;
-
-        // Calculate the circumradius
-        circumRadius = (AB * BC * AC) / (4 * Area);
-
-        // Calculate the inradius
-        double semiPerimeter = (AB + BC + AC) / 2;
-        inRadius = Area / semiPerimeter;
-        median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-        median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-        median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-        BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-        HeightAH= 2*Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
-
-
-    } else if (AC > 0 && BC > 0 && Area > 0) {
-        double Sin1 = Area / (0.5 * AC * BC);
-        double final_sin1 = asin(Sin1);
-        angleC = toDegrees(final_sin1);
-
-        // Calculate angleA using the Law of Sines
-        angleA = toDegrees(asin(BC * sin(toRadians(angleC)) / AC));
-
-        // Calculate angleB
-        angleB = 180.0 - angleA - angleC;
-
-        // Calculate the circumradius
-        circumRadius = (AB * BC * AC) / (4 * Area);
-
-        // Calculate the inradius
-        double semiPerimeter = (AB + BC + AC) / 2;
-        inRadius = Area / semiPerimeter;
-        median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-        median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-        median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-        BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-        HeightAH= 2*Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
-
-
-
-    } else if (AB > 0 && BC > 0 && Area > 0) {
-        double Sin2 = Area / (0.5 * AB * BC);
-        double final_sin2 = asin(Sin2);
-        angleB = toDegrees(final_sin2);
-
-        angleA = toDegrees(asin(AB * sin(toRadians(angleB)) / BC));
-
-        // Calculate angleC
-        angleC = 180.0 - angleA - angleB;
-
-        // Calculate the circumradius
-        circumRadius = (AB * BC * AC) / (4 * Area);
-
-        // Calculate the inradius
-        double semiPerimeter = (AB + BC + AC) / 2;
-        inRadius = Area / semiPerimeter;
-        median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-        median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-        median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-        BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-        HeightAH= 2*Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
-
-
-
-    } else if (angleA > 0 && angleB > 0) {
-        angleC = 180 - angleA - angleB;
-        if (AC > 0) {
-            BC = AC * sin(toRadians(angleA)) / sin(toRadians(angleB));
-        } else if (BC > 0) {
-            AC = BC * sin(toRadians(angleB)) / sin(toRadians(angleA));
+    TriangleValues values;
+    values.AB = AB;
+    values.AC = AC;
+    values.BC = BC;
+    values.angleA = angleA;
+    values.angleB = angleB;
+    values.angleC = angleC;
+    values.median_AM = median_AM;
+    values.median_BM = median_BM;
+    values.median_CM = median_CM;
+    values.Area = Area;
+    values.BisectorA = BisectorA;
+    values.BisectorB = BisectorB;
+    values.BisectorC = BisectorC;
+    values.HeightAH = HeightAH;
+    values.HeightBH = HeightBH;
+    values.HeightCH = HeightCH;
+
+    // More knowns than a triangle needs: fit all of them by least squares
+    // instead of letting the first matching branch ignore the rest.
+    ReconcileResult fitted;
+    if (std::bitset<InputFieldCount>(knownMask(values)).count() > 3 && reconcileTriangle(values, nullptr, fitted)) {
+        values = fitted.values;
+        ui->lineEdit_Error->setText(QString("Least-squares fit of %1 inputs, rms residual %2%")
+                                        .arg(fitted.knowns).arg(fitted.rms * 100, 0, 'g', 3));
+    } else {
+        if (uint32_t reasons = checkFeasibility(values)) {
+            ui->lineEdit_Error->setText(QString::fromLatin1(feasibilityReasonText(reasons)));
+            return;
         }
-        AB = sqrt(AC * AC + BC * BC - 2 * AC * BC * cos(toRadians(angleC)));
-
-        Area = 0.5 * AB * AC * sin(toRadians(angleA));
-
-        // Calculate the circumradius
-        circumRadius = (AB * BC * AC) / (4 * Area);
-
-        // Calculate the inradius
-        double semiPerimeter = (AB + BC + AC) / 2;
-        inRadius = Area / semiPerimeter;
-        median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-        median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-        median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-        BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-        HeightAH= 2*Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
-
-
-
-    } else if (angleA > 0 && angleC > 0) {
-        angleB = 180 - angleA - angleC;
-        if (AB > 0) {
-            BC = AB * sin(toRadians(angleA)) / sin(toRadians(angleC));
-        } else if (BC > 0) {
-            AB = BC * sin(toRadians(angleC)) / sin(toRadians(angleA));
-        }
-        AC = sqrt(AB * AB + BC * BC - 2 * AB * BC * cos(toRadians(angleB)));
-        Area = 0.5 * AB * AC * sin(toRadians(angleA));
-
-        // Calculate the circumradius
-        circumRadius = (AB * BC * AC) / (4 * Area);
-
-        // Calculate the inradius
-        double semiPerimeter = (AB + BC + AC) / 2;
-        inRadius = Area / semiPerimeter;
-        median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-        median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-        median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-        BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-        HeightAH= 2*Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
-
-
-
-    } else if (angleB > 0 && angleC > 0) {
-        angleA = 180 - angleB - angleC;
-        if (AB > 0) {
-            AC = AB * sin(toRadians(angleB)) / sin(toRadians(angleC));
-        } else if (AC > 0) {
-            AB = AC * sin(toRadians(angleC)) / sin(toRadians(angleB));
-        }
-        BC = sqrt(AB * AB + AC * AC - 2 * AB * AC * cos(toRadians(angleA)));
-        Area = 0.5 * AB * AC * sin(toRadians(angleA));
-
-        // Calculate the circumradius
-        circumRadius = (AB * BC * AC) / (4 * Area);
-
-        // Calculate the inradius
-        double semiPerimeter = (AB + BC + AC) / 2;
-        inRadius = Area / semiPerimeter;
-        median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-        median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-        median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-        BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-        HeightAH= 2*Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
-
-
-
-    } else if (AB > 0 && AC > 0 && BC > 0) {
-        double semiPerimeter = (AB + AC + BC) / 2;
-        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
-
-        // Calculate the circumradius
-        circumRadius = (AB * BC * AC) / (4 * Area);
-        auto [A, B, C] = calculate_3Angles(AB, AC, BC);
-        angleA=A;
-        angleB=B;
-        angleC=C;
-
-
-        // Calculate the inradius
-        inRadius = Area / semiPerimeter;
-        median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-        median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-        median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-        BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-        HeightAH=2* Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
-
-
-    }
-    else if(median_AM>0 && AB>0 && AC>0){
-        BC=sqrt(2*pow(AB,2)+2*pow(AC,2)-4*pow(median_AM,2));
-        double semiPerimeter = (AB + AC + BC) / 2;
-        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
-
-        // Calculate the circumradius
-        circumRadius = (AB * BC * AC) / (4 * Area);
-        angleA =  toDegrees(acos((AB*AB + AC*AC - BC*BC) / (2*AB*AC)));
-        angleB =  toDegrees(acos((AB*AB + BC*BC - AC*AC) / (2*AB*BC)));
-        angleC =  toDegrees(acos((BC*BC + AC*AC - AB*AB) / (2*BC*AC)));
-
-        // Calculate the inradius
-        inRadius = Area / semiPerimeter;
-
-        median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-        median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-        BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-        HeightAH= 2*Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
-
-    }
-    else if(median_AM>0 && AB>0 && BC>0){
-        AC=sqrt((4*pow(median_AM,2)-2*pow(AB,2)+pow(BC,2))/2);
-        double semiPerimeter = (AB + AC + BC) / 2;
-        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
-
-        // Calculate the circumradius
-        circumRadius = (AB * BC * AC) / (4 * Area);
-        angleA =  toDegrees(acos((AB*AB + AC*AC - BC*BC) / (2*AB*AC)));
-        angleB =  toDegrees(acos((AB*AB + BC*BC - AC*AC) / (2*AB*BC)));
-        angleC =  toDegrees(acos((BC*BC + AC*AC - AB*AB) / (2*BC*AC)));
-
-        median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-        median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-        inRadius = Area / semiPerimeter;
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-        BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-        HeightAH= 2*Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
-
-
-
-    }
-    else if(median_AM>0 && AC>0 && BC>0){
-        AB=sqrt((4*pow(median_AM,2)-2*pow(AC,2)+pow(BC,2)/2));
-        double semiPerimeter = (AB + AC + BC) / 2;
-        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
-
-        // Calculate the circumradius
-        circumRadius = (AB * BC * AC) / (4 * Area);
-        angleA =  toDegrees(acos((AB*AB + AC*AC - BC*BC) / (2*AB*AC)));
-        angleB =  toDegrees(acos((AB*AB + BC*BC - AC*AC) / (2*AB*BC)));
-        angleC =  toDegrees(acos((BC*BC + AC*AC - AB*AB) / (2*BC*AC)));
-        inRadius = Area / semiPerimeter;
-        median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-        median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-        BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-        HeightAH= 2*Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
-
-
-    }
-    else if (median_BM > 0 && AB > 0 && BC > 0) {
-        AC = sqrt(2*pow(AB,2)+2*pow(BC,2)-4*pow(median_BM,2));
-        double semiPerimeter = (AB + AC + BC) / 2;
-        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
-        circumRadius = (AB * BC * AC) / (4 * Area);
-        angleA =  toDegrees(acos((AB*AB + AC*AC - BC*BC) / (2*AB*AC)));
-        angleB =  toDegrees(acos((AB*AB + BC*BC - AC*AC) / (2*AB*BC)));
-        angleC =  toDegrees(acos((BC*BC + AC*AC - AB*AB) / (2*BC*AC)));
-        median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-        inRadius = Area / semiPerimeter;
-        median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-        BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-        HeightAH= 2*Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
-
-
-    } else if (median_BM > 0 && AC > 0 && BC > 0) {
-        AB = sqrt((4 * pow(median_BM, 2) - 2 * pow(BC, 2) + pow(AC, 2)) / 2);
-        double semiPerimeter = (AB + AC + BC) / 2;
-        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
-        circumRadius = (AB * BC * AC) / (4 * Area);
-        angleA =  toDegrees(acos((AB*AB + AC*AC - BC*BC) / (2*AB*AC)));
-        angleB =  toDegrees(acos((AB*AB + BC*BC - AC*AC) / (2*AB*BC)));
-        angleC =  toDegrees(acos((BC*BC + AC*AC - AB*AB) / (2*BC*AC)));
-        median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-        inRadius = Area / semiPerimeter;
-        median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-        BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-        HeightAH= 2*Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
-
-    } else if (median_BM > 0 && AB > 0 && AC > 0) {
-        BC = sqrt(2 * pow(AB, 2) + 2 * pow(AC, 2) - 4 * pow(median_BM, 2));
-        double semiPerimeter = (AB + AC + BC) / 2;
-        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
-        circumRadius = (AB * BC * AC) / (4 * Area);
-        angleA =  toDegrees(acos((AB*AB + AC*AC - BC*BC) / (2*AB*AC)));
-        angleB =  toDegrees(acos((AB*AB + BC*BC - AC*AC) / (2*AB*BC)));
-        angleC =  toDegrees(acos((BC*BC + AC*AC - AB*AB) / (2*BC*AC)));
-        inRadius = Area / semiPerimeter;
-        median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-        inRadius = Area / semiPerimeter;
-        median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-        BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-        HeightAH= 2*Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
-
-    } else if (median_CM > 0 && AC > 0 && BC > 0) {
-        AB = sqrt((2* pow(AC, 2) + 2 * pow(BC, 2) - 4*pow(median_CM, 2)));
-        double semiPerimeter = (AB + AC + BC) / 2;
-        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
-        circumRadius = (AB * BC * AC) / (4 * Area);
-        angleA =  toDegrees(acos((AB*AB + AC*AC - BC*BC) / (2*AB*AC)));
-        angleB =  toDegrees(acos((AB*AB + BC*BC - AC*AC) / (2*AB*BC)));
-        angleC =  toDegrees(acos((BC*BC + AC*AC - AB*AB) / (2*BC*AC)));
-        median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-        median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-        inRadius = Area / semiPerimeter;
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-        BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-        HeightAH= 2*Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
-
-
-    } else if (median_CM > 0 && AB > 0 && BC > 0) {
-        AC = sqrt((4 * pow(median_CM, 2) - 2 * pow(BC, 2) + pow(AB, 2)) / 2);
-        double semiPerimeter = (AB + AC + BC) / 2;
-        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
-        circumRadius = (AB * BC * AC) / (4 * Area);
-        auto [A, B, C] = calculate_3Angles(AB, AC, BC);
-        angleA=A;
-        angleB=B;
-        angleC=C;
-
-        median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-        median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-        inRadius = Area / semiPerimeter;
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-        BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-        HeightAH= 2*Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
-
-
-    } else if (median_CM > 0 && AB > 0 && AC > 0) {
-        BC = sqrt(2 * pow(AB, 2) + 2 * pow(AC, 2) - 4 * pow(median_CM, 2));
-        double semiPerimeter = (AB + AC + BC) / 2;
-        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
-        circumRadius = (AB * BC * AC) / (4 * Area);
-        auto [A, B, C] = calculate_3Angles(AB, AC, BC);
-        angleA=A;
-        angleB=B;
-        angleC=C;
-
-        inRadius = Area / semiPerimeter;
-        median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-        median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-        BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-        HeightAH= 2*Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
-
-    }
-    //BIsector begin here
-    else if(BisectorA >0 && AC>0 &&AB>0){
-        BC = sqrt((AB*AC-pow(BisectorA,2)) *pow(AB+AC,2)/(AB*AC));
-
-        // Corrected formula for BisectorB
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-
-        // Corrected formula for BisectorC
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-
-        double semiPerimeter = (AB + AC + BC) / 2;
-        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
-
-// Calculate the circumradius
-        circumRadius = (AB * BC * AC) / (4 * Area);
-        auto [A, B, C] = calculate_3Angles(AB, AC, BC);
-        angleA=A;
-        angleB=B;
-        angleC=C;
-
-
-// Calculate the inradius
-        inRadius = Area / semiPerimeter;
-        median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-        median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-        median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-        HeightAH= 2*Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
-
-    }
-    else if(BisectorA >0 && AB>0 && BC>0){
-
-        double denominator = (4 * pow(BisectorA, 2) - pow(AB + BC, 2));
-        AC = (AB * BC * (AB + BC)) / denominator;
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-
-        // Corrected formula for BisectorC
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-        double semiPerimeter = (AB + AC + BC) / 2;
-        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
-
-        // Calculate the circumradius
-        circumRadius = (AB * BC * AC) / (4 * Area);
-        auto [A, B, C] = calculate_3Angles(AB, AC, BC);
-        angleA=A;
-        angleB=B;
-        angleC=C;
-
-
-        // Calculate the inradius
-        inRadius = Area / semiPerimeter;
-        median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-        median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-        median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-        HeightAH= 2*Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
-    }
-    else if (BisectorA > 0 && AC > 0 && BC > 0){
-        double denominator = (4 * pow(BisectorA, 2) / pow(AC + BC, 2)) - 1;
-        AB = (AC * BC * (AC + BC)) / denominator;
-        BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-
-        // Corrected formula for BisectorC
-        BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-        double semiPerimeter = (AB + AC + BC) / 2;
-        Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
-
-        // Calculate the circumradius
-        circumRadius = (AB * BC * AC) / (4 * Area);
-        auto [A, B, C] = calculate_3Angles(AB, AC, BC);
-        angleA=A;
-        angleB=B;
-        angleC=C;
-
-
-        // Calculate the inradius
-        inRadius = Area / semiPerimeter;
-        median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-        median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-        median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-        HeightAH= 2*Area/BC;
-        HeightBH=2*Area/AC;
-        HeightCH=2*Area/AB;
+        ui->lineEdit_Error->clear();
+        solveTriangle(values);
     }
-    //Bisector B given
-        else if (BisectorB > 0 && AB > 0 && BC > 0){
-            AC = sqrt((AB*BC-pow(BisectorB,2)) *pow(AB+BC,2)/(AB*BC));
-            BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-
-            // Corrected formula for BisectorC
-            BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-            double semiPerimeter = (AB + AC + BC) / 2;
-            Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
-
-            // Calculate the circumradius
-            circumRadius = (AB * BC * AC) / (4 * Area);
-            auto [A, B, C] = calculate_3Angles(AB, AC, BC);
-            angleA=A;
-            angleB=B;
-            angleC=C;
-
-
-            // Calculate the inradius
-            inRadius = Area / semiPerimeter;
-            median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-            median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-            median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-            HeightAH= 2*Area/BC;
-            HeightBH=2*Area/AC;
-            HeightCH=2*Area/AB;
-    }
-        else if (BisectorB > 0 && AC > 0 && BC > 0){
-                double denominator = (4 * pow(BisectorB, 2) / pow(AC + BC, 2)) - 1;
-                AB = (AC * BC * (AC + BC)) / denominator;
-                BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-
-                // Corrected formula for BisectorC
-                BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-                double semiPerimeter = (AB + AC + BC) / 2;
-                Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
-
-                // Calculate the circumradius
-                circumRadius = (AB * BC * AC) / (4 * Area);
-                auto [A, B, C] = calculate_3Angles(AB, AC, BC);
-                angleA=A;
-                angleB=B;
-                angleC=C;
-
-
-                // Calculate the inradius
-                inRadius = Area / semiPerimeter;
-                median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-                median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-                median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-                HeightAH= 2*Area/BC;
-                HeightBH=2*Area/AC;
-                HeightCH=2*Area/AB;
-        }
-        //last second
-        else if (BisectorB > 0 && AB > 0 && AC > 0){
-            double denominator = (4 * pow(BisectorB, 2) / pow(AC + AB, 2)) - 1;
-            BC = (AC * AB * (AC + AB)) / denominator;
-            BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-
-            // Corrected formula for BisectorC
-            BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-            double semiPerimeter = (AB + AC + BC) / 2;
-            Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
-
-            // Calculate the circumradius
-            circumRadius = (AB * BC * AC) / (4 * Area);
-            auto [A, B, C] = calculate_3Angles(AB, AC, BC);
-            angleA=A;
-            angleB=B;
-            angleC=C;
-
-
-            // Calculate the inradius
-            inRadius = Area / semiPerimeter;
-            median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-            median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-            median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-            HeightAH=2* Area/BC;
-            HeightBH=2*Area/AC;
-            HeightCH=2*Area/AB;
-        }
-    //BisectorC given
-        else if (BisectorC > 0 && BC > 0 && AC > 0){
-            AB = sqrt((BC*AC-pow(BisectorC,2)) *pow(BC+AC,2)/(BC*AC));
-            BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-
-            // Corrected formula for BisectorC
-            BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-            double semiPerimeter = (AB + AC + BC) / 2;
-            Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
-
-            // Calculate the circumradius
-            circumRadius = (AB * BC * AC) / (4 * Area);
-            auto [A, B, C] = calculate_3Angles(AB, AC, BC);
-            angleA=A;
-            angleB=B;
-            angleC=C;
-
-
-            // Calculate the inradius
-            inRadius = Area / semiPerimeter;
-            median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-            median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-            median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-            HeightAH= 2*Area/BC;
-            HeightBH=2*Area/AC;
-            HeightCH=2*Area/AB;
-        }
-    //second
-        else if (BisectorC > 0 && AB > 0 && BC > 0){
-            double denominator = (4 * pow(BisectorC, 2) / pow(AB + BC, 2)) - 1;
-            AC = (AB * BC * (AB + BC)) / denominator;
-            BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-
-            // Corrected formula for BisectorC
-            BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-            double semiPerimeter = (AB + AC + BC) / 2;
-            Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
-
-            // Calculate the circumradius
-            circumRadius = (AB * BC * AC) / (4 * Area);
-            auto [A, B, C] = calculate_3Angles(AB, AC, BC);
-            angleA=A;
-            angleB=B;
-            angleC=C;
-
-
-            // Calculate the inradius
-            inRadius = Area / semiPerimeter;
-            median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-            median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-            median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-            HeightAH= 2*Area/BC;
-            HeightBH=2*Area/AC;
-            HeightCH=2*Area/AB;
-        }
-    //third
-        else if (BisectorC > 0 && AC > 0 && AB > 0){
-            double denominator = (4 * pow(BisectorC, 2) / pow(AC + AB, 2)) - 1;
-            BC = (AC * AB * (AC + AB)) / denominator;
-            BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-
-            // Corrected formula for BisectorC
-            BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-            double semiPerimeter = (AB + AC + BC) / 2;
-            Area = sqrt(semiPerimeter * (semiPerimeter - AB) * (semiPerimeter - AC) * (semiPerimeter - BC));
-
-            // Calculate the circumradius
-            circumRadius = (AB * BC * AC) / (4 * Area);
-            auto [A, B, C] = calculate_3Angles(AB, AC, BC);
-            angleA=A;
-            angleB=B;
-            angleC=C;
-
-
-            // Calculate the inradius
-            inRadius = Area / semiPerimeter;
-            median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-            median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-            median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-            HeightAH=2* Area/BC;
-            HeightBH=2*Area/AC;
-            HeightCH=2*Area/AB;
-        }
-        //knowing 1bisector 1side 1 angle find another
-        //angleA handle
-        else if(angleA >0 && AC>0 &&BisectorA>0){
-            AB=(-BisectorA*AC)/(BisectorA-2*AC*cos(toRadians(angleA/2)));
-            // Calculate BC using the Law of Cosines
-            BC = sqrt(AB * AB + AC * AC - 2 * AB * AC * cos(toRadians(angleA)));
-
-            // Calculate angleB using the Law of Sines
-            angleB = toDegrees(asin(AC * sin(toRadians(angleA)) / BC));
-
-            // Calculate angleC
-            angleC = 180.0 - angleA - angleB;
-
-            // Calculate Area
-            Area = 0.5 * AB * AC * sin(toRadians(angleA));
-
-            // Calculate the circumradius
-            circumRadius = (AB * BC * AC) / (4 * Area);
-
-            // Calculate the inradius
-            double semiPerimeter = (AB + BC + AC) / 2;
-            inRadius = Area / semiPerimeter;
-            median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-            median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-            median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-            BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-
-            // Corrected formula for BisectorC
-            BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-            HeightAH= 2*Area/BC;
-            HeightBH=2*Area/AC;
-            HeightCH=2*Area/AB;
-
-        }
-        //second
-        else if (angleA>0 && AB>0 && BisectorA>0){
-            AC=(-BisectorA*AB)/(BisectorA-2*AB*cos(toRadians(angleA/2)));
-            // Calculate BC using the Law of Cosines
-            BC = sqrt(AB * AB + AC * AC - 2 * AB * AC * cos(toRadians(angleA)));
-
-            // Calculate angleB using the Law of Sines
-            angleB = toDegrees(asin(AC * sin(toRadians(angleA)) / BC));
-
-            // Calculate angleC
-            angleC = 180.0 - angleA - angleB;
-
-            // Calculate Area
-            Area = 0.5 * AB * AC * sin(toRadians(angleA));
-
-            // Calculate the circumradius
-            circumRadius = (AB * BC * AC) / (4 * Area);
-
-            // Calculate the inradius
-            double semiPerimeter = (AB + BC + AC) / 2;
-            inRadius = Area / semiPerimeter;
-            median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-            median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-            median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-            BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-
-            // Corrected formula for BisectorC
-            BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-            HeightAH= 2*Area/BC;
-            HeightBH=2*Area/AC;
-            HeightCH=2*Area/AB;
-
-
-        }
-        //handle angleB
-        else if(angleB>0 && BC>0 && BisectorB>0){
-            AB=(-BisectorB*BC)/(BisectorB-2*BC*cos(toRadians(angleB/2)));
-            // Calculate BC using the Law of Cosines
-            AC = sqrt(AB * AB + BC * BC - 2 * AB * BC * cos(toRadians(angleB)));
-
-            // Calculate angleA using the Law of Sines
-            angleA = toDegrees(asin(AB * sin(toRadians(angleB)) / AC));
-
-            // Calculate angleC
-            angleC = 180.0 - angleA - angleB;
-
-            // Calculate Area
-            Area = 0.5 * AB * BC * sin(toRadians(angleB));
-
-            // Calculate the circumradius
-            circumRadius = (AB * BC * AC) / (4 * Area);
-
-            // Calculate the inradius
-            double semiPerimeter = (AB + BC + AC) / 2;
-            inRadius = Area / semiPerimeter;
-            median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-            median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-            median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-            BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-
-            // Corrected formula for BisectorC
-            BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-            HeightAH= 2*Area/BC;
-            HeightBH=2*Area/AC;
-            HeightCH=2*Area/AB;
 
-        }
-        else if(angleB>0 && AB>0 && BisectorB>0){
-            BC=(-BisectorB*AB)/(BisectorB-2*AB*cos(toRadians(angleB/2)));
-            // Calculate BC using the Law of Cosines
-            AC = sqrt(AB * AB + BC * BC - 2 * AB * BC * cos(toRadians(angleB)));
-
-            // Calculate angleA using the Law of Sines
-            angleA = toDegrees(asin(AB * sin(toRadians(angleB)) / AC));
-
-            // Calculate angleC
-            angleC = 180.0 - angleA - angleB;
-
-            // Calculate Area
-            Area = 0.5 * AB * BC * sin(toRadians(angleB));
-
-            // Calculate the circumradius
-            circumRadius = (AB * BC * AC) / (4 * Area);
-
-            // Calculate the inradius
-            double semiPerimeter = (AB + BC + AC) / 2;
-            inRadius = Area / semiPerimeter;
-            median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-            median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-            median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-            BisectorA = sqrt(AB * AC * (1 - pow(BC, 2) / pow(AB + AC, 2)));
-
-            // Corrected formula for BisectorC
-            BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-            HeightAH= 2*Area/BC;
-            HeightBH=2*Area/AC;
-            HeightCH=2*Area/AB;
-
-        }
-        //handle angleC
-        else if(angleC>0 && AC>0 && BisectorC>0){
-            BC=(-BisectorC*AC)/(BisectorC-2*AC*cos(toRadians(angleC/2)));
-            AB = sqrt(AC * AC + BC * BC - 2 * AC * BC * cos(toRadians(angleC)));
-
-            // Calculate angleA using the Law of Sines
-            angleA = toDegrees(asin(BC * sin(toRadians(angleC)) / AB));
-
-            // Calculate angleB
-            angleB = 180.0 - angleA - angleC;
-
-            // Calculate Area
-            Area = 0.5 * AC * BC * sin(toRadians(angleC));
-
-            // Calculate the circumradius
-            circumRadius = (AB * BC * AC) / (4 * Area);
-
-            // Calculate the inradius
-            double semiPerimeter = (AB + BC + AC) / 2;
-            inRadius = Area / semiPerimeter;
-            median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-            median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-            median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-            BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
-
-            // Corrected formula for BisectorC
-            BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-            HeightAH= 2*Area/BC;
-            HeightBH=2*Area/AC;
-            HeightCH=2*Area/AB;
-
-        }
-        else if(angleC>0 && BC>0 && BisectorC>0){
-            AC=(-BisectorC*BC)/(BisectorC-2*BC*cos(toRadians(angleC/2)));
-            AB = sqrt(AC * AC + BC * BC - 2 * AC * BC * cos(toRadians(angleC)));
-
-            // Calculate angleA using the Law of Sines
-            angleA = toDegrees(asin(BC * sin(toRadians(angleC)) / AB));
-
-            // Calculate angleB
-            angleB = 180.0 - angleA - angleC;
-
-            // Calculate Area
-            Area = 0.5 * AC * BC * sin(toRadians(angleC));
-
-            // Calculate the circumradius
-            circumRadius = (AB * BC * AC) / (4 * Area);
+    // Output the calculated values
+    showResults(values, (1u << FieldCount) - 1);
+    ui->canvas_triangle->setTriangle(values);
 
-            // Calculate the inradius
-            double semiPerimeter = (AB + BC + AC) / 2;
-            inRadius = Area / semiPerimeter;
-            median_AM=0.5*sqrt(2*pow(AB,2)+2*pow(AC,2)-pow(BC,2));
-            median_BM=0.5*sqrt(2*pow(AB,2)+2*pow(BC,2)-pow(AC,2));
-            median_CM=0.5*sqrt(2*pow(BC,2)+2*pow(AC,2)-pow(AB,2));
-            BisectorB = sqrt(AB * BC * (1 - pow(AC, 2) / pow(AB + BC, 2)));
+    historyModel->append(values);
 
-            // Corrected formula for BisectorC
-            BisectorC = sqrt(AC * BC * (1 - pow(AB, 2) / pow(AC + BC, 2)));
-            HeightAH=2* Area/BC;
-            HeightBH=2*Area/AC;
-            HeightCH=2*Area/AB;
+    this->angleA = values.angleA;
+    this->angleB = values.angleB;
+    this->angleC = values.angleC;
 
+}
 
+void MathHelper::showResults(const TriangleValues &values, uint32_t fields){
+    for (int field = 0; field < FieldCount; field++) {
+        if (fields & (1u << field)) {
+            resultEdits[field]->setText(QString::number(fieldValue(values, field)));
         }
-
-
-
-
-
-
-
-
-
-    // Output the calculated values
-    ui->lineEdit_AB_result->setText(QString::number(AB));
-    ui->lineEdit_AC_result->setText(QString::number(AC));
-    ui->lineEdit_BC_result->setText(QString::number(BC));
-    ui->lineEdit_angleA_result->setText(QString::number(angleA));
-    ui->lineEdit_angleB_result->setText(QString::number(angleB));
-    ui->lineEdit_angleC_result->setText(QString::number(angleC));
-    ui->lineEdit_AM_result->setText(QString::number(median_AM));
-    ui->lineEdit_BM_result->setText(QString::number(median_BM));
-    ui->lineEdit_CM_result->setText(QString::number(median_CM));
-    ui->lineEdit_Area_result->setText(QString::number(Area));
-    ui->lineEdit_inRadius_result->setText(QString::number(inRadius));
-    ui->lineEdit_circumRadius_result->setText(QString::number(circumRadius));
-    ui->lineEdit_BiA_result->setText(QString::number(BisectorA));
-    ui->lineEdit_BiB_result->setText(QString::number(BisectorB));
-    ui->lineEdit_BiC_result->setText(QString::number(BisectorC));
-    ui->lineEdit_Ha_result->setText(QString::number(HeightAH));
-    ui->lineEdit_Hb_result->setText(QString::number(HeightBH));
-    ui->lineEdit_Hc_result->setText(QString::number(HeightCH));
-
-
-    this->angleA = angleA;
-    this->angleB = angleB;
-    this->angleC = angleC;
-
+    }
+}
+void MathHelper::canvasChanged(const TriangleValues &values, quint32 changedFields){
+    showResults(values, changedFields);
+}
+void MathHelper::canvasDragFinished(const TriangleValues &values){
+    ui->lineEdit_Error->clear();
+    historyModel->append(values);
+    angleA = values.angleA;
+    angleB = values.angleB;
+    angleC = values.angleC;
 }
 
 void MathHelper::convertAngle() {
-    double angleA_rad = toRadians(angleA);
-    double angleB_rad = toRadians(angleB);
-    double angleC_rad = toRadians(angleC);
-
-    double sinA = std::sin(angleA_rad);
-    double cosA = std::cos(angleA_rad);
-    double tanA = std::tan(angleA_rad);
+    double sinA = sinDegrees(angleA);
+    double cosA = cosDegrees(angleA);
+    double tanA = tanDegrees(angleA);
     double cotA = (tanA != 0) ? 1.0 / tanA : std::numeric_limits<double>::infinity();
 
-    double sinB = std::sin(angleB_rad);
-    double cosB = std::cos(angleB_rad);
-    double tanB = std::tan(angleB_rad);
+    double sinB = sinDegrees(angleB);
+    double cosB = cosDegrees(angleB);
+    double tanB = tanDegrees(angleB);
     double cotB = (tanB != 0) ? 1.0 / tanB : std::numeric_limits<double>::infinity();
 
-    double sinC = std::sin(angleC_rad);
-    double cosC = std::cos(angleC_rad);
-    double tanC = std::tan(angleC_rad);
+    double sinC = sinDegrees(angleC);
+    double cosC = cosDegrees(angleC);
+    double tanC = tanDegrees(angleC);
     double cotC = (tanC != 0) ? 1.0 / tanC : std::numeric_limits<double>::infinity();
 
     // Handle special cases where angle = 90 degrees
@@ -1282,6 +413,80 @@ void MathHelper::clearAllLineEdits(){
     // Clear the error message
     ui->lineEdit_Error->clear();
 }
+void MathHelper::applyHistoryFilter(){
+    // An empty bound leaves that side open; both empty shows every row again
+    QString minText = ui->lineEdit_filterMin->text();
+    QString maxText = ui->lineEdit_filterMax->text();
+    if (minText.isEmpty() && maxText.isEmpty()) {
+        historyModel->clearFilter();
+        return;
+    }
+    bool okMin = true;
+    bool okMax = true;
+    double minValue = minText.isEmpty() ? -std::numeric_limits<double>::infinity() : minText.toDouble(&okMin);
+    double maxValue = maxText.isEmpty() ? std::numeric_limits<double>::infinity() : maxText.toDouble(&okMax);
+    if (!okMin || !okMax) {
+        ui->lineEdit_Error->setText("Please enter a number for the filter bounds.");
+        return;
+    }
+    historyModel->setFilter(ui->comboBox_filterColumn->currentIndex(), minValue, maxValue);
+}
+void MathHelper::clearHistory(){
+    historyModel->clear();
+}
+void MathHelper::importCsvFile(){
+    QString path = QFileDialog::getOpenFileName(this, "Import triangles", QString(), "CSV files (*.csv *.txt);;All files (*)");
+    if (path.isEmpty()) {
+        return;
+    }
+    setImporting(true);
+    importWorker->resetCancel();
+    QMetaObject::invokeMethod(importWorker, [this, path] { importWorker->importFile(path); }, Qt::QueuedConnection);
+}
+void MathHelper::importClipboard(){
+    QString text = QApplication::clipboard()->text();
+    if (text.isEmpty() || !ui->btnImport->isEnabled()) {
+        return;
+    }
+    setImporting(true);
+    importWorker->resetCancel();
+    QMetaObject::invokeMethod(importWorker, [this, text] { importWorker->importText(text); }, Qt::QueuedConnection);
+}
+void MathHelper::cancelImport(){
+    // The worker thread is busy in the pipeline, so this can't be a queued call
+    importWorker->cancel();
+    ui->btnCancelImport->setEnabled(false);
+}
+void MathHelper::importRowsSolved(const QVector<TriangleValues> &rows){
+    historyModel->append(rows.constData(), std::size_t(rows.size()));
+}
+void MathHelper::importProgress(int percent, qulonglong rows, double rowsPerSecond){
+    ui->progressBar_import->setValue(percent);
+    ui->label_importRate->setText(QString("%1 rows, %2 rows/s").arg(rows).arg(qRound64(rowsPerSecond)));
+}
+void MathHelper::importFinished(qulonglong rows, qulonglong invalidRows, qulonglong unsolvedRows, bool cancelled){
+    setImporting(false);
+    QString message = QString("%1 %2 rows").arg(cancelled ? "Cancelled after" : "Imported").arg(rows);
+    if (invalidRows || unsolvedRows) {
+        message += QString(", skipped %1 bad rows").arg(invalidRows + unsolvedRows);
+    }
+    if (unsolvedRows) {
+        message += QString(" (%1 with no solution)").arg(unsolvedRows);
+    }
+    ui->lineEdit_Error->setText(message);
+}
+void MathHelper::importFailed(const QString &message){
+    setImporting(false);
+    ui->lineEdit_Error->setText(message);
+}
+void MathHelper::setImporting(bool importing){
+    ui->btnImport->setEnabled(!importing);
+    ui->btnCancelImport->setEnabled(importing);
+    if (importing) {
+        ui->progressBar_import->setValue(0);
+        ui->label_importRate->clear();
+    }
+}
 void MathHelper::on_more_info_linkActivated(){
 
     convertAngle();
@@ -7,6 +7,12 @@
 #include <QMap>
 #include <QWidget>
 #include <QLineEdit>
+#include <QThread>
+#include <QVector>
+#include "triangleCore.h"
+class SolveHistoryModel;
+class CsvImportWorker;
+
 QT_BEGIN_NAMESPACE
 namespace Ui {
 class MathHelper;
@@ -28,10 +34,27 @@ private slots:
     void on_btnReset_clicked();
     void on_more_info_linkActivated();
     void clearAllLineEdits();    // Slot to clear all QLineEdit widgets
+    void applyHistoryFilter();
+    void clearHistory();
+    void importCsvFile();
+    void importClipboard();
+    void cancelImport();
+    void importRowsSolved(const QVector<TriangleValues> &rows);
+    void importProgress(int percent, qulonglong rows, double rowsPerSecond);
+    void importFinished(qulonglong rows, qulonglong invalidRows, qulonglong unsolvedRows, bool cancelled);
+    void importFailed(const QString &message);
+    void canvasChanged(const TriangleValues &values, quint32 changedFields);
+    void canvasDragFinished(const TriangleValues &values);
 
 private:
     Ui::MathHelper *ui;
+    SolveHistoryModel *historyModel;
+    QThread importThread;
+    CsvImportWorker *importWorker;
+    void setImporting(bool importing);
     std::vector<std::vector<QLineEdit*>> lineEdits;
+    std::vector<QLineEdit*> resultEdits; // indexed by TriangleField
+    void showResults(const TriangleValues &values, uint32_t fields);
     std::pair<int, int> findFocusedLineEdit();
     bool eventFilter(QObject *obj, QEvent *event);
     void moveUp();
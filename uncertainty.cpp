@@ -0,0 +1,304 @@
+#include "uncertainty.h"
+#include "batchKernels.h"
+#include "batchSolver.h"
+#include "philox.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <thread>
+
+namespace {
+
+const std::size_t SampleBlock = 256;
+const std::size_t PercentileBins = 1 << 16;
+const double TwoPi = 6.283185307179586;
+
+const uint32_t SssMask = (1u << Field_AB) | (1u << Field_AC) | (1u << Field_BC);
+
+// Sums are taken around the nominal solution so the variance does not
+// lose its digits to cancellation.
+struct Moments {
+    std::size_t rejected = 0;
+    std::size_t valid[FieldCount] = {};
+    double sum[FieldCount] = {};
+    double sumSquares[FieldCount] = {};
+    double minValue[FieldCount];
+    double maxValue[FieldCount];
+
+    Moments() {
+        std::fill_n(minValue, FieldCount, std::numeric_limits<double>::infinity());
+        std::fill_n(maxValue, FieldCount, -std::numeric_limits<double>::infinity());
+    }
+};
+
+}
+
+MonteCarloResult propagateUncertainty(const TriangleValues& nominal, const InputDistribution (&inputs)[InputFieldCount],
+                                      const MonteCarloOptions& options)
+{
+    auto start = std::chrono::steady_clock::now();
+    const std::size_t samples = options.samples;
+    const uint32_t mask = knownMask(nominal);
+    const bool sss = mask == SssMask;
+
+    int randomFields[InputFieldCount];
+    int randomCount = 0;
+    for (int field = 0; field < InputFieldCount; field++) {
+        if ((mask & (1u << field)) && inputs[field].kind != InputDistribution::Exact) {
+            randomFields[randomCount++] = field;
+        }
+    }
+
+    TriangleValues reference = nominal;
+    solveTriangle(reference);
+    double shift[FieldCount];
+    for (int field = 0; field < FieldCount; field++) {
+        double value = fieldValue(reference, field);
+        shift[field] = std::isfinite(value) ? value : 0;
+    }
+
+    // Every sample is kept (as float) for the percentiles; NaN marks a rejected or failed sample.
+    std::array<std::vector<float>, FieldCount> columns;
+    for (std::vector<float>& column : columns) {
+        column.resize(samples);
+    }
+
+    const Philox4x32 random(options.seed);
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<Moments> partial(threads);
+    std::atomic<std::size_t> nextBlock{0};
+
+    auto sampleWorker = [&](unsigned t) {
+        Moments& moments = partial[t];
+        TriangleValues rows[SampleBlock];
+        TriangleValues solved[SampleBlock];
+        bool rejected[SampleBlock];
+        double block[FieldCount][SampleBlock];
+        SssColumns sssColumns;
+        sssColumns.Area = block[Field_Area];
+        sssColumns.angleA = block[Field_angleA];
+        sssColumns.angleB = block[Field_angleB];
+        sssColumns.angleC = block[Field_angleC];
+        sssColumns.inRadius = block[Field_inRadius];
+        sssColumns.circumRadius = block[Field_circumRadius];
+        sssColumns.HeightAH = block[Field_HeightAH];
+        sssColumns.HeightBH = block[Field_HeightBH];
+        sssColumns.HeightCH = block[Field_HeightCH];
+        sssColumns.median_AM = block[Field_median_AM];
+        sssColumns.median_BM = block[Field_median_BM];
+        sssColumns.median_CM = block[Field_median_CM];
+        sssColumns.BisectorA = block[Field_BisectorA];
+        sssColumns.BisectorB = block[Field_BisectorB];
+        sssColumns.BisectorC = block[Field_BisectorC];
+
+        for (;;) {
+            std::size_t first = nextBlock.fetch_add(SampleBlock, std::memory_order_relaxed);
+            if (first >= samples) {
+                return;
+            }
+            std::size_t count = std::min(SampleBlock, samples - first);
+
+            // One Philox call covers two random inputs: two 32-bit words each.
+            for (std::size_t i = 0; i < count; i++) {
+                uint64_t sample = first + i;
+                TriangleValues& row = rows[i];
+                row = nominal;
+                rejected[i] = false;
+                uint32_t words[4];
+                for (int j = 0; j < randomCount; j++) {
+                    if (j % 2 == 0) {
+                        const uint32_t counter[4] = {uint32_t(sample), uint32_t(sample >> 32), uint32_t(j / 2), 0};
+                        random(counter, words);
+                    }
+                    const InputDistribution& distribution = inputs[randomFields[j]];
+                    double u1 = philoxUniform(words[2 * (j % 2)]);
+                    double u2 = philoxUniform(words[2 * (j % 2) + 1]);
+                    double draw = distribution.kind == InputDistribution::Normal
+                        ? std::sqrt(-2 * std::log(u1)) * std::cos(TwoPi * u2)
+                        : 2 * u1 - 1;
+                    double& value = fieldValue(row, randomFields[j]);
+                    value += distribution.spread * draw;
+                    // A known input drawn <= 0 would silently switch the solver branch.
+                    rejected[i] = rejected[i] || !(value > 0);
+                }
+            }
+
+            if (sss) {
+                for (std::size_t i = 0; i < count; i++) {
+                    block[Field_AB][i] = rows[i].AB;
+                    block[Field_AC][i] = rows[i].AC;
+                    block[Field_BC][i] = rows[i].BC;
+                }
+                solveSssBatch(block[Field_AB], block[Field_AC], block[Field_BC], count, sssColumns);
+            } else {
+                solveBatch(rows, solved, count);
+                for (int field = 0; field < FieldCount; field++) {
+                    for (std::size_t i = 0; i < count; i++) {
+                        block[field][i] = fieldValue(solved[i], field);
+                    }
+                }
+            }
+
+            for (std::size_t i = 0; i < count; i++) {
+                moments.rejected += rejected[i];
+            }
+            for (int field = 0; field < FieldCount; field++) {
+                float* column = columns[field].data() + first;
+                for (std::size_t i = 0; i < count; i++) {
+                    double value = block[field][i];
+                    if (rejected[i] || !std::isfinite(value)) {
+                        column[i] = std::numeric_limits<float>::quiet_NaN();
+                        continue;
+                    }
+                    column[i] = float(value);
+                    double offset = value - shift[field];
+                    moments.valid[field]++;
+                    moments.sum[field] += offset;
+                    moments.sumSquares[field] += offset * offset;
+                    moments.minValue[field] = std::min(moments.minValue[field], value);
+                    moments.maxValue[field] = std::max(moments.maxValue[field], value);
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++) {
+        workers.emplace_back(sampleWorker, t);
+    }
+    sampleWorker(0);
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+    MonteCarloResult result;
+    result.samples = samples;
+    result.percentiles = options.percentiles;
+    Moments total;
+    for (const Moments& part : partial) {
+        total.rejected += part.rejected;
+        for (int field = 0; field < FieldCount; field++) {
+            total.valid[field] += part.valid[field];
+            total.sum[field] += part.sum[field];
+            total.sumSquares[field] += part.sumSquares[field];
+            total.minValue[field] = std::min(total.minValue[field], part.minValue[field]);
+            total.maxValue[field] = std::max(total.maxValue[field], part.maxValue[field]);
+        }
+    }
+    result.rejectedSamples = total.rejected;
+    for (int field = 0; field < FieldCount; field++) {
+        OutputSummary& summary = result.outputs[field];
+        std::size_t n = total.valid[field];
+        summary.valid = n;
+        if (n == 0) {
+            continue;
+        }
+        double meanOffset = total.sum[field] / n;
+        summary.mean = shift[field] + meanOffset;
+        summary.stddev = n > 1 ? std::sqrt(std::max(0.0, (total.sumSquares[field] - meanOffset * total.sum[field]) / (n - 1))) : 0;
+        summary.minValue = total.minValue[field];
+        summary.maxValue = total.maxValue[field];
+    }
+
+    // Percentiles, one output per task: a histogram pass over [min, max]
+    // finds the bin holding each nearest rank, a second pass collects just
+    // those bins, and only their few values are selected from.
+    std::atomic<int> nextField{0};
+    auto percentileWorker = [&] {
+        std::vector<uint32_t> counts(PercentileBins);
+        std::vector<int> bucketOfBin(PercentileBins);
+        for (int field; (field = nextField.fetch_add(1)) < FieldCount;) {
+            OutputSummary& summary = result.outputs[field];
+            summary.percentiles.assign(options.percentiles.size(), std::numeric_limits<double>::quiet_NaN());
+            std::size_t n = summary.valid;
+            std::vector<float>& column = columns[field];
+            if (n == 0) {
+                std::vector<float>().swap(column);
+                continue;
+            }
+            double low = summary.minValue;
+            double width = (summary.maxValue - low) / PercentileBins;
+            // Binned in double and clamped before the conversion: a value
+            // rounded to float can fall just below low.
+            auto binOf = [&](float value) {
+                double bin = width > 0 ? (value - low) / width : 0;
+                return std::size_t(std::min(double(PercentileBins - 1), std::max(0.0, bin)));
+            };
+
+            std::fill(counts.begin(), counts.end(), 0);
+            for (float value : column) {
+                if (!std::isnan(value)) {
+                    counts[binOf(value)]++;
+                }
+            }
+            std::vector<std::size_t> rankBin(options.percentiles.size());
+            std::vector<std::size_t> rankInBin(options.percentiles.size());
+            std::fill(bucketOfBin.begin(), bucketOfBin.end(), -1);
+            std::vector<std::vector<float>> buckets;
+            for (std::size_t k = 0; k < options.percentiles.size(); k++) {
+                double p = std::min(100.0, std::max(0.0, options.percentiles[k]));
+                std::size_t rank = std::size_t(std::lround(p / 100 * (n - 1)));
+                std::size_t bin = 0;
+                while (rank >= counts[bin]) {
+                    rank -= counts[bin++];
+                }
+                rankBin[k] = bin;
+                rankInBin[k] = rank;
+                if (bucketOfBin[bin] < 0) {
+                    bucketOfBin[bin] = int(buckets.size());
+                    buckets.emplace_back();
+                    buckets.back().reserve(counts[bin]);
+                }
+            }
+            for (float value : column) {
+                if (!std::isnan(value)) {
+                    int bucket = bucketOfBin[binOf(value)];
+                    if (bucket >= 0) {
+                        buckets[bucket].push_back(value);
+                    }
+                }
+            }
+            for (std::size_t k = 0; k < options.percentiles.size(); k++) {
+                std::vector<float>& bucket = buckets[bucketOfBin[rankBin[k]]];
+                std::nth_element(bucket.begin(), bucket.begin() + rankInBin[k], bucket.end());
+                summary.percentiles[k] = bucket[rankInBin[k]];
+            }
+            std::vector<float>().swap(column);
+        }
+    };
+    workers.clear();
+    for (unsigned t = 1; t < threads; t++) {
+        workers.emplace_back(percentileWorker);
+    }
+    percentileWorker();
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+void writeUncertaintyReport(std::ostream& out, const MonteCarloResult& result)
+{
+    out << "samples," << result.samples << "\n"
+        << "rejected_samples," << result.rejectedSamples << "\n"
+        << "seconds," << result.seconds << "\n"
+        << "output,valid,mean,stddev,min,max";
+    for (double p : result.percentiles) {
+        out << ",p" << p;
+    }
+    out << "\n";
+    for (int field = 0; field < FieldCount; field++) {
+        const OutputSummary& summary = result.outputs[field];
+        out << kTriangleFieldNames[field] << ',' << summary.valid << ',' << summary.mean << ',' << summary.stddev << ','
+            << summary.minValue << ',' << summary.maxValue;
+        for (double value : summary.percentiles) {
+            out << ',' << value;
+        }
+        out << "\n";
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef UNCERTAINTY_H
+#define UNCERTAINTY_H
+
+#include "triangleCore.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+// Monte Carlo propagation of measurement tolerances. Each known input gets
+// a distribution around its nominal value; samples are drawn with a
+// counter-based RNG (philox.h), solved in blocks across threads and
+// summarized per output. Three-sides rows go through solveSssBatch.
+
+struct InputDistribution {
+    enum Kind { Exact, Normal, Uniform };
+    Kind kind = Exact;
+    double spread = 0; // Normal: standard deviation, Uniform: half-width
+};
+
+struct MonteCarloOptions {
+    std::size_t samples = 1000000;
+    unsigned threads = 0; // 0 = one per hardware thread
+    uint64_t seed = 0x5eed;
+    std::vector<double> percentiles = {2.5, 25, 50, 75, 97.5}; // in percent
+};
+
+struct OutputSummary {
+    std::size_t valid = 0; // samples with a finite value
+    double mean = 0;
+    double stddev = 0;
+    double minValue = 0;
+    double maxValue = 0;
+    std::vector<double> percentiles; // same order as MonteCarloOptions::percentiles
+};
+
+struct MonteCarloResult {
+    std::size_t samples = 0;
+    std::size_t rejectedSamples = 0; // a known input was drawn <= 0
+    std::array<OutputSummary, FieldCount> outputs;
+    std::vector<double> percentiles;
+    double seconds = 0;
+};
+
+MonteCarloResult propagateUncertainty(const TriangleValues& nominal, const InputDistribution (&inputs)[InputFieldCount],
+                                      const MonteCarloOptions& options = MonteCarloOptions());
+
+void writeUncertaintyReport(std::ostream& out, const MonteCarloResult& result);
+
+#endif // UNCERTAINTY_H
@@ -0,0 +1,221 @@
+#include "vertexInput.h"
+#include "batchKernels.h"
+#include "batchSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+namespace {
+
+const std::size_t VertexBlock = 1024;
+
+static_assert(sizeof(PointStreamHeader) == 16, "point stream header must stay 16 bytes");
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+const bool BigEndianHost = true;
+#else
+const bool BigEndianHost = false;
+#endif
+
+// Between host order and the stream's little-endian order, both ways.
+template <typename T>
+T littleEndian(T value)
+{
+    if (BigEndianHost) {
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof value);
+        std::reverse(bytes, bytes + sizeof(T));
+        std::memcpy(&value, bytes, sizeof value);
+    }
+    return value;
+}
+
+}
+
+void edgesFromVertices(const VertexColumns& v, std::size_t count, double* AB, double* AC, double* BC, double* Area)
+{
+    if (v.dimensions == 2) {
+        for (std::size_t i = 0; i < count; i++) {
+            double abx = v.Bx[i] - v.Ax[i], aby = v.By[i] - v.Ay[i];
+            double acx = v.Cx[i] - v.Ax[i], acy = v.Cy[i] - v.Ay[i];
+            double bcx = v.Cx[i] - v.Bx[i], bcy = v.Cy[i] - v.By[i];
+            AB[i] = std::sqrt(abx * abx + aby * aby);
+            AC[i] = std::sqrt(acx * acx + acy * acy);
+            BC[i] = std::sqrt(bcx * bcx + bcy * bcy);
+            Area[i] = 0.5 * std::fabs(abx * acy - aby * acx);
+        }
+        return;
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        double abx = v.Bx[i] - v.Ax[i], aby = v.By[i] - v.Ay[i], abz = v.Bz[i] - v.Az[i];
+        double acx = v.Cx[i] - v.Ax[i], acy = v.Cy[i] - v.Ay[i], acz = v.Cz[i] - v.Az[i];
+        double bcx = v.Cx[i] - v.Bx[i], bcy = v.Cy[i] - v.By[i], bcz = v.Cz[i] - v.Bz[i];
+        AB[i] = std::sqrt(abx * abx + aby * aby + abz * abz);
+        AC[i] = std::sqrt(acx * acx + acy * acy + acz * acz);
+        BC[i] = std::sqrt(bcx * bcx + bcy * bcy + bcz * bcz);
+        double nx = aby * acz - abz * acy;
+        double ny = abz * acx - abx * acz;
+        double nz = abx * acy - aby * acx;
+        Area[i] = 0.5 * std::sqrt(nx * nx + ny * ny + nz * nz);
+    }
+}
+
+void solveFromVertices(const VertexColumns& vertices, std::size_t count, TriangleValues* outputs)
+{
+    double AB[VertexBlock], AC[VertexBlock], BC[VertexBlock], Area[VertexBlock];
+    double columns[15][VertexBlock];
+    SssColumns out;
+    double** targets[15] = {&out.Area, &out.angleA, &out.angleB, &out.angleC, &out.inRadius, &out.circumRadius,
+                            &out.HeightAH, &out.HeightBH, &out.HeightCH, &out.median_AM, &out.median_BM,
+                            &out.median_CM, &out.BisectorA, &out.BisectorB, &out.BisectorC};
+    for (int i = 0; i < 15; i++) {
+        *targets[i] = columns[i];
+    }
+
+    for (std::size_t first = 0; first < count; first += VertexBlock) {
+        std::size_t n = std::min(VertexBlock, count - first);
+        VertexColumns block = vertices;
+        for (const double** column : {&block.Ax, &block.Ay, &block.Az, &block.Bx, &block.By, &block.Bz,
+                                      &block.Cx, &block.Cy, &block.Cz}) {
+            if (*column) {
+                *column += first;
+            }
+        }
+        edgesFromVertices(block, n, AB, AC, BC, Area);
+        solveSssAreaBatch(AB, AC, BC, Area, n, out);
+        for (std::size_t i = 0; i < n; i++) {
+            TriangleValues& row = outputs[first + i];
+            row.AB = AB[i];
+            row.AC = AC[i];
+            row.BC = BC[i];
+            row.Area = out.Area[i];
+            row.angleA = out.angleA[i];
+            row.angleB = out.angleB[i];
+            row.angleC = out.angleC[i];
+            row.inRadius = out.inRadius[i];
+            row.circumRadius = out.circumRadius[i];
+            row.HeightAH = out.HeightAH[i];
+            row.HeightBH = out.HeightBH[i];
+            row.HeightCH = out.HeightCH[i];
+            row.median_AM = out.median_AM[i];
+            row.median_BM = out.median_BM[i];
+            row.median_CM = out.median_CM[i];
+            row.BisectorA = out.BisectorA[i];
+            row.BisectorB = out.BisectorB[i];
+            row.BisectorC = out.BisectorC[i];
+        }
+    }
+}
+
+void solveFromVertices(const double* A, const double* B, const double* C, int dimensions, TriangleValues& output)
+{
+    VertexColumns v;
+    v.dimensions = dimensions;
+    v.Ax = A;
+    v.Ay = A + 1;
+    v.Bx = B;
+    v.By = B + 1;
+    v.Cx = C;
+    v.Cy = C + 1;
+    if (dimensions == 3) {
+        v.Az = A + 2;
+        v.Bz = B + 2;
+        v.Cz = C + 2;
+    }
+    solveFromVertices(v, 1, &output);
+}
+
+bool writePointStreamHeader(std::ostream& out, const PointStreamHeader& header)
+{
+    PointStreamHeader stored = header;
+    stored.version = littleEndian(header.version);
+    stored.count = littleEndian(header.count);
+    out.write(reinterpret_cast<const char*>(&stored), sizeof stored);
+    return bool(out);
+}
+
+bool readPointStreamHeader(std::istream& in, PointStreamHeader& header)
+{
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof header)) {
+        return false;
+    }
+    header.version = littleEndian(header.version);
+    header.count = littleEndian(header.count);
+    return std::memcmp(header.magic, "TSPT", 4) == 0 && header.version == 1
+        && (header.dimensions == 2 || header.dimensions == 3);
+}
+
+void writePointStreamTriangle(std::ostream& out, int dimensions, const double* A, const double* B, const double* C)
+{
+    double record[9];
+    for (int axis = 0; axis < dimensions; axis++) {
+        record[axis] = littleEndian(A[axis]);
+        record[dimensions + axis] = littleEndian(B[axis]);
+        record[2 * dimensions + axis] = littleEndian(C[axis]);
+    }
+    out.write(reinterpret_cast<const char*>(record), 3 * dimensions * sizeof(double));
+}
+
+long long solvePointStream(std::istream& in, std::ostream& out, std::string& error)
+{
+    PointStreamHeader header;
+    if (!readPointStreamHeader(in, header)) {
+        error = "not a TSPT point stream";
+        return -1;
+    }
+    const int dims = header.dimensions;
+    const std::size_t recordValues = 3 * dims;
+    std::vector<double> records(VertexBlock * recordValues);
+    std::vector<double> columns(9 * VertexBlock);
+    std::vector<TriangleValues> results(VertexBlock);
+    std::vector<char> text(VertexBlock * MaxFormattedRowLength);
+
+    VertexColumns v;
+    v.dimensions = dims;
+    const double** targets[9] = {&v.Ax, &v.Ay, &v.Az, &v.Bx, &v.By, &v.Bz, &v.Cx, &v.Cy, &v.Cz};
+    for (int i = 0; i < 9; i++) {
+        *targets[i] = columns.data() + i * VertexBlock;
+    }
+
+    long long total = 0;
+    uint64_t remaining = header.count ? header.count : UINT64_MAX;
+    while (remaining > 0) {
+        std::size_t want = std::size_t(std::min<uint64_t>(VertexBlock, remaining));
+        in.read(reinterpret_cast<char*>(records.data()), want * recordValues * sizeof(double));
+        std::size_t bytes = std::size_t(in.gcount());
+        std::size_t n = bytes / (recordValues * sizeof(double));
+        bool partial = bytes % (recordValues * sizeof(double)) != 0;
+        // Interleaved records -> coordinate columns.
+        for (std::size_t i = 0; i < n; i++) {
+            const double* record = records.data() + i * recordValues;
+            for (int point = 0; point < 3; point++) {
+                for (int axis = 0; axis < dims; axis++) {
+                    columns[(point * 3 + axis) * VertexBlock + i] = littleEndian(record[point * dims + axis]);
+                }
+            }
+        }
+        solveFromVertices(v, n, results.data());
+        std::size_t length = 0;
+        for (std::size_t i = 0; i < n; i++) {
+            length += formatTriangleRow(results[i], text.data() + length, MaxFormattedRowLength);
+        }
+        out.write(text.data(), length);
+        total += n;
+        remaining -= header.count ? n : 0;
+        if (partial) {
+            error = "point stream ends inside triangle " + std::to_string(total + 1);
+            return -1;
+        }
+        if (header.count && n < want) {
+            error = "point stream ends after " + std::to_string(total) + " of "
+                + std::to_string(header.count) + " triangles";
+            return -1;
+        }
+        if (n < want) {
+            break;
+        }
+    }
+    return total;
+}
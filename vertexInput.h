@@ -0,0 +1,61 @@
+#ifndef VERTEXINPUT_H
+#define VERTEXINPUT_H
+
+#include "triangleCore.h"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+// Triangles given as three 2D or 3D vertex coordinates instead of lengths.
+// Edge lengths come from the coordinate differences and the area from the
+// cross product, which unlike Heron's formula does not cancel catastrophically
+// for needle-thin triangles. The rest is the SSS derivation with that area.
+
+// Structure-of-arrays coordinates; the z columns are ignored when dimensions == 2.
+struct VertexColumns {
+    int dimensions = 3;
+    const double* Ax = nullptr;
+    const double* Ay = nullptr;
+    const double* Az = nullptr;
+    const double* Bx = nullptr;
+    const double* By = nullptr;
+    const double* Bz = nullptr;
+    const double* Cx = nullptr;
+    const double* Cy = nullptr;
+    const double* Cz = nullptr;
+};
+
+// Edge lengths and cross-product area for count triangles.
+void edgesFromVertices(const VertexColumns& vertices, std::size_t count, double* AB, double* AC, double* BC, double* Area);
+
+// All 18 values for count triangles; outputs[i] is overwritten.
+void solveFromVertices(const VertexColumns& vertices, std::size_t count, TriangleValues* outputs);
+
+// One triangle from interleaved points (dimensions values per point).
+void solveFromVertices(const double* A, const double* B, const double* C, int dimensions, TriangleValues& output);
+
+// Streaming binary point format ("TSPT"):
+//   header: char magic[4] = "TSPT", uint16 version = 1, uint8 dimensions (2 or 3),
+//           uint8 reserved = 0, uint64 triangle count (0 = unknown, read to end)
+//   then per triangle: A, B, C as dimensions float64 each.
+// Every field is little-endian; big-endian hosts swap on read and write.
+struct PointStreamHeader {
+    char magic[4] = {'T', 'S', 'P', 'T'};
+    uint16_t version = 1;
+    uint8_t dimensions = 3;
+    uint8_t reserved = 0;
+    uint64_t count = 0;
+};
+
+bool writePointStreamHeader(std::ostream& out, const PointStreamHeader& header);
+bool readPointStreamHeader(std::istream& in, PointStreamHeader& header);
+void writePointStreamTriangle(std::ostream& out, int dimensions, const double* A, const double* B, const double* C);
+
+// Reads a whole point stream, solves it in blocks and writes one CSV line of
+// 18 values per triangle. Returns the number of triangles, or -1 with error
+// set for a bad header or a stream that ends inside a triangle or short of
+// the header's count; the triangles before that point are still written.
+long long solvePointStream(std::istream& in, std::ostream& out, std::string& error);
+
+#endif // VERTEXINPUT_H